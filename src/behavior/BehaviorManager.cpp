@@ -1,11 +1,13 @@
 #include "BehaviorManager.h"
 #include "define/FlagManager.h"
+#include "define/DefaultFlags.h"
 #include "define/DefineManager.h"
 #include "text/TextManager.h"
 #include "layout/LayoutManager.h"
 #include "layout/LayoutBackend.h"
 #include "layout/model/WindowData.h"
 #include "layout/model/ControlData.h"
+#include "FlagDatabase.h"
 
 #include <QJsonArray>
 #include <QDebug>
@@ -221,16 +223,27 @@ void BehaviorManager::refreshFlagsFromFiles(const QString& wndFlagsPath,
         return;
     }
 
+    m_windowRulesLoaded  = false;
+    m_controlRulesLoaded = false;
+    m_windowRules = FlagRuleSet{};
+    m_controlRules = FlagRuleSet{};
+
+    // ⚡ Schnellpfad: flags.db, solange keine JSON-Quelle geändert wurde
+    if (loadFlagDatabase())
+        return;
+
     const QJsonObject winObj  = m_layoutBackend->loadWindowFlags();
     const QJsonObject ctrlObj = m_layoutBackend->loadControlFlags();
 
     m_windowFlags.clear();
     m_controlFlags.clear();
 
-    m_windowRulesLoaded  = false;
-    m_controlRulesLoaded = false;
-    m_windowRules = QJsonObject{};
-    m_controlRules = QJsonObject{};
+    // 🧰 Keine Flag-Dateien (z. B. ohne Source-Ordner) → eingebaute Tabellen
+    if (winObj.isEmpty() && ctrlObj.isEmpty()) {
+        loadBuiltinFlags();
+        compileFlagRules();
+        return;
+    }
 
     // 🪟 Window-Flags (High-Word)
     for (auto it = winObj.constBegin(); it != winObj.constEnd(); ++it)
@@ -270,6 +283,95 @@ void BehaviorManager::refreshFlagsFromFiles(const QString& wndFlagsPath,
     qInfo() << "[BehaviorManager] Flags geladen:"
             << "windows =" << m_windowFlags.size()
             << "controls =" << m_controlFlags.size();
+
+    compileFlagRules();
+}
+
+// ---------------------------------------------------------
+// Regeln einmalig zu Bitmasken kompilieren
+// ---------------------------------------------------------
+void BehaviorManager::compileFlagRules()
+{
+    const QJsonObject groups = m_layoutBackend ? m_layoutBackend->loadFlagGroups()
+                                               : QJsonObject{};
+
+    m_ruleEngine.compile(groups,
+                         windowFlagRules(),
+                         controlFlagRules(),
+                         m_windowFlags,
+                         m_controlFlags);
+
+    // Binäres Abbild für den nächsten Start aktualisieren – nur wenn
+    // sich eine JSON-Quelle gegenüber dem gespeicherten Kopf geändert hat
+    if (!m_layoutBackend)
+        return;
+
+    const QString dbPath = m_layoutBackend->flagDatabasePath();
+    const QVector<quint64> hashes = FlagDatabase::hashSources(m_layoutBackend->flagSourcePaths());
+    if (FlagDatabase::isCurrent(dbPath, hashes)) {
+        qInfo() << "[BehaviorManager] flags.db ist aktuell – kein Schreiben nötig.";
+        return;
+    }
+
+    FlagDatabase::write(dbPath, hashes, m_windowFlags, m_controlFlags, m_ruleEngine);
+}
+
+// ---------------------------------------------------------
+// Eingebaute Standard-Flags (DefaultFlags.h) – ohne Datei-I/O
+// ---------------------------------------------------------
+void BehaviorManager::loadBuiltinFlags()
+{
+    auto name = [](const DefaultFlag& f) {
+        return QString::fromLatin1(f.name.data(), qsizetype(f.name.size()));
+    };
+
+    DefaultFlags::forEach(FlagClass::Window, [&](const DefaultFlag& f) {
+        m_windowFlags.insert(name(f), f.value);
+    });
+
+    // 🕰️ Von den Legacy-Window-Flags nur die Overrides (WBS_NOCLOSE) – wie
+    // FlagManager::applyDefaultWindowFlags. Die übrigen (WBS_TEXT, WBS_CHECK …)
+    // teilen Werte mit aktuellen WBS_*-Flags und bleiben außen vor
+    int legacy = 0;
+    DefaultFlags::forEach(FlagClass::LegacyWindow, [&](const DefaultFlag& f) {
+        if (DefaultFlags::isLegacyOverride(f.name) && !m_windowFlags.contains(name(f))) {
+            m_windowFlags.insert(name(f), f.value);
+            ++legacy;
+        }
+    });
+
+    DefaultFlags::forEach(FlagClass::Control, [&](const DefaultFlag& f) {
+        m_controlFlags.insert(name(f), f.value);
+    });
+
+    qInfo() << "[BehaviorManager] Keine Flag-Dateien → eingebaute Standard-Flags:"
+            << "windows =" << m_windowFlags.size()
+            << "(legacy =" << legacy << ")"
+            << "controls =" << m_controlFlags.size();
+}
+
+// ---------------------------------------------------------
+// Flags + kompilierte Regeln aus flags.db übernehmen
+// ---------------------------------------------------------
+bool BehaviorManager::loadFlagDatabase()
+{
+    const QVector<quint64> hashes = FlagDatabase::hashSources(m_layoutBackend->flagSourcePaths());
+
+    // Nur für die Dauer des Ladens eingeblendet – Hot-Reload schreibt die Datei neu
+    FlagDatabase db;
+    if (!db.open(m_layoutBackend->flagDatabasePath(), hashes)) {
+        qInfo() << "[BehaviorManager] flags.db fehlt oder ist veraltet → JSON wird geparst.";
+        return false;
+    }
+
+    m_windowFlags  = db.flags(FlagDatabase::Kind::Window);
+    m_controlFlags = db.flags(FlagDatabase::Kind::Control);
+    db.restoreRules(m_ruleEngine);
+
+    qInfo() << "[BehaviorManager] Flags aus flags.db geladen:"
+            << "windows =" << m_windowFlags.size()
+            << "controls =" << m_controlFlags.size();
+    return true;
 }
 
 // ---------------------------------------------------------
@@ -279,12 +381,12 @@ void BehaviorManager::reloadWindowFlagRules() const
 {
     if (!m_layoutBackend) {
         qWarning() << "[BehaviorManager] Kein LayoutBackend – window_flag_rules.json kann nicht geladen werden.";
-        m_windowRules = QJsonObject{};
+        m_windowRules = FlagRuleSet{};
         m_windowRulesLoaded = true;
         return;
     }
 
-    m_windowRules = m_layoutBackend->loadWindowFlagRules();
+    m_windowRules = FlagRuleSet::parse(m_layoutBackend->loadWindowFlagRules(), m_windowFlags);
     m_windowRulesLoaded = true;
 }
 
@@ -292,40 +394,136 @@ void BehaviorManager::reloadControlFlagRules() const
 {
     if (!m_layoutBackend) {
         qWarning() << "[BehaviorManager] Kein LayoutBackend – control_flag_rules.json kann nicht geladen werden.";
-        m_controlRules = QJsonObject{};
+        m_controlRules = FlagRuleSet{};
         m_controlRulesLoaded = true;
         return;
     }
 
-    m_controlRules = m_layoutBackend->loadControlFlagRules();
+    m_controlRules = FlagRuleSet::parse(m_layoutBackend->loadControlFlagRules(), m_controlFlags);
     m_controlRulesLoaded = true;
 }
 
-QJsonObject BehaviorManager::windowFlagRules() const
+const FlagRuleSet& BehaviorManager::windowFlagRules() const
 {
     if (!m_windowRulesLoaded)
-        const_cast<BehaviorManager*>(this)->reloadWindowFlagRules();
+        reloadWindowFlagRules();
     return m_windowRules;
 }
 
-QJsonObject BehaviorManager::controlFlagRules() const
+const FlagRuleSet& BehaviorManager::controlFlagRules() const
 {
     if (!m_controlRulesLoaded)
-        const_cast<BehaviorManager*>(this)->reloadControlFlagRules();
+        reloadControlFlagRules();
     return m_controlRules;
 }
 
+const BehaviorConfigModel& BehaviorManager::behaviorConfig() const
+{
+    if (!m_behaviorConfigLoaded)
+        reloadBehaviorConfig();
+    return m_behaviorConfig;
+}
+
 // ---------------------------------------------------------
 // Behavior-Konfiguration aus Datei (später erweiterbar)
 // ---------------------------------------------------------
 void BehaviorManager::reloadBehaviorConfig() const
 {
-    // Aktuell noch kein Backend-Call – Platzhalter.
-    // Später: m_behaviorConfig = m_layoutBackend->loadBehaviorConfig();
-    m_behaviorConfig = QJsonObject{};
+    if (!m_layoutBackend) {
+        m_behaviorConfig = BehaviorConfigModel{};
+        m_behaviorConfigLoaded = true;
+        return;
+    }
+
+    // Optional: behavior_config.json (normalisierter Typ → Attribut-Overrides)
+    m_behaviorConfig = BehaviorConfigModel::parse(m_layoutBackend->loadBehaviorConfig());
     m_behaviorConfigLoaded = true;
 }
 
+// ---------------------------------------------------------
+// Hot-Reload: einzelne Datei neu laden + Diff bestimmen
+// ---------------------------------------------------------
+QStringList BehaviorManager::reloadRuleFile(RuleFile which)
+{
+    QStringList changed;
+
+    switch (which)
+    {
+    // Nach einem Start aus flags.db sind die Regeln evtl. noch nie geparst
+    // worden – dann gilt jeder Key als geändert (Vergleich gegen leere Menge)
+    case RuleFile::WindowRules: {
+        const FlagRuleSet before = m_windowRulesLoaded ? m_windowRules : FlagRuleSet{};
+        reloadWindowFlagRules();
+        changed = before.diffKeys(m_windowRules);
+        break;
+    }
+    case RuleFile::ControlRules: {
+        const FlagRuleSet before = m_controlRulesLoaded ? m_controlRules : FlagRuleSet{};
+        reloadControlFlagRules();
+        changed = before.diffKeys(m_controlRules);
+        break;
+    }
+    case RuleFile::BehaviorConfig: {
+        const BehaviorConfigModel before = behaviorConfig();
+        reloadBehaviorConfig();
+        changed = before.diffKeys(m_behaviorConfig);
+        break;
+    }
+    case RuleFile::FlagGroups:
+        // Gruppen haben keine Top-Level-Keys pro Fenster/Control →
+        // nur neu kompilieren, Aufrufer validiert/zeichnet neu
+        break;
+    }
+
+    if (which != RuleFile::BehaviorConfig)
+        compileFlagRules();
+
+    qInfo().noquote() << "[BehaviorManager] Hot-Reload → geänderte Keys:"
+                      << (changed.isEmpty() ? QStringLiteral("<keine>") : changed.join(", "));
+    return changed;
+}
+
+bool BehaviorManager::isAffected(const WindowData& wnd, const QSet<QString>& keys) const
+{
+    if (keys.isEmpty())
+        return false;
+
+    if (keys.contains(wnd.name) || keys.contains("Default"))
+        return true;
+
+    // Regeln sind pro Flag abgelegt → nur Fenster mit gesetztem Bit
+    for (const QString& key : keys) {
+        const quint32 bit = m_windowFlags.value(key, 0);
+        if (bit != 0 && (wnd.flagsMask & bit) == bit)
+            return true;
+    }
+    return false;
+}
+
+bool BehaviorManager::isAffected(const ControlData& ctrl, const QSet<QString>& keys) const
+{
+    if (keys.isEmpty())
+        return false;
+
+    if (keys.contains(ctrl.id) || keys.contains(ctrl.type) || keys.contains("Default"))
+        return true;
+
+    // behavior_config.json ist nach normalisiertem Typ geschlüsselt
+    if (keys.contains(normalizeType(ctrl.type)))
+        return true;
+
+    for (const QString& key : keys) {
+        const quint32 ctrlBit = m_controlFlags.value(key, 0);
+        if (ctrlBit != 0 && (ctrl.lowFlags & ctrlBit) == ctrlBit)
+            return true;
+
+        const quint32 wndBit = m_windowFlags.value(key, 0);
+        if (wndBit != 0 && (ctrl.flagsMask & wndBit) == wndBit)
+            return true;
+    }
+    return false;
+}
+
 // ---------------------------------------------------------
 // Masken → resolvedMask aktualisieren
 // ---------------------------------------------------------
@@ -341,13 +539,15 @@ void BehaviorManager::updateWindowFlags(const std::shared_ptr<WindowData>& wnd)
     }
 }
 
-void BehaviorManager::updateControlFlags(const std::shared_ptr<ControlData>& ctrl) const
+void BehaviorManager::updateControlFlags(const std::shared_ptr<ControlData>& ctrl, const QString& windowName) const
 {
     if (!ctrl)
         return;
 
     ctrl->resolvedMask.clear();
 
+    m_usageIndex.updateControl(ctrl, windowName);
+
     // Low-Word = ControlFlags
     const quint32 style = ctrl->flagsMask & 0xFFFF;
 
@@ -558,18 +758,32 @@ void BehaviorManager::validateControlFlags(ControlData* ctrl) const
 }
 
 
-void BehaviorManager::analyzeControlTypes(const std::vector<std::shared_ptr<WindowData>>& windows) const
+void BehaviorManager::analyzeControlTypes(const std::vector<std::shared_ptr<WindowData>>& windows)
 {
-    Q_UNUSED(windows);
-    // Hier könntest du z.B. Statistiken sammeln,
-    // welche Controls es mit welchen Typen/Flags gibt.
+    m_usageIndex.rebuild(windows);
+
+    const QMap<QString, int> counts = m_usageIndex.typeCounts();
+    for (auto it = counts.constBegin(); it != counts.constEnd(); ++it)
+        qInfo().noquote() << QString("[BehaviorManager]   %1: %2").arg(it.key(), -20).arg(it.value());
 }
 
 void BehaviorManager::generateUnknownControls(const std::vector<std::shared_ptr<WindowData>>& windows) const
 {
     Q_UNUSED(windows);
-    // Optional: "Unknown" Controls in Listen sammeln,
-    // um sie im Editor speziell darzustellen.
+
+    // Controls mit Bits, die weder Control- noch Window-Flags zugeordnet sind
+    const auto unknown = queryFlagUsage("UNKNOWN");
+    if (unknown.isEmpty())
+        return;
+
+    qWarning().noquote() << "[BehaviorManager] Controls mit unbekannten Flag-Bits:" << unknown.size()
+                         << "(im Editor per Abfrage 'UNKNOWN' auflistbar)";
+}
+
+QVector<FlagUsageIndex::Hit> BehaviorManager::queryFlagUsage(const QString& query,
+                                                             QString* error) const
+{
+    return m_usageIndex.query(query, m_windowFlags, m_controlFlags, error);
 }
 
 // ---------------------------------------------------------
@@ -632,13 +846,9 @@ BehaviorInfo BehaviorManager::resolveBehavior(const ControlData& ctrl) const
     // 2) BehaviorConfig.json (falls später vorhanden)
     // =========================================================
     //
-    if (!m_behaviorConfigLoaded)
-        const_cast<BehaviorManager*>(this)->reloadBehaviorConfig();
-
-    if (m_behaviorConfig.contains(normalized)) {
-        const QJsonObject obj = m_behaviorConfig.value(normalized).toObject();
-        for (auto it = obj.begin(); it != obj.end(); ++it)
-            info.attributes[it.key()] = it.value().toVariant();
+    if (const auto* overrides = behaviorConfig().overridesFor(normalized)) {
+        for (const auto& [key, value] : *overrides)
+            info.attributes[key] = value;
     }
 
     //
@@ -5,9 +5,14 @@
 #include <QJsonObject>
 #include <QString>
 #include <QFlags>
+#include <QSet>
+#include <QStringList>
 #include <memory>
 #include <vector>
 
+#include "FlagRuleEngine.h"
+#include "FlagUsageIndex.h"
+
 struct BehaviorInfo {
     QString category;
     QMap<QString, QVariant> attributes;
@@ -60,22 +65,44 @@ public:
     const QMap<QString, quint32>& windowFlags()  const { return m_windowFlags; }
     const QMap<QString, quint32>& controlFlags() const { return m_controlFlags; }
 
-    QJsonObject windowFlagRules() const;
-    QJsonObject controlFlagRules() const;
+    // Geparste Regeldateien (JSON nur beim Laden/Speichern)
+    const FlagRuleSet& windowFlagRules() const;
+    const FlagRuleSet& controlFlagRules() const;
+    const BehaviorConfigModel& behaviorConfig() const;
+
+    // Vorkompilierte Regeln (flag_groups.json + *_flag_rules.json)
+    const FlagRuleEngine& flagRules() const { return m_ruleEngine; }
+    void compileFlagRules();
+
+    // --- Hot-Reload der Regel-/Config-Dateien ---
+    enum class RuleFile { WindowRules, ControlRules, BehaviorConfig, FlagGroups };
+
+    // Lädt genau eine Datei neu und liefert die geänderten Top-Level-Keys
+    // (Flagnamen, Typnamen oder Fensternamen – je nach Datei)
+    QStringList reloadRuleFile(RuleFile which);
+
+    // Betrifft ein geänderter Key dieses Fenster / Control?
+    bool isAffected(const WindowData& wnd, const QSet<QString>& keys) const;
+    bool isAffected(const ControlData& ctrl, const QSet<QString>& keys) const;
 
     // --- Flags interpretieren ---
     void updateWindowFlags(const std::shared_ptr<WindowData>& wnd) const;
-    void updateControlFlags(const std::shared_ptr<ControlData>& ctrl) const;
+    void updateControlFlags(const std::shared_ptr<ControlData>& ctrl, const QString& windowName) const;
     void applyWindowStyle(WindowData& wnd) const;
 
     // --- Validierung ---
     void validateWindowFlags(WindowData* wnd) const;
     void validateControlFlags(ControlData* ctrl) const;
 
-    // --- Analyse (optional) ---
-    void analyzeControlTypes(const std::vector<std::shared_ptr<WindowData>>& windows) const;
+    // --- Analyse: invertierter Flag-Index ---
+    void analyzeControlTypes(const std::vector<std::shared_ptr<WindowData>>& windows);
     void generateUnknownControls(const std::vector<std::shared_ptr<WindowData>>& windows) const;
 
+    // Boolesche Flag-Abfrage, z. B. "BS_CHECKBOX & WBS_NODRAWFRAME"
+    QVector<FlagUsageIndex::Hit> queryFlagUsage(const QString& query,
+                                                QString* error = nullptr) const;
+    const FlagUsageIndex& flagUsage() const { return m_usageIndex; }
+
     // ===========================================
     // Behavior API – finale öffentliche Funktionen
     // ===========================================
@@ -105,16 +132,21 @@ private:
     QMap<QString, quint32> m_controlFlags;
 
     // --- Rules ---
-    mutable QJsonObject m_windowRules;
-    mutable QJsonObject m_controlRules;
+    mutable FlagRuleSet m_windowRules;
+    mutable FlagRuleSet m_controlRules;
     mutable bool m_windowRulesLoaded  = false;
     mutable bool m_controlRulesLoaded = false;
 
+    FlagRuleEngine m_ruleEngine;
+
+    // Index wird bei jeder Flag-Änderung (auch aus const-Pfaden) nachgeführt
+    mutable FlagUsageIndex m_usageIndex;
+
     // --- BaseBehaviors ---
     QMap<QString, BaseBehavior> m_baseBehaviors;
 
     // --- Optionale BehaviorConfig (noch leer) ---
-    mutable QJsonObject m_behaviorConfig;
+    mutable BehaviorConfigModel m_behaviorConfig;
     mutable bool m_behaviorConfigLoaded = false;
 
     // --- Initialisierung ---
@@ -122,4 +154,6 @@ private:
     void reloadWindowFlagRules() const;
     void reloadControlFlagRules() const;
     void reloadBehaviorConfig() const;
+    bool loadFlagDatabase();
+    void loadBuiltinFlags();
 };
@@ -0,0 +1,436 @@
+#include "FlagDatabase.h"
+#include "FlagRuleEngine.h"
+
+#include <QFile>
+#include <QSaveFile>
+#include <QDebug>
+
+#include <algorithm>
+#include <cstring>
+#include <type_traits>
+
+namespace {
+constexpr quint32 DbMagic    = 0x42444C46;   // "FLDB"
+constexpr quint32 DbVersion  = 2;           // 2: FLAG-Exklusivregeln als Paare
+constexpr int     MaxSources = 8;
+
+enum RuleScope : quint32
+{
+    ScopeWindowBase  = 0,
+    ScopeControlBase = 1,
+    ScopeWindow      = 2,   // Fenstername
+    ScopeControl     = 3    // WTYPE_*
+};
+
+struct DbHeader
+{
+    quint32 magic;
+    quint32 version;
+    quint32 fileSize;
+    quint32 sourceCount;
+    quint64 sourceHash[MaxSources];
+
+    quint32 stringsOffset, stringsSize;
+    quint32 flagsOffset, windowFlagCount, controlFlagCount;
+    quint32 rulesOffset, ruleCount;
+    quint32 groupsOffset, groupCount;
+    quint32 valuesOffset, valueCount;
+    quint32 implOffset, implCount;
+    quint32 reserved;                 // auf 8 Byte auffüllen
+};
+
+struct DbFlag
+{
+    quint32 nameOffset;
+    quint32 nameLength;
+    quint32 value;
+};
+
+struct DbRule
+{
+    quint32 scope;
+    quint32 nameOffset;
+    quint32 nameLength;
+    quint32 allowedMask;
+    quint32 defaultMask;
+    quint32 firstGroup;
+    quint32 groupCount;
+    quint32 firstImplication;
+    quint32 implicationCount;
+};
+
+struct DbGroup
+{
+    quint32 firstValue;
+    quint32 valueCount;
+};
+
+struct DbImplication
+{
+    quint32 trigger;
+    quint32 implied;
+};
+
+static_assert(std::is_trivially_copyable_v<DbHeader>);
+static_assert(sizeof(DbHeader) % 8 == 0);
+
+template <typename T>
+void appendRecords(QByteArray& out, const QVector<T>& records)
+{
+    out.append(reinterpret_cast<const char*>(records.constData()),
+               qsizetype(records.size()) * qsizetype(sizeof(T)));
+}
+
+void pad4(QByteArray& out)
+{
+    while (out.size() % 4)
+        out.append('\0');
+}
+
+template <typename T>
+const T* recordsAt(const uchar* data, quint32 offset)
+{
+    return reinterpret_cast<const T*>(data + offset);
+}
+
+bool fits(quint64 offset, quint64 count, quint64 elemSize, quint64 total)
+{
+    return offset % 4 == 0 && offset <= total && count * elemSize <= total - offset;
+}
+}
+
+FlagDatabase::~FlagDatabase()
+{
+    close();
+}
+
+// =============================================================
+// Quell-Hashes
+// =============================================================
+QVector<quint64> FlagDatabase::hashSources(const QStringList& paths)
+{
+    QVector<quint64> hashes;
+    hashes.reserve(paths.size());
+
+    for (const QString& path : paths) {
+        QFile f(path);
+        if (!f.open(QIODevice::ReadOnly)) {
+            hashes.append(0);
+            continue;
+        }
+        const QByteArray bytes = f.readAll();
+        hashes.append(quint64(qHashBits(bytes.constData(), size_t(bytes.size()))));
+    }
+    return hashes;
+}
+
+// =============================================================
+// Öffnen / Prüfen
+// =============================================================
+bool FlagDatabase::open(const QString& path, const QVector<quint64>& expectedHashes)
+{
+    close();
+
+    m_file = std::make_unique<QFile>(path);
+    if (!m_file->open(QIODevice::ReadOnly)) {
+        m_file.reset();
+        return false;
+    }
+
+    m_size = m_file->size();
+    m_data = m_size > 0 ? m_file->map(0, m_size) : nullptr;
+
+    if (!m_data || !validate(expectedHashes)) {
+        close();
+        return false;
+    }
+    return true;
+}
+
+void FlagDatabase::close()
+{
+    if (m_file) {
+        if (m_data)
+            m_file->unmap(const_cast<uchar*>(m_data));
+        m_file->close();
+        m_file.reset();
+    }
+    m_data = nullptr;
+    m_size = 0;
+}
+
+bool FlagDatabase::validate(const QVector<quint64>& expectedHashes) const
+{
+    if (m_size < qint64(sizeof(DbHeader)))
+        return false;
+
+    const DbHeader& h = *recordsAt<DbHeader>(m_data, 0);
+    if (h.magic != DbMagic || h.version != DbVersion || h.fileSize != quint64(m_size))
+        return false;
+
+    // Veraltet? (JSON-Quelle geändert)
+    if (h.sourceCount > MaxSources || int(h.sourceCount) != expectedHashes.size())
+        return false;
+    for (int i = 0; i < expectedHashes.size(); ++i)
+        if (h.sourceHash[i] != expectedHashes[i])
+            return false;
+
+    // Abschnittsgrenzen
+    const quint64 total = quint64(m_size);
+    if (!fits(h.stringsOffset, h.stringsSize, 1, total)
+        || !fits(h.flagsOffset, quint64(h.windowFlagCount) + h.controlFlagCount, sizeof(DbFlag), total)
+        || !fits(h.rulesOffset, h.ruleCount, sizeof(DbRule), total)
+        || !fits(h.groupsOffset, h.groupCount, sizeof(DbGroup), total)
+        || !fits(h.valuesOffset, h.valueCount, sizeof(quint32), total)
+        || !fits(h.implOffset, h.implCount, sizeof(DbImplication), total))
+        return false;
+
+    // Verweise innerhalb der Abschnitte
+    const DbFlag* flags = recordsAt<DbFlag>(m_data, h.flagsOffset);
+    for (quint32 i = 0; i < h.windowFlagCount + h.controlFlagCount; ++i)
+        if (quint64(flags[i].nameOffset) + flags[i].nameLength > h.stringsSize)
+            return false;
+
+    const DbRule* rules = recordsAt<DbRule>(m_data, h.rulesOffset);
+    for (quint32 i = 0; i < h.ruleCount; ++i) {
+        const DbRule& r = rules[i];
+        if (r.scope > ScopeControl
+            || quint64(r.nameOffset) + r.nameLength > h.stringsSize
+            || quint64(r.firstGroup) + r.groupCount > h.groupCount
+            || quint64(r.firstImplication) + r.implicationCount > h.implCount)
+            return false;
+    }
+
+    const DbGroup* groups = recordsAt<DbGroup>(m_data, h.groupsOffset);
+    for (quint32 i = 0; i < h.groupCount; ++i)
+        if (quint64(groups[i].firstValue) + groups[i].valueCount > h.valueCount)
+            return false;
+
+    return true;
+}
+
+bool FlagDatabase::isCurrent(const QString& path, const QVector<quint64>& sourceHashes)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly))
+        return false;
+
+    // Nur der Kopf – Abschnitte prüft open() beim nächsten Start
+    DbHeader h{};
+    if (file.read(reinterpret_cast<char*>(&h), sizeof(DbHeader)) != qint64(sizeof(DbHeader)))
+        return false;
+
+    if (h.magic != DbMagic || h.version != DbVersion || h.fileSize != quint64(file.size())
+        || int(h.sourceCount) != sourceHashes.size() || h.sourceCount > MaxSources)
+        return false;
+
+    return std::equal(sourceHashes.cbegin(), sourceHashes.cend(), h.sourceHash);
+}
+
+// =============================================================
+// Lesen
+// =============================================================
+int FlagDatabase::flagCount(Kind kind) const
+{
+    if (!isOpen())
+        return 0;
+    const DbHeader& h = *recordsAt<DbHeader>(m_data, 0);
+    return int(kind == Kind::Window ? h.windowFlagCount : h.controlFlagCount);
+}
+
+QMap<QString, quint32> FlagDatabase::flags(Kind kind) const
+{
+    QMap<QString, quint32> result;
+    if (!isOpen())
+        return result;
+
+    const DbHeader& h = *recordsAt<DbHeader>(m_data, 0);
+    const char* strings = reinterpret_cast<const char*>(m_data + h.stringsOffset);
+    const DbFlag* flags = recordsAt<DbFlag>(m_data, h.flagsOffset);
+
+    // Window-Flags zuerst, danach Control-Flags
+    const quint32 first = kind == Kind::Window ? 0 : h.windowFlagCount;
+    const quint32 count = kind == Kind::Window ? h.windowFlagCount : h.controlFlagCount;
+
+    for (quint32 i = first; i < first + count; ++i)
+        result.insert(QString::fromUtf8(strings + flags[i].nameOffset, flags[i].nameLength),
+                      flags[i].value);
+    return result;
+}
+
+void FlagDatabase::restoreRules(FlagRuleEngine& engine) const
+{
+    if (!isOpen())
+        return;
+
+    const DbHeader& h = *recordsAt<DbHeader>(m_data, 0);
+    const char* strings          = reinterpret_cast<const char*>(m_data + h.stringsOffset);
+    const DbRule* rules          = recordsAt<DbRule>(m_data, h.rulesOffset);
+    const DbGroup* groups        = recordsAt<DbGroup>(m_data, h.groupsOffset);
+    const quint32* values        = recordsAt<quint32>(m_data, h.valuesOffset);
+    const DbImplication* implies = recordsAt<DbImplication>(m_data, h.implOffset);
+
+    CompiledFlagRules windowBase, controlBase;
+    QHash<QString, CompiledFlagRules> windowScopes, controlScopes;
+
+    for (quint32 i = 0; i < h.ruleCount; ++i)
+    {
+        const DbRule& r = rules[i];
+
+        CompiledFlagRules compiled;
+        compiled.allowedMask = r.allowedMask;
+        compiled.defaultMask = r.defaultMask;
+
+        compiled.exclusive.reserve(int(r.groupCount));
+        for (quint32 g = r.firstGroup; g < r.firstGroup + r.groupCount; ++g) {
+            const DbGroup& grp = groups[g];
+            compiled.exclusive.append(QVector<quint32>(values + grp.firstValue,
+                                                       values + grp.firstValue + grp.valueCount));
+        }
+
+        compiled.implies.reserve(int(r.implicationCount));
+        for (quint32 k = r.firstImplication; k < r.firstImplication + r.implicationCount; ++k)
+            compiled.implies.append({ implies[k].trigger, implies[k].implied });
+
+        const QString name = QString::fromUtf8(strings + r.nameOffset, r.nameLength);
+        switch (r.scope) {
+        case ScopeWindowBase:  windowBase  = std::move(compiled); break;
+        case ScopeControlBase: controlBase = std::move(compiled); break;
+        case ScopeWindow:      windowScopes.insert(name, std::move(compiled)); break;
+        case ScopeControl:     controlScopes.insert(name, std::move(compiled)); break;
+        }
+    }
+
+    engine.restore(std::move(windowBase), std::move(controlBase),
+                   std::move(windowScopes), std::move(controlScopes));
+}
+
+// =============================================================
+// Schreiben
+// =============================================================
+bool FlagDatabase::write(const QString& path,
+                         const QVector<quint64>& sourceHashes,
+                         const QMap<QString, quint32>& windowFlags,
+                         const QMap<QString, quint32>& controlFlags,
+                         const FlagRuleEngine& engine)
+{
+    if (path.isEmpty() || sourceHashes.size() > MaxSources)
+        return false;
+
+    QByteArray strings;
+    QVector<DbFlag> flags;
+    QVector<DbRule> rules;
+    QVector<DbGroup> groups;
+    QVector<quint32> values;
+    QVector<DbImplication> implies;
+
+    auto addString = [&strings](const QString& s, quint32& offset, quint32& length) {
+        const QByteArray utf8 = s.toUtf8();
+        offset = quint32(strings.size());
+        length = quint32(utf8.size());
+        strings += utf8;
+    };
+
+    // --- Flags (QMap → bereits nach Namen sortiert) ---
+    auto addFlags = [&](const QMap<QString, quint32>& map) {
+        for (auto it = map.constBegin(); it != map.constEnd(); ++it) {
+            DbFlag f{};
+            addString(it.key(), f.nameOffset, f.nameLength);
+            f.value = it.value();
+            flags.append(f);
+        }
+    };
+    addFlags(windowFlags);
+    addFlags(controlFlags);
+
+    // --- Regeln ---
+    auto addRule = [&](quint32 scope, const QString& name, const CompiledFlagRules& src) {
+        DbRule r{};
+        r.scope = scope;
+        addString(name, r.nameOffset, r.nameLength);
+        r.allowedMask = src.allowedMask;
+        r.defaultMask = src.defaultMask;
+
+        r.firstGroup = quint32(groups.size());
+        r.groupCount = quint32(src.exclusive.size());
+        for (const QVector<quint32>& group : src.exclusive) {
+            groups.append({ quint32(values.size()), quint32(group.size()) });
+            values += group;
+        }
+
+        r.firstImplication = quint32(implies.size());
+        r.implicationCount = quint32(src.implies.size());
+        for (const CompiledFlagRules::Implication& imp : src.implies)
+            implies.append({ imp.trigger, imp.implied });
+
+        rules.append(r);
+    };
+
+    auto addScopes = [&](quint32 scope, const QHash<QString, CompiledFlagRules>& scopes) {
+        QStringList keys = scopes.keys();
+        keys.sort();                                  // deterministische Datei
+        for (const QString& key : keys)
+            addRule(scope, key, scopes.value(key));
+    };
+
+    addRule(ScopeWindowBase,  QString(), engine.windowBase());
+    addRule(ScopeControlBase, QString(), engine.controlBase());
+    addScopes(ScopeWindow,  engine.windowScopes());
+    addScopes(ScopeControl, engine.controlScopes());
+
+    // --- Zusammensetzen ---
+    DbHeader h{};
+    h.magic       = DbMagic;
+    h.version     = DbVersion;
+    h.sourceCount = quint32(sourceHashes.size());
+    std::copy(sourceHashes.cbegin(), sourceHashes.cend(), h.sourceHash);
+
+    QByteArray out(sizeof(DbHeader), '\0');
+
+    h.stringsOffset = quint32(out.size());
+    h.stringsSize   = quint32(strings.size());
+    out += strings;
+    pad4(out);
+
+    h.flagsOffset      = quint32(out.size());
+    h.windowFlagCount  = quint32(windowFlags.size());
+    h.controlFlagCount = quint32(controlFlags.size());
+    appendRecords(out, flags);
+
+    h.rulesOffset = quint32(out.size());
+    h.ruleCount   = quint32(rules.size());
+    appendRecords(out, rules);
+
+    h.groupsOffset = quint32(out.size());
+    h.groupCount   = quint32(groups.size());
+    appendRecords(out, groups);
+
+    h.valuesOffset = quint32(out.size());
+    h.valueCount   = quint32(values.size());
+    appendRecords(out, values);
+
+    h.implOffset = quint32(out.size());
+    h.implCount  = quint32(implies.size());
+    appendRecords(out, implies);
+
+    h.fileSize = quint32(out.size());
+    std::memcpy(out.data(), &h, sizeof(DbHeader));
+
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qWarning().noquote() << "[FlagDatabase] Kann nicht schreiben:" << path;
+        return false;
+    }
+    file.write(out);
+    if (!file.commit()) {
+        qWarning().noquote() << "[FlagDatabase] Speichern fehlgeschlagen:" << path;
+        return false;
+    }
+
+    qInfo().noquote() << QString("[FlagDatabase] Geschrieben: %1 Flags, %2 Regelsätze, %3 Bytes → %4")
+                             .arg(flags.size())
+                             .arg(rules.size())
+                             .arg(out.size())
+                             .arg(path);
+    return true;
+}
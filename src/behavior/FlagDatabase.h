@@ -0,0 +1,68 @@
+#pragma once
+
+#include <QMap>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <memory>
+
+class QFile;
+class FlagRuleEngine;
+
+// ------------------------------------------------------------
+// FlagDatabase – kompilierte, versionierte Flag-Datenbank
+// ------------------------------------------------------------
+// Binäres Abbild von window_flags.json, control_flags.json und
+// den daraus kompilierten Regelmasken (flag_groups.json +
+// *_flag_rules.json). Die JSON-Dateien bleiben die editierbare
+// Quelle; im Header stehen ihre Inhalts-Hashes. Passt einer
+// nicht mehr, gilt die Datenbank als veraltet und wird nach dem
+// nächsten Kompilieren neu geschrieben.
+//
+// Layout (Host-Byteorder, alle Abschnitte 4-Byte-ausgerichtet):
+//   Header | Strings | Flags | Regeln | Gruppen | Werte | Implikationen
+// Datensätze haben feste Größe und werden direkt aus der per
+// QFile::map() eingeblendeten Datei gelesen – kein Parsen.
+// ------------------------------------------------------------
+class FlagDatabase
+{
+public:
+    enum class Kind { Window, Control };
+
+    FlagDatabase() = default;
+    ~FlagDatabase();
+
+    FlagDatabase(const FlagDatabase&) = delete;
+    FlagDatabase& operator=(const FlagDatabase&) = delete;
+
+    // Inhalts-Hashes der Quelldateien (fehlende Datei → 0)
+    static QVector<quint64> hashSources(const QStringList& paths);
+
+    // Einblenden + prüfen; false bei fehlender/defekter/veralteter Datei
+    bool open(const QString& path, const QVector<quint64>& expectedHashes);
+    void close();
+    bool isOpen() const { return m_data != nullptr; }
+
+    int flagCount(Kind kind) const;
+    QMap<QString, quint32> flags(Kind kind) const;
+
+    // Kompilierte Masken in die Engine übernehmen
+    void restoreRules(FlagRuleEngine& engine) const;
+
+    // Kopf der Datei passt bereits zu den Quellen (Version, Hashes, Größe)
+    // → erneutes Schreiben unnötig
+    static bool isCurrent(const QString& path, const QVector<quint64>& sourceHashes);
+
+    static bool write(const QString& path,
+                      const QVector<quint64>& sourceHashes,
+                      const QMap<QString, quint32>& windowFlags,
+                      const QMap<QString, quint32>& controlFlags,
+                      const FlagRuleEngine& engine);
+
+private:
+    bool validate(const QVector<quint64>& expectedHashes) const;
+
+    std::unique_ptr<QFile> m_file;
+    const uchar* m_data = nullptr;
+    qint64       m_size = 0;
+};
@@ -0,0 +1,427 @@
+#include "FlagRuleEngine.h"
+#include "layout/model/WindowData.h"
+#include "layout/model/ControlData.h"
+
+#include <QJsonArray>
+#include <QtAlgorithms>
+#include <QDebug>
+
+const QString FlagRuleEngine::WindowTypeKey = QStringLiteral("WTYPE_WINDOW");
+
+namespace {
+// Alle Window-Flags mit Wert im High-Word (für Controls relevant)
+constexpr quint32 HighWordMask = 0xFFFF0000;
+constexpr quint32 LowWordMask  = 0x0000FFFF;
+
+quint32 domainBits(const QMap<QString, quint32>& flags)
+{
+    quint32 mask = 0;
+    for (auto it = flags.constBegin(); it != flags.constEnd(); ++it)
+        mask |= it.value();
+    return mask;
+}
+
+// Gesetzte Mitglieder einer Exklusiv-Gruppe, ohne Teilmengen anderer
+// gesetzter Mitglieder (BS_CHECKBOX ⊂ BS_AUTOCHECKBOX zählt nicht doppelt)
+// und ohne Doppelte. Nur für Gruppen mit Mehr-Bit-Werten – ohne Allokation.
+template <typename Fn>
+void forEachActive(const QVector<quint32>& group, quint32 mask, Fn&& fn)
+{
+    auto isSet = [mask](quint32 v) { return v != 0 && (mask & v) == v; };
+
+    for (int i = 0; i < group.size(); ++i) {
+        const quint32 a = group[i];
+        if (!isSet(a))
+            continue;
+
+        bool skip = false;
+        for (int j = 0; j < group.size() && !skip; ++j) {
+            const quint32 b = group[j];
+            if (!isSet(b))
+                continue;
+            skip = (b == a) ? j < i : (a & b) == a;
+        }
+        if (!skip)
+            fn(a);
+    }
+}
+}
+
+// ---------------------------------------------------------
+// Gruppenmasken
+// ---------------------------------------------------------
+CompiledFlagRules::GroupMask CompiledFlagRules::maskOf(const QVector<quint32>& group)
+{
+    GroupMask m;
+    for (quint32 v : group) {
+        m.bits |= v;
+        if (v != 0 && qPopulationCount(v) != 1)
+            m.singleBits = false;
+    }
+    return m;
+}
+
+void CompiledFlagRules::rebuildGroupMasks()
+{
+    groupMasks.clear();
+    groupMasks.reserve(exclusive.size());
+    for (const auto& group : exclusive)
+        groupMasks.append(maskOf(group));
+}
+
+// ---------------------------------------------------------
+// Reset
+// ---------------------------------------------------------
+void FlagRuleEngine::clear()
+{
+    m_compiled = false;
+    m_windowBase  = CompiledFlagRules{};
+    m_controlBase = CompiledFlagRules{};
+    m_windowRules.clear();
+    m_controlRules.clear();
+}
+
+// ---------------------------------------------------------
+// Bereits kompilierte Masken übernehmen (z. B. aus flags.db)
+// ---------------------------------------------------------
+void FlagRuleEngine::restore(CompiledFlagRules windowBase,
+                             CompiledFlagRules controlBase,
+                             QHash<QString, CompiledFlagRules> windowScopes,
+                             QHash<QString, CompiledFlagRules> controlScopes)
+{
+    m_windowBase   = std::move(windowBase);
+    m_controlBase  = std::move(controlBase);
+    m_windowRules  = std::move(windowScopes);
+    m_controlRules = std::move(controlScopes);
+
+    // Masken stehen nicht in der Datenbank → aus den Gruppen ableiten
+    m_windowBase.rebuildGroupMasks();
+    m_controlBase.rebuildGroupMasks();
+    for (CompiledFlagRules& rules : m_windowRules)
+        rules.rebuildGroupMasks();
+    for (CompiledFlagRules& rules : m_controlRules)
+        rules.rebuildGroupMasks();
+    m_compiled = true;
+}
+
+void FlagRuleEngine::addExclusiveGroup(CompiledFlagRules& target, const QVector<quint32>& group)
+{
+    // Gruppen mit weniger als zwei sinnvollen Werten können nie kollidieren
+    int nonZero = 0;
+    for (quint32 v : group)
+        if (v != 0) ++nonZero;
+
+    if (nonZero >= 2) {
+        target.exclusive.append(group);
+        target.groupMasks.append(CompiledFlagRules::maskOf(group));
+    }
+}
+
+// ---------------------------------------------------------
+// Geparste Regel (valid / exclusive / implies) einarbeiten
+// ---------------------------------------------------------
+void FlagRuleEngine::compileRule(CompiledFlagRules& target,
+                                 const ParsedRule& rule,
+                                 const QMap<QString, quint32>& flags) const
+{
+    if (rule.hasValid)
+        target.allowedMask &= rule.validBits | ~domainBits(flags);
+
+    for (const auto& group : rule.exclusive)
+        addExclusiveGroup(target, group);
+
+    for (const auto& imp : rule.implies)
+        target.implies.append({ imp.first, imp.second });
+}
+
+// ---------------------------------------------------------
+// Kompilieren
+// ---------------------------------------------------------
+void FlagRuleEngine::compile(const QJsonObject& flagGroups,
+                             const FlagRuleSet& windowRules,
+                             const FlagRuleSet& controlRules,
+                             const QMap<QString, quint32>& windowFlags,
+                             const QMap<QString, quint32>& controlFlags)
+{
+    clear();
+
+    const QJsonObject wndGroups  = flagGroups.value("window").toObject();
+    const QJsonObject ctrlGroups = flagGroups.value("control").toObject();
+
+    //
+    // 1) Window-Flags pro Typ freigeben (flag_groups.json → window.flags)
+    //
+    quint32 restricted = 0;
+    quint32 permittedAll = 0;
+    QHash<QString, quint32> permittedFor;
+
+    const QJsonObject wndFlagTypes = wndGroups.value("flags").toObject();
+    for (auto it = wndFlagTypes.constBegin(); it != wndFlagTypes.constEnd(); ++it) {
+        const quint32 bit = windowFlags.value(it.key(), 0);
+        if (bit == 0)
+            continue;
+
+        restricted |= bit;
+        for (const QJsonValue& t : it.value().toArray()) {
+            const QString type = t.toString();
+            if (type == "WTYPE_ALL")
+                permittedAll |= bit;
+            else
+                permittedFor[type] |= bit;
+        }
+    }
+
+    auto highAllowedFor = [&](const QString& type) -> quint32 {
+        return (~restricted | permittedAll | permittedFor.value(type, 0)) & HighWordMask;
+    };
+
+    m_windowBase.allowedMask = ~restricted | permittedAll | permittedFor.value(WindowTypeKey, 0);
+    m_controlBase.allowedMask = highAllowedFor(QString()) | LowWordMask;
+
+    //
+    // 2) Exklusive Window-Gruppen
+    //
+    const QJsonObject wndExclusive = wndGroups.value("exclusive").toObject();
+    for (auto it = wndExclusive.constBegin(); it != wndExclusive.constEnd(); ++it) {
+        QVector<quint32> group;
+        bool highOnly = true;
+        for (const QJsonValue& v : it.value().toArray()) {
+            const quint32 bit = windowFlags.value(v.toString(), 0);
+            group.append(bit);
+            if (bit & LowWordMask)
+                highOnly = false;
+        }
+
+        addExclusiveGroup(m_windowBase, group);
+
+        // Low-Word gehört bei Controls den Control-Styles
+        if (highOnly)
+            addExclusiveGroup(m_controlBase, group);
+    }
+
+    //
+    // 3) Flag-spezifische Implikationen aus den Regeldateien ("implies": [...])
+    //
+    auto collectFlagImplications = [](CompiledFlagRules& target, const FlagRuleSet& rules) {
+        for (const ParsedRule& rule : rules.entries()) {
+            if (rule.kind == RuleKeyKind::Flag && rule.bits != 0 && rule.impliedByFlag != 0)
+                target.implies.append({ rule.bits, rule.impliedByFlag });
+        }
+    };
+
+    collectFlagImplications(m_windowBase,  windowRules);
+    collectFlagImplications(m_controlBase, controlRules);
+
+    //
+    // 4) "Default"-Regeln in die Basis einarbeiten
+    //
+    if (const ParsedRule* def = windowRules.find("Default"))
+        compileRule(m_windowBase, *def, windowFlags);
+    if (const ParsedRule* def = controlRules.find("Default"))
+        compileRule(m_controlBase, *def, controlFlags);
+
+    //
+    // 5) Control-Typen aus flag_groups.json (control.<WTYPE>)
+    //
+    for (auto it = ctrlGroups.constBegin(); it != ctrlGroups.constEnd(); ++it) {
+        const QJsonObject entry = it.value().toObject();
+
+        CompiledFlagRules rules = m_controlBase;
+
+        const quint32 lowAllowed = orFlags(entry.value("controlStyle").toArray(), controlFlags);
+        if (lowAllowed != 0)
+            rules.allowedMask = (rules.allowedMask & highAllowedFor(it.key())) | lowAllowed;
+        else
+            rules.allowedMask = (rules.allowedMask & LowWordMask) | highAllowedFor(it.key());
+
+        rules.defaultMask = orFlags(entry.value("windowStyle").toArray(), windowFlags);
+
+        m_controlRules.insert(it.key(), rules);
+    }
+
+    //
+    // 6) Typ-/Fenster-spezifische Regeln (valid / exclusive / implies)
+    //
+    auto isScopedRule = [](const ParsedRule& rule) {
+        return rule.kind != RuleKeyKind::Flag && rule.kind != RuleKeyKind::Default
+               && rule.hasConstraints();
+    };
+
+    for (const ParsedRule& rule : windowRules.entries()) {
+        if (!isScopedRule(rule))
+            continue;
+
+        CompiledFlagRules rules = m_windowBase;
+        compileRule(rules, rule, windowFlags);
+        m_windowRules.insert(rule.key, rules);
+    }
+
+    for (const ParsedRule& rule : controlRules.entries()) {
+        if (!isScopedRule(rule))
+            continue;
+
+        CompiledFlagRules rules = m_controlRules.value(rule.key, m_controlBase);
+        compileRule(rules, rule, controlFlags);
+        m_controlRules.insert(rule.key, rules);
+    }
+
+    m_compiled = true;
+
+    qInfo().noquote()
+        << QString("[FlagRuleEngine] Kompiliert → Fenster-Regeln: %1, Control-Typen: %2, "
+                   "Exklusiv-Gruppen (Window): %3")
+               .arg(m_windowRules.size())
+               .arg(m_controlRules.size())
+               .arg(m_windowBase.exclusive.size());
+}
+
+// ---------------------------------------------------------
+// Nachschlagen
+// ---------------------------------------------------------
+const CompiledFlagRules& FlagRuleEngine::rulesForWindow(const QString& windowName) const
+{
+    auto it = m_windowRules.constFind(windowName);
+    return it != m_windowRules.constEnd() ? it.value() : m_windowBase;
+}
+
+const CompiledFlagRules& FlagRuleEngine::rulesForControl(const QString& controlType) const
+{
+    auto it = m_controlRules.constFind(controlType);
+    return it != m_controlRules.constEnd() ? it.value() : m_controlBase;
+}
+
+// ---------------------------------------------------------
+// Prüfen / Korrigieren
+// ---------------------------------------------------------
+FlagCheckResult FlagRuleEngine::check(const CompiledFlagRules& rules, quint32 mask)
+{
+    FlagCheckResult r;
+
+    r.disallowed = mask & ~rules.allowedMask;
+
+    for (int g = 0; g < rules.exclusive.size(); ++g) {
+        const CompiledFlagRules::GroupMask& gm = rules.groupMasks[g];
+        const quint32 hit = mask & gm.bits;
+        if (qPopulationCount(hit) < 2)
+            continue;                       // höchstens ein Bit → kein Konflikt
+
+        if (gm.singleBits) {
+            r.conflicting |= hit;
+            continue;
+        }
+
+        int count = 0;
+        quint32 bits = 0;
+        forEachActive(rules.exclusive[g], mask, [&](quint32 v) { ++count; bits |= v; });
+        if (count > 1)
+            r.conflicting |= bits;
+    }
+
+    for (const auto& imp : rules.implies) {
+        if ((mask & imp.trigger) == imp.trigger)
+            r.missingImplied |= imp.implied & ~mask;
+    }
+
+    return r;
+}
+
+quint32 FlagRuleEngine::correct(const CompiledFlagRules& rules, quint32 mask, quint32 preferred)
+{
+    // 1) Exklusiv-Gruppen: bevorzugtes (zuletzt gesetztes) Mitglied gewinnt
+    for (int g = 0; g < rules.exclusive.size(); ++g) {
+        if (qPopulationCount(mask & rules.groupMasks[g].bits) < 2)
+            continue;
+
+        const QVector<quint32>& group = rules.exclusive[g];
+        const quint32 before = mask;
+
+        int count = 0;
+        quint32 keep = 0;
+        bool preferredFound = false;
+        forEachActive(group, before, [&](quint32 v) {
+            if (count++ == 0)
+                keep = v;
+            if (!preferredFound && preferred != 0 && (v & preferred) == preferred) {
+                keep = v;
+                preferredFound = true;
+            }
+        });
+        if (count <= 1)
+            continue;
+
+        forEachActive(group, before, [&](quint32 v) {
+            if (v != keep)
+                mask &= ~(v & ~keep);
+        });
+    }
+
+    // 2) Implikationen ergänzen (Ketten sind kurz → wenige Durchläufe)
+    for (int pass = 0; pass < 4; ++pass) {
+        quint32 before = mask;
+        for (const auto& imp : rules.implies) {
+            if ((mask & imp.trigger) == imp.trigger)
+                mask |= imp.implied;
+        }
+        if (mask == before)
+            break;
+    }
+
+    // 3) Unerlaubte Bits entfernen
+    return mask & rules.allowedMask;
+}
+
+FlagCheckResult FlagRuleEngine::checkWindow(const WindowData& wnd) const
+{
+    return check(rulesForWindow(wnd.name), wnd.flagsMask);
+}
+
+FlagCheckResult FlagRuleEngine::checkControl(const ControlData& ctrl) const
+{
+    return check(rulesForControl(ctrl.type), ctrl.flagsMask);
+}
+
+// ---------------------------------------------------------
+// Batch-Validierung
+// ---------------------------------------------------------
+int FlagRuleEngine::validateAll(const std::vector<std::shared_ptr<WindowData>>& windows,
+                                bool logIssues) const
+{
+    if (!m_compiled)
+        return 0;
+
+    int issues = 0;
+
+    auto report = [&](const QString& what, const FlagCheckResult& r) {
+        ++issues;
+        if (!logIssues)
+            return;
+        qWarning().noquote()
+            << QString("[FlagRuleEngine] %1: unerlaubt=0x%2 Konflikt=0x%3 fehlend=0x%4")
+                   .arg(what)
+                   .arg(r.disallowed, 0, 16)
+                   .arg(r.conflicting, 0, 16)
+                   .arg(r.missingImplied, 0, 16);
+    };
+
+    for (const auto& wnd : windows)
+    {
+        if (!wnd)
+            continue;
+
+        const FlagCheckResult wr = checkWindow(*wnd);
+        if (!wr.ok())
+            report(wnd->name, wr);
+
+        for (const auto& ctrl : wnd->controls)
+        {
+            if (!ctrl)
+                continue;
+
+            const FlagCheckResult cr = checkControl(*ctrl);
+            if (!cr.ok())
+                report(wnd->name + "::" + ctrl->id, cr);
+        }
+    }
+
+    return issues;
+}
@@ -0,0 +1,123 @@
+#pragma once
+
+#include <QHash>
+#include <QMap>
+#include <QString>
+#include <QVector>
+#include <QJsonObject>
+#include <memory>
+#include <vector>
+
+#include "RuleModel.h"
+
+struct WindowData;
+struct ControlData;
+
+// ------------------------------------------------------------
+// CompiledFlagRules – vorkompilierte Regeln für einen Typ
+// ------------------------------------------------------------
+//  - allowedMask  : erlaubte Bits (0xFFFFFFFF = keine Einschränkung)
+//  - exclusive    : Exklusiv-Gruppen, jede Gruppe = Liste von Flagwerten
+//                   (Werte können mehrere Bits haben, z. B. BS_AUTOCHECKBOX)
+//  - groupMasks   : je Gruppe das ODER ihrer Werte; bei reinen Ein-Bit-
+//                   Gruppen ist ein Konflikt popcount(mask & bits) > 1
+//  - implies      : Trigger-Wert → Bits, die zusätzlich gesetzt sein müssen
+//  - defaultMask  : Standard-Stile (z. B. WBS_CHILD für Controls)
+// ------------------------------------------------------------
+struct CompiledFlagRules
+{
+    struct Implication {
+        quint32 trigger = 0;
+        quint32 implied = 0;
+    };
+
+    struct GroupMask {
+        quint32 bits = 0;
+        bool singleBits = true;      // alle Werte genau ein Bit
+    };
+
+    quint32 allowedMask = 0xFFFFFFFF;
+    quint32 defaultMask = 0;
+    QVector<QVector<quint32>> exclusive;
+    QVector<GroupMask> groupMasks;   // parallel zu exclusive
+    QVector<Implication> implies;
+
+    static GroupMask maskOf(const QVector<quint32>& group);
+    void rebuildGroupMasks();
+};
+
+// ------------------------------------------------------------
+// Ergebnis einer Prüfung
+// ------------------------------------------------------------
+struct FlagCheckResult
+{
+    quint32 disallowed     = 0;   // gesetzte Bits, die für den Typ nicht erlaubt sind
+    quint32 conflicting    = 0;   // Bits aus verletzten Exklusiv-Gruppen
+    quint32 missingImplied = 0;   // fehlende, implizit geforderte Bits
+
+    bool ok() const { return (disallowed | conflicting | missingImplied) == 0; }
+};
+
+// ------------------------------------------------------------
+// FlagRuleEngine
+// ------------------------------------------------------------
+// Kompiliert flag_groups.json + window/control_flag_rules.json
+// einmalig zu Bitmasken. Prüfen und Korrigieren sind danach
+// reine Bitoperationen – nutzbar im PropertyPanel und für
+// Batch-Validierung über das gesamte Projekt.
+// ------------------------------------------------------------
+class FlagRuleEngine
+{
+public:
+    // Typ-Schlüssel für echte Fenster (wie in flag_groups.json)
+    static const QString WindowTypeKey;   // "WTYPE_WINDOW"
+
+    void clear();
+    void compile(const QJsonObject& flagGroups,
+                 const FlagRuleSet& windowRules,
+                 const FlagRuleSet& controlRules,
+                 const QMap<QString, quint32>& windowFlags,
+                 const QMap<QString, quint32>& controlFlags);
+
+    bool isCompiled() const { return m_compiled; }
+
+    // Nachschlagen: spezifischer Key → Basisregeln (inkl. "Default")
+    const CompiledFlagRules& rulesForWindow(const QString& windowName) const;
+    const CompiledFlagRules& rulesForControl(const QString& controlType) const;
+
+    // Reine Bitoperationen
+    static FlagCheckResult check(const CompiledFlagRules& rules, quint32 mask);
+    static quint32 correct(const CompiledFlagRules& rules, quint32 mask, quint32 preferred = 0);
+
+    FlagCheckResult checkWindow(const WindowData& wnd) const;
+    FlagCheckResult checkControl(const ControlData& ctrl) const;
+
+    // Batch: alle Fenster/Controls prüfen, liefert Anzahl der Verstöße
+    int validateAll(const std::vector<std::shared_ptr<WindowData>>& windows,
+                    bool logIssues = false) const;
+
+    // Export / Import der kompilierten Masken (binäre Flag-Datenbank)
+    const CompiledFlagRules& windowBase()  const { return m_windowBase; }
+    const CompiledFlagRules& controlBase() const { return m_controlBase; }
+    const QHash<QString, CompiledFlagRules>& windowScopes()  const { return m_windowRules; }
+    const QHash<QString, CompiledFlagRules>& controlScopes() const { return m_controlRules; }
+
+    void restore(CompiledFlagRules windowBase,
+                 CompiledFlagRules controlBase,
+                 QHash<QString, CompiledFlagRules> windowScopes,
+                 QHash<QString, CompiledFlagRules> controlScopes);
+
+private:
+    void compileRule(CompiledFlagRules& target,
+                     const ParsedRule& rule,
+                     const QMap<QString, quint32>& flags) const;
+    static void addExclusiveGroup(CompiledFlagRules& target, const QVector<quint32>& group);
+
+    bool m_compiled = false;
+
+    CompiledFlagRules m_windowBase;
+    CompiledFlagRules m_controlBase;
+
+    QHash<QString, CompiledFlagRules> m_windowRules;   // Fenstername
+    QHash<QString, CompiledFlagRules> m_controlRules;  // WTYPE_*
+};
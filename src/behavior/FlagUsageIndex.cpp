@@ -0,0 +1,514 @@
+#include "FlagUsageIndex.h"
+#include "layout/model/WindowData.h"
+#include "layout/model/ControlData.h"
+
+#include <QtConcurrent/QtConcurrent>
+#include <QElapsedTimer>
+#include <QThread>
+#include <QDebug>
+#include <functional>
+
+// =============================================================
+// HandleBitmap
+// =============================================================
+void HandleBitmap::set(quint32 handle)
+{
+    const int w = int(handle / 64);
+    if (w >= m_words.size())
+        m_words.resize(w + 1, 0);
+    m_words[w] |= quint64(1) << (handle % 64);
+}
+
+void HandleBitmap::reset(quint32 handle)
+{
+    const int w = int(handle / 64);
+    if (w >= m_words.size())
+        return;
+    m_words[w] &= ~(quint64(1) << (handle % 64));
+    trim();
+}
+
+bool HandleBitmap::test(quint32 handle) const
+{
+    const int w = int(handle / 64);
+    return w < m_words.size() && (m_words[w] >> (handle % 64)) & 1;
+}
+
+int HandleBitmap::count() const
+{
+    int n = 0;
+    for (quint64 word : m_words)
+        n += std::popcount(word);
+    return n;
+}
+
+HandleBitmap& HandleBitmap::operator&=(const HandleBitmap& other)
+{
+    if (m_words.size() > other.m_words.size())
+        m_words.resize(other.m_words.size());
+    for (int i = 0; i < m_words.size(); ++i)
+        m_words[i] &= other.m_words[i];
+    trim();
+    return *this;
+}
+
+HandleBitmap& HandleBitmap::operator|=(const HandleBitmap& other)
+{
+    if (m_words.size() < other.m_words.size())
+        m_words.resize(other.m_words.size(), 0);
+    for (int i = 0; i < other.m_words.size(); ++i)
+        m_words[i] |= other.m_words[i];
+    return *this;
+}
+
+HandleBitmap& HandleBitmap::andNot(const HandleBitmap& other)
+{
+    const int n = qMin(m_words.size(), other.m_words.size());
+    for (int i = 0; i < n; ++i)
+        m_words[i] &= ~other.m_words[i];
+    trim();
+    return *this;
+}
+
+HandleBitmap HandleBitmap::full(quint32 size)
+{
+    HandleBitmap b;
+    if (size == 0)
+        return b;
+
+    b.m_words.resize(int((size + 63) / 64), ~quint64(0));
+    const quint32 rest = size % 64;
+    if (rest != 0)
+        b.m_words.last() = (quint64(1) << rest) - 1;
+    return b;
+}
+
+void HandleBitmap::trim()
+{
+    while (!m_words.isEmpty() && m_words.last() == 0)
+        m_words.removeLast();
+}
+
+// =============================================================
+// Abfrage-Parser (rekursiver Abstieg)
+// =============================================================
+namespace {
+
+class QueryParser
+{
+public:
+    using Resolver = std::function<bool(const QString&, HandleBitmap&, QString&)>;
+
+    QueryParser(const QString& text, HandleBitmap all, Resolver resolve)
+        : m_all(std::move(all)), m_resolve(std::move(resolve))
+    {
+        int pos = 0;
+        while (pos < text.size()) {
+            const QChar c = text.at(pos);
+
+            if (c.isSpace()) {
+                ++pos;
+                continue;
+            }
+
+            if (c == '&' || c == '|' || c == '!' || c == '-' || c == '(' || c == ')') {
+                m_tokens << QString(c);
+                ++pos;
+                continue;
+            }
+
+            if (c.isLetter() || c == '_') {
+                const int begin = pos;
+                while (pos < text.size() && (text.at(pos).isLetterOrNumber() || text.at(pos) == '_'))
+                    ++pos;
+                m_tokens << text.mid(begin, pos - begin).toUpper();
+                continue;
+            }
+
+            m_error = QString("Unerwartetes Zeichen '%1' an Position %2").arg(c).arg(pos + 1);
+            return;
+        }
+    }
+
+    bool parse(HandleBitmap& out)
+    {
+        if (!m_error.isEmpty())
+            return false;
+        if (m_tokens.isEmpty()) {
+            m_error = "Leere Abfrage";
+            return false;
+        }
+
+        out = parseOr();
+        if (m_error.isEmpty() && m_pos < m_tokens.size())
+            m_error = QString("Unerwartetes Token '%1'").arg(m_tokens[m_pos]);
+        return m_error.isEmpty();
+    }
+
+    QString error() const { return m_error; }
+
+private:
+    bool atEnd() const { return m_pos >= m_tokens.size() || !m_error.isEmpty(); }
+    const QString& peek() const { return m_tokens[m_pos]; }
+
+    static bool isOr(const QString& t)  { return t == "|" || t == "OR"; }
+    static bool isAnd(const QString& t) { return t == "&" || t == "AND"; }
+    static bool isNot(const QString& t) { return t == "!" || t == "-" || t == "NOT"; }
+
+    HandleBitmap parseOr()
+    {
+        HandleBitmap result = parseAnd();
+        while (!atEnd() && isOr(peek())) {
+            ++m_pos;
+            result |= parseAnd();
+        }
+        return result;
+    }
+
+    HandleBitmap parseAnd()
+    {
+        HandleBitmap result = parseUnary();
+        while (!atEnd() && !isOr(peek()) && peek() != ")") {
+            if (isAnd(peek()))
+                ++m_pos;       // explizites AND, sonst implizit durch Leerzeichen
+            result &= parseUnary();
+        }
+        return result;
+    }
+
+    HandleBitmap parseUnary()
+    {
+        if (atEnd()) {
+            if (m_error.isEmpty())
+                m_error = "Unerwartetes Ende der Abfrage";
+            return {};
+        }
+
+        const QString tok = m_tokens[m_pos++];
+
+        if (isNot(tok)) {
+            HandleBitmap result = m_all;
+            result.andNot(parseUnary());
+            return result;
+        }
+
+        if (tok == "(") {
+            HandleBitmap inner = parseOr();
+            if (atEnd() || peek() != ")") {
+                if (m_error.isEmpty())
+                    m_error = "Fehlende schließende Klammer";
+                return {};
+            }
+            ++m_pos;
+            return inner;
+        }
+
+        if (isAnd(tok) || isOr(tok) || tok == ")") {
+            m_error = QString("Operand erwartet, gefunden '%1'").arg(tok);
+            return {};
+        }
+
+        HandleBitmap result;
+        if (!m_resolve(tok, result, m_error))
+            return {};
+        return result;
+    }
+
+    QStringList m_tokens;
+    int m_pos = 0;
+    QString m_error;
+
+    HandleBitmap m_all;
+    Resolver m_resolve;
+};
+
+// Teilergebnis eines Bau-Blocks
+struct PartialPostings {
+    HandleBitmap bits[32];
+    QHash<QString, HandleBitmap> types;
+};
+
+}
+
+// =============================================================
+// FlagUsageIndex
+// =============================================================
+void FlagUsageIndex::clear()
+{
+    m_handles.clear();
+    m_handleOf.clear();
+    for (auto& b : m_bitPostings)
+        b = HandleBitmap{};
+    m_typePostings.clear();
+}
+
+void FlagUsageIndex::rebuild(const std::vector<std::shared_ptr<WindowData>>& windows)
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    clear();
+
+    // 1) Handles vergeben (sequenziell, Reihenfolge = Layout-Reihenfolge)
+    for (const auto& wnd : windows) {
+        if (!wnd)
+            continue;
+        for (const auto& ctrl : wnd->controls) {
+            if (!ctrl)
+                continue;
+            m_handleOf.insert(ctrl.get(), quint32(m_handles.size()));
+            m_handles.append({ wnd->name, ctrl->id, ctrl->type, ctrl->flagsMask, ctrl });
+        }
+    }
+
+    // 2) Postings parallel in Blöcken aufbauen; jeder Block füllt eigene
+    //    Teil-Bitmaps, die per OR zusammengeführt werden. Blockgröße ist ein
+    //    Vielfaches von 64 → jedes Wort bekommt Bits aus genau einem Block.
+    const int total = m_handles.size();
+    const int threads = qMax(1, QThread::idealThreadCount());
+    const int blockSize = qMax(64, ((total / threads + 63) / 64) * 64);
+
+    QVector<QPair<int, int>> blocks;
+    for (int begin = 0; begin < total; begin += blockSize)
+        blocks.append({ begin, qMin(total, begin + blockSize) });
+
+    const QVector<Handle>& handles = m_handles;
+
+    auto buildBlock = [&handles](const QPair<int, int>& range) {
+        PartialPostings part;
+        for (int h = range.first; h < range.second; ++h) {
+            const Handle& e = handles[h];
+            quint32 mask = e.mask;
+            while (mask) {
+                part.bits[std::countr_zero(mask)].set(quint32(h));
+                mask &= mask - 1;
+            }
+            part.types[e.type].set(quint32(h));
+        }
+        return part;
+    };
+
+    auto mergeBlock = [](PartialPostings& acc, const PartialPostings& part) {
+        for (int b = 0; b < 32; ++b)
+            acc.bits[b] |= part.bits[b];
+        for (auto it = part.types.constBegin(); it != part.types.constEnd(); ++it)
+            acc.types[it.key()] |= it.value();
+    };
+
+    PartialPostings merged =
+        QtConcurrent::blockingMappedReduced<PartialPostings>(blocks, buildBlock, mergeBlock);
+
+    for (int b = 0; b < 32; ++b)
+        m_bitPostings[b] = std::move(merged.bits[b]);
+    m_typePostings = std::move(merged.types);
+
+    qInfo().noquote()
+        << QString("[FlagUsageIndex] Aufgebaut: %1 Controls, %2 Typen, %3 Blöcke in %4 ms")
+               .arg(total)
+               .arg(m_typePostings.size())
+               .arg(blocks.size())
+               .arg(timer.elapsed());
+}
+
+void FlagUsageIndex::insertPostings(quint32 handle, const QString& type, quint32 mask)
+{
+    while (mask) {
+        m_bitPostings[std::countr_zero(mask)].set(handle);
+        mask &= mask - 1;
+    }
+    m_typePostings[type].set(handle);
+}
+
+void FlagUsageIndex::removePostings(quint32 handle, const QString& type, quint32 mask)
+{
+    while (mask) {
+        m_bitPostings[std::countr_zero(mask)].reset(handle);
+        mask &= mask - 1;
+    }
+
+    auto it = m_typePostings.find(type);
+    if (it != m_typePostings.end()) {
+        it->reset(handle);
+        if (it->isEmpty())
+            m_typePostings.erase(it);
+    }
+}
+
+quint32 FlagUsageIndex::addHandle(const std::shared_ptr<const ControlData>& ctrl, const QString& windowName)
+{
+    const quint32 handle = quint32(m_handles.size());
+    m_handleOf.insert(ctrl.get(), handle);
+    m_handles.append({ windowName, ctrl->id, ctrl->type, ctrl->flagsMask, ctrl });
+    insertPostings(handle, ctrl->type, ctrl->flagsMask);
+    return handle;
+}
+
+void FlagUsageIndex::updateControl(const std::shared_ptr<const ControlData>& ctrl, const QString& windowName)
+{
+    if (!ctrl)
+        return;
+
+    auto it = m_handleOf.find(ctrl.get());
+    if (it == m_handleOf.end()) {
+        addHandle(ctrl, windowName);     // neu angelegtes Control
+        return;
+    }
+
+    Handle& e = m_handles[int(it.value())];
+
+    // Adresse gehört einem neuen Control (altes freigegeben) → altes
+    // Handle aus den Postings nehmen, neues Control neu eintragen
+    if (e.owner.lock() != ctrl) {
+        removePostings(it.value(), e.type, e.mask);
+        e.mask = 0;
+        e.owner.reset();
+        m_handleOf.erase(it);
+        addHandle(ctrl, windowName);
+        return;
+    }
+
+    if (!windowName.isEmpty())
+        e.windowName = windowName;
+    if (e.mask == ctrl->flagsMask && e.type == ctrl->type && e.controlId == ctrl->id)
+        return;
+
+    removePostings(it.value(), e.type, e.mask);
+
+    e.controlId = ctrl->id;
+    e.type = ctrl->type;
+    e.mask = ctrl->flagsMask;
+
+    insertPostings(it.value(), e.type, e.mask);
+}
+
+HandleBitmap FlagUsageIndex::unknownBits(quint32 knownMask, quint32 range) const
+{
+    HandleBitmap result;
+    quint32 unknown = range & ~knownMask;
+    while (unknown) {
+        result |= m_bitPostings[std::countr_zero(unknown)];
+        unknown &= unknown - 1;
+    }
+    return result;
+}
+
+HandleBitmap FlagUsageIndex::evaluate(const QString& query,
+                                      const QMap<QString, quint32>& windowFlags,
+                                      const QMap<QString, quint32>& controlFlags,
+                                      QString* error) const
+{
+    quint32 knownLow = 0;
+    for (auto it = controlFlags.constBegin(); it != controlFlags.constEnd(); ++it)
+        knownLow |= it.value();
+
+    quint32 knownHigh = 0;
+    for (auto it = windowFlags.constBegin(); it != windowFlags.constEnd(); ++it)
+        knownHigh |= it.value();
+
+    const HandleBitmap all = HandleBitmap::full(quint32(m_handles.size()));
+
+    auto resolve = [&](const QString& name, HandleBitmap& out, QString& err) -> bool {
+        if (name == "ALL") {
+            out = all;
+            return true;
+        }
+        if (name == "UNKNOWN_LOW") {
+            out = unknownBits(knownLow, 0x0000FFFF);
+            return true;
+        }
+        if (name == "UNKNOWN_HIGH") {
+            out = unknownBits(knownHigh, 0xFFFF0000);
+            return true;
+        }
+        if (name == "UNKNOWN") {
+            out = unknownBits(knownLow, 0x0000FFFF);
+            out |= unknownBits(knownHigh, 0xFFFF0000);
+            return true;
+        }
+
+        if (name.startsWith("WTYPE_")) {
+            out = m_typePostings.value(name);
+            return true;
+        }
+
+        // Control-Flags (Low-Word) zuerst, dann Window-Flags
+        quint32 value = 0;
+        if (controlFlags.contains(name))
+            value = controlFlags.value(name);
+        else if (windowFlags.contains(name))
+            value = windowFlags.value(name);
+        else {
+            err = QString("Unbekanntes Flag '%1'").arg(name);
+            return false;
+        }
+
+        if (value == 0) {
+            err = QString("Flag '%1' hat den Wert 0 und ist nicht abfragbar").arg(name);
+            return false;
+        }
+
+        // Mehrbit-Werte (z. B. BS_AUTOCHECKBOX) → alle Bits müssen gesetzt sein
+        out = all;
+        while (value) {
+            out &= m_bitPostings[std::countr_zero(value)];
+            value &= value - 1;
+        }
+        return true;
+    };
+
+    QueryParser parser(query, all, resolve);
+    HandleBitmap result;
+    if (!parser.parse(result)) {
+        if (error)
+            *error = parser.error();
+        return {};
+    }
+
+    if (error)
+        error->clear();
+    return result;
+}
+
+QVector<FlagUsageIndex::Hit> FlagUsageIndex::hits(const HandleBitmap& bitmap) const
+{
+    QVector<Hit> result;
+    result.reserve(bitmap.count());
+
+    bitmap.forEach([&](quint32 h) {
+        if (h < quint32(m_handles.size())) {
+            const Handle& e = m_handles[int(h)];
+            if (!e.owner.expired())     // gelöschte Controls nicht melden
+                result.append({ e.windowName, e.controlId, e.type, e.mask });
+        }
+    });
+    return result;
+}
+
+QVector<FlagUsageIndex::Hit> FlagUsageIndex::query(const QString& query,
+                                                   const QMap<QString, quint32>& windowFlags,
+                                                   const QMap<QString, quint32>& controlFlags,
+                                                   QString* error) const
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    const HandleBitmap bitmap = evaluate(query, windowFlags, controlFlags, error);
+    const qint64 evalNs = timer.nsecsElapsed();
+
+    QVector<Hit> result = hits(bitmap);
+
+    qInfo().noquote()
+        << QString("[FlagUsageIndex] '%1' → %2 Treffer (%3 µs)")
+               .arg(query)
+               .arg(result.size())
+               .arg(evalNs / 1000.0, 0, 'f', 1);
+    return result;
+}
+
+QMap<QString, int> FlagUsageIndex::typeCounts() const
+{
+    QMap<QString, int> counts;
+    for (auto it = m_typePostings.constBegin(); it != m_typePostings.constEnd(); ++it)
+        counts.insert(it.key(), it.value().count());
+    return counts;
+}
@@ -0,0 +1,127 @@
+#pragma once
+
+#include <QHash>
+#include <QMap>
+#include <QString>
+#include <QVector>
+#include <bit>
+#include <memory>
+#include <vector>
+
+struct WindowData;
+struct ControlData;
+
+// ------------------------------------------------------------
+// HandleBitmap – Posting-Liste über Control-Handles
+// ------------------------------------------------------------
+// Dichtes Bitset (64 Handles pro Wort), abschließende Null-Wörter
+// werden abgeschnitten. Bei einigen tausend Controls sind das nur
+// wenige hundert Bytes pro Liste – AND/OR/ANDNOT laufen wortweise.
+// ------------------------------------------------------------
+class HandleBitmap
+{
+public:
+    void set(quint32 handle);
+    void reset(quint32 handle);
+    bool test(quint32 handle) const;
+
+    bool isEmpty() const { return m_words.isEmpty(); }
+    int count() const;
+
+    HandleBitmap& operator&=(const HandleBitmap& other);
+    HandleBitmap& operator|=(const HandleBitmap& other);
+    HandleBitmap& andNot(const HandleBitmap& other);
+
+    // Alle Handles 0 … size-1
+    static HandleBitmap full(quint32 size);
+
+    template <typename Fn>
+    void forEach(Fn&& fn) const
+    {
+        for (int w = 0; w < m_words.size(); ++w) {
+            quint64 word = m_words[w];
+            while (word) {
+                const int bit = std::countr_zero(word);
+                fn(quint32(w) * 64 + quint32(bit));
+                word &= word - 1;
+            }
+        }
+    }
+
+private:
+    void trim();
+
+    QVector<quint64> m_words;
+};
+
+// ------------------------------------------------------------
+// FlagUsageIndex – invertierter Index Flag-Bit / Typ → Controls
+// ------------------------------------------------------------
+// Jedes Control bekommt beim Aufbau ein Handle. Pro Bit (0–31)
+// und pro Control-Typ gibt es eine HandleBitmap. Abfragen wie
+//   "BS_CHECKBOX & WBS_NODRAWFRAME"
+//   "WTYPE_LISTCTRL & UNKNOWN_HIGH"
+//   "WTYPE_BUTTON & !WBS_VISIBLE"
+// werden als Bitmap-Verknüpfungen ausgewertet.
+//
+// Syntax: & / AND, | / OR, ! / NOT, Klammern; Leerzeichen = AND.
+// Sonderterme: ALL, UNKNOWN, UNKNOWN_LOW, UNKNOWN_HIGH.
+// ------------------------------------------------------------
+class FlagUsageIndex
+{
+public:
+    struct Hit {
+        QString windowName;
+        QString controlId;
+        QString type;
+        quint32 mask = 0;
+    };
+
+    void clear();
+
+    // Vollständiger Aufbau (parallel über Handle-Blöcke)
+    void rebuild(const std::vector<std::shared_ptr<WindowData>>& windows);
+
+    // Inkrementell nach Flag-Änderung eines Controls; noch nicht
+    // indizierte Controls bekommen ein neues Handle
+    void updateControl(const std::shared_ptr<const ControlData>& ctrl, const QString& windowName);
+
+    int size() const { return m_handles.size(); }
+
+    // Abfrage auswerten – bei Syntaxfehler leeres Ergebnis + error gesetzt
+    HandleBitmap evaluate(const QString& query,
+                          const QMap<QString, quint32>& windowFlags,
+                          const QMap<QString, quint32>& controlFlags,
+                          QString* error = nullptr) const;
+
+    QVector<Hit> query(const QString& query,
+                       const QMap<QString, quint32>& windowFlags,
+                       const QMap<QString, quint32>& controlFlags,
+                       QString* error = nullptr) const;
+
+    QVector<Hit> hits(const HandleBitmap& bitmap) const;
+
+    // Statistik: Control-Typ → Anzahl
+    QMap<QString, int> typeCounts() const;
+
+private:
+    struct Handle {
+        QString windowName;
+        QString controlId;
+        QString type;
+        quint32 mask = 0;
+        std::weak_ptr<const ControlData> owner;   // erkennt wiederverwendete Adressen
+    };
+
+    quint32 addHandle(const std::shared_ptr<const ControlData>& ctrl, const QString& windowName);
+    void insertPostings(quint32 handle, const QString& type, quint32 mask);
+    void removePostings(quint32 handle, const QString& type, quint32 mask);
+
+    HandleBitmap unknownBits(quint32 knownMask, quint32 range) const;
+
+    QVector<Handle> m_handles;
+    QHash<const ControlData*, quint32> m_handleOf;    // nur gültig, solange owner lebt
+
+    HandleBitmap m_bitPostings[32];
+    QHash<QString, HandleBitmap> m_typePostings;
+};
@@ -0,0 +1,175 @@
+#include "RuleModel.h"
+
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QSet>
+
+namespace {
+
+size_t digestOf(const QJsonValue& value)
+{
+    // Wrapper-Objekt, damit auch Arrays / Skalare kompakt serialisiert werden
+    const QJsonObject wrapper{ { "v", value } };
+    return qHash(QJsonDocument(wrapper).toJson(QJsonDocument::Compact));
+}
+
+ParsedRule::Attributes toAttributes(const QJsonObject& obj)
+{
+    ParsedRule::Attributes attrs;
+    attrs.reserve(obj.size());
+    for (auto it = obj.constBegin(); it != obj.constEnd(); ++it)
+        attrs.append({ it.key(), it.value().toVariant() });
+    return attrs;
+}
+
+template <typename Map>
+QStringList diffHashes(const Map& a, const Map& b)
+{
+    QSet<QString> keys;
+    for (auto it = a.constBegin(); it != a.constEnd(); ++it)
+        keys.insert(it.key());
+    for (auto it = b.constBegin(); it != b.constEnd(); ++it)
+        keys.insert(it.key());
+
+    QStringList changed;
+    for (const QString& key : keys) {
+        auto ia = a.constFind(key);
+        auto ib = b.constFind(key);
+        if (ia == a.constEnd() || ib == b.constEnd() || ia.value() != ib.value())
+            changed << key;
+    }
+    return changed;
+}
+
+}
+
+quint32 orFlags(const QJsonArray& names, const QMap<QString, quint32>& flags)
+{
+    quint32 mask = 0;
+    for (const QJsonValue& v : names)
+        mask |= flags.value(v.toString(), 0);
+    return mask;
+}
+
+// =============================================================
+// FlagRuleSet
+// =============================================================
+FlagRuleSet FlagRuleSet::parse(const QJsonObject& root, const QMap<QString, quint32>& flags)
+{
+    FlagRuleSet set;
+    set.m_entries.reserve(root.size());
+
+    for (auto it = root.constBegin(); it != root.constEnd(); ++it)
+    {
+        const QString& key = it.key();
+        const QJsonObject obj = it.value().toObject();
+
+        ParsedRule rule;
+        rule.key = key;
+        rule.sourceHash = digestOf(it.value());
+
+        if (flags.contains(key)) {
+            rule.kind = RuleKeyKind::Flag;
+            rule.bits = flags.value(key);
+        }
+        else if (key == "Default")
+            rule.kind = RuleKeyKind::Default;
+        else if (key.startsWith("WTYPE_"))
+            rule.kind = RuleKeyKind::ControlType;
+        else
+            rule.kind = RuleKeyKind::Window;
+
+        if (rule.kind == RuleKeyKind::Flag)
+        {
+            rule.set = toAttributes(obj.value("set").toObject());
+            rule.impliedByFlag = orFlags(obj.value("implies").toArray(), flags);
+        }
+        else
+        {
+            // "valid": leere Liste = keine Einschränkung
+            const QJsonArray valid = obj.value("valid").toArray();
+            if (!valid.isEmpty()) {
+                rule.hasValid = true;
+                rule.validBits = orFlags(valid, flags);
+            }
+
+            // "exclusive": { FLAG : [FLAGS] }  → FLAG schließt jedes gelistete
+            //                                    Flag aus (paarweise), die
+            //                                    gelisteten untereinander nicht
+            //              { Gruppenname : [FLAGS] } → alle gegenseitig exklusiv
+            const QJsonObject excl = obj.value("exclusive").toObject();
+            for (auto e = excl.constBegin(); e != excl.constEnd(); ++e) {
+                const QJsonArray listed = e.value().toArray();
+
+                if (flags.contains(e.key())) {
+                    const quint32 owner = flags.value(e.key());
+                    for (const QJsonValue& v : listed)
+                        rule.exclusive.append({ owner, flags.value(v.toString(), 0) });
+                    continue;
+                }
+
+                QVector<quint32> group;
+                for (const QJsonValue& v : listed)
+                    group.append(flags.value(v.toString(), 0));
+                rule.exclusive.append(group);
+            }
+
+            // "implies": { FLAG : [FLAGS] }
+            const QJsonObject imp = obj.value("implies").toObject();
+            for (auto i = imp.constBegin(); i != imp.constEnd(); ++i) {
+                const quint32 trigger = flags.value(i.key(), 0);
+                const quint32 implied = orFlags(i.value().toArray(), flags);
+                if (trigger != 0 && implied != 0)
+                    rule.implies.append({ trigger, implied });
+            }
+        }
+
+        set.m_index.insert(key, set.m_entries.size());
+        set.m_entries.append(std::move(rule));
+    }
+
+    return set;
+}
+
+const ParsedRule* FlagRuleSet::find(const QString& key) const
+{
+    auto it = m_index.constFind(key);
+    return it != m_index.constEnd() ? &m_entries[it.value()] : nullptr;
+}
+
+QStringList FlagRuleSet::diffKeys(const FlagRuleSet& other) const
+{
+    QHash<QString, size_t> a, b;
+    for (const ParsedRule& r : m_entries)
+        a.insert(r.key, r.sourceHash);
+    for (const ParsedRule& r : other.m_entries)
+        b.insert(r.key, r.sourceHash);
+    return diffHashes(a, b);
+}
+
+// =============================================================
+// BehaviorConfigModel
+// =============================================================
+BehaviorConfigModel BehaviorConfigModel::parse(const QJsonObject& root)
+{
+    BehaviorConfigModel model;
+
+    for (auto it = root.constBegin(); it != root.constEnd(); ++it) {
+        model.m_overrides.insert(it.key(), toAttributes(it.value().toObject()));
+        model.m_hashes.insert(it.key(), digestOf(it.value()));
+    }
+
+    return model;
+}
+
+const BehaviorConfigModel::Attributes*
+BehaviorConfigModel::overridesFor(const QString& normalizedType) const
+{
+    auto it = m_overrides.constFind(normalizedType);
+    return it != m_overrides.constEnd() ? &it.value() : nullptr;
+}
+
+QStringList BehaviorConfigModel::diffKeys(const BehaviorConfigModel& other) const
+{
+    return diffHashes(m_hashes, other.m_hashes);
+}
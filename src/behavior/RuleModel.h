@@ -0,0 +1,97 @@
+#pragma once
+
+#include <QHash>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QMap>
+#include <QPair>
+#include <QString>
+#include <QStringList>
+#include <QVariant>
+#include <QVector>
+
+// ------------------------------------------------------------
+// Typisiertes Regelmodell
+// ------------------------------------------------------------
+// window_flag_rules.json / control_flag_rules.json und
+// behavior_config.json werden nur beim Laden geparst. Flagnamen
+// sind danach bereits zu Bits aufgelöst, die Art jedes Keys steht
+// als Enum fest – Hot-Paths fassen kein QJsonValue mehr an.
+// ------------------------------------------------------------
+
+// Flagnamen → ODER ihrer Werte (unbekannte Namen zählen 0)
+quint32 orFlags(const QJsonArray& names, const QMap<QString, quint32>& flags);
+
+// Art eines Top-Level-Keys in einer Regeldatei
+enum class RuleKeyKind
+{
+    Flag,           // BS_CHECKBOX, WBS_CAPTION, ...  → {"set": {...}, "implies": [...]}
+    ControlType,    // WTYPE_*                       → {"valid", "exclusive", "implies"}
+    Window,         // APP_*                         → {"valid", "exclusive", "implies"}
+    Default         // "Default"
+};
+
+struct ParsedRule
+{
+    using Attributes = QVector<QPair<QString, QVariant>>;
+
+    QString     key;
+    RuleKeyKind kind = RuleKeyKind::Window;
+    quint32     bits = 0;                    // nur Flag: Wert des Flags
+
+    // Flag-Einträge
+    Attributes set;                          // "set": Attribut-Overrides
+    quint32    impliedByFlag = 0;            // "implies": [FLAGS] → Bits
+
+    // Typ-/Fenster-/Default-Einträge
+    bool    hasValid  = false;
+    quint32 validBits = 0;
+    QVector<QVector<quint32>>        exclusive;   // Gruppen (Flagwerte), FLAG-Keys als Paare
+    QVector<QPair<quint32, quint32>> implies;     // Trigger → implizierte Bits
+
+    size_t sourceHash = 0;                   // Digest des Quell-JSON (Hot-Reload-Diff)
+
+    bool hasConstraints() const { return hasValid || !exclusive.isEmpty() || !implies.isEmpty(); }
+};
+
+// ------------------------------------------------------------
+// FlagRuleSet – eine geparste *_flag_rules.json
+// ------------------------------------------------------------
+class FlagRuleSet
+{
+public:
+    static FlagRuleSet parse(const QJsonObject& root, const QMap<QString, quint32>& flags);
+
+    const ParsedRule* find(const QString& key) const;
+    const QVector<ParsedRule>& entries() const { return m_entries; }
+    bool isEmpty() const { return m_entries.isEmpty(); }
+
+    // Keys, die hinzugekommen, entfallen oder inhaltlich geändert sind
+    QStringList diffKeys(const FlagRuleSet& other) const;
+
+private:
+    QVector<ParsedRule> m_entries;
+    QHash<QString, int> m_index;
+};
+
+// ------------------------------------------------------------
+// BehaviorConfigModel – geparste behavior_config.json
+// (normalisierter Typ → Attribut-Overrides)
+// ------------------------------------------------------------
+class BehaviorConfigModel
+{
+public:
+    using Attributes = ParsedRule::Attributes;
+
+    static BehaviorConfigModel parse(const QJsonObject& root);
+
+    // nullptr, wenn für den Typ nichts konfiguriert ist
+    const Attributes* overridesFor(const QString& normalizedType) const;
+    bool isEmpty() const { return m_overrides.isEmpty(); }
+
+    QStringList diffKeys(const BehaviorConfigModel& other) const;
+
+private:
+    QHash<QString, Attributes> m_overrides;
+    QHash<QString, size_t>     m_hashes;
+};
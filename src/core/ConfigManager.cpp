@@ -25,6 +25,12 @@ QString ConfigManager::defaultConfigDir()
     return base + "/config";
 }
 
+QString ConfigManager::defaultThemeDiskCachePath()
+{
+    const QString base = QCoreApplication::applicationDirPath();
+    return base + "/cache/textures";
+}
+
 QString ConfigManager::windowFlagsPath() const {
     return defaultConfigDir() + "/window_flags.json";
 }
@@ -57,6 +63,16 @@ bool ConfigManager::load(const QString& filePath)
     m_flagWindowRulesPath    = cfg.value("Flags/FlagWindowRules").toString();
     m_flagControlRulesPath  = cfg.value("Flags/FlagControlRules").toString();
 
+    // 🔹 Textsprachen
+    m_textLanguages.clear();
+    cfg.beginGroup("TextLanguages");
+    for (const QString& lang : cfg.childKeys())
+        m_textLanguages.append({ lang, cfg.value(lang).toString() });
+    cfg.endGroup();
+    m_textLanguage = cfg.value("Texts/Language").toString();
+    m_themeCacheMB = qMax(16, cfg.value("Themes/CacheMB", 256).toInt());
+    m_themeDiskCachePath = cfg.value("Themes/DiskCache", defaultThemeDiskCachePath()).toString();
+
     bool updated = false;
 
     // Fallbacks ergänzen, falls leer
@@ -124,6 +140,14 @@ bool ConfigManager::save(const QString& filePath) const
     cfg.setValue("Flags/FlagWindowRules",   m_flagWindowRulesPath);
     cfg.setValue("Flags/FlagControlRules",  m_flagControlRulesPath);
 
+    // 🔹 Textsprachen
+    cfg.remove("TextLanguages");
+    for (const auto& lang : m_textLanguages)
+        cfg.setValue("TextLanguages/" + lang.first, lang.second);
+    cfg.setValue("Texts/Language", m_textLanguage);
+    cfg.setValue("Themes/CacheMB", m_themeCacheMB);
+    cfg.setValue("Themes/DiskCache", m_themeDiskCachePath);
+
     cfg.sync();
     qInfo() << "[ConfigManager] Gespeichert:" << filePath;
     return true;
@@ -145,6 +169,7 @@ bool ConfigManager::createDefault(const QString& filePath)
     m_themePath  = base + "/data/themes";
     m_iconPath   = base + "/data/icons";
     m_sourcePath = base + "/data/source";
+    m_themeDiskCachePath = defaultThemeDiskCachePath();
 
     // 🔹 Flags + Regeln
     m_windowFlagsPath        = cfgDir + "/window_flags.json";
@@ -5,6 +5,8 @@
 #include <QDir>
 #include <QFileInfo>
 #include <QDebug>
+#include <QList>
+#include <QPair>
 
 class ConfigManager
 {
@@ -29,6 +31,20 @@ public:
     QString flagWindowRulesPath() const { return m_flagWindowRulesPath; }
     QString flagControlRulesPath() const { return m_flagControlRulesPath; }
 
+    // Sprachen → textClient.txt ([TextLanguages] Name=Pfad)
+    QList<QPair<QString, QString>> textLanguages() const { return m_textLanguages; }
+    QString textLanguage() const { return m_textLanguage; }
+    void setTextLanguage(const QString& v) { m_textLanguage = v; }
+
+    // Speicherbudget für dekodierte Theme-Texturen (MB)
+    int themeCacheMB() const { return m_themeCacheMB; }
+    void setThemeCacheMB(int v) { m_themeCacheMB = v; }
+
+    // Verzeichnis für aufbereitete Texturen (leer = kein Disk-Cache)
+    static QString defaultThemeDiskCachePath();
+    QString themeDiskCachePath() const { return m_themeDiskCachePath; }
+    void setThemeDiskCachePath(const QString& v) { m_themeDiskCachePath = v; }
+
     QString undefinedControlFlagsPath() const;
     QString windowFlagsPath() const;
     QString controlFlagsPath() const;
@@ -55,4 +71,9 @@ private:
     QString m_windowFlagsPath;
     QString m_controlFlagsPath;
     QString m_undefinedControlFlagsPath;
+
+    QList<QPair<QString, QString>> m_textLanguages;
+    QString m_textLanguage;
+    int m_themeCacheMB = 256;
+    QString m_themeDiskCachePath;
 };
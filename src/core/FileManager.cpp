@@ -283,6 +283,42 @@ QString FileManager::controlFlagRulesPath() const
     return path;
 }
 
+QString FileManager::behaviorConfigPath() const
+{
+    if (!m_config) {
+        qWarning().noquote()
+        << "[FileManager] Kein ConfigManager – kann behavior_config.json nicht bestimmen.";
+        return {};
+    }
+
+    const QString dir = QCoreApplication::applicationDirPath() + "/config";
+    QDir().mkpath(dir);
+
+    const QString path = dir + "/behavior_config.json";
+    qInfo().noquote() << "[FileManager] behaviorConfigPath() →" << path;
+    return path;
+}
+
+QString FileManager::flagGroupsPath() const
+{
+    const QString dir = QCoreApplication::applicationDirPath() + "/config";
+    QDir().mkpath(dir);
+
+    const QString path = dir + "/flag_groups.json";
+    qInfo().noquote() << "[FileManager] flagGroupsPath() →" << path;
+    return path;
+}
+
+QString FileManager::flagDatabasePath() const
+{
+    const QString dir = QCoreApplication::applicationDirPath() + "/config";
+    QDir().mkpath(dir);
+
+    const QString path = dir + "/flags.db";
+    qInfo().noquote() << "[FileManager] flagDatabasePath() →" << path;
+    return path;
+}
+
 QString FileManager::windowFlagsPath() const
 {
     if (!m_config) {
@@ -41,6 +41,9 @@ public:
     QString undefinedControlFlagsPath() const;
     QString windowFlagRulesPath() const;
     QString controlFlagRulesPath() const;
+    QString behaviorConfigPath() const;
+    QString flagGroupsPath() const;
+    QString flagDatabasePath() const;
 
     // Undefinierte ControlFlags
     static bool loadUndefinedControlFlags(const ConfigManager& cfg, QJsonObject& outJson);
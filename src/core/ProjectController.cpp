@@ -24,6 +24,8 @@
 #include <QDebug>
 #include <QTimer>
 #include <QMessageBox>
+#include <QFileSystemWatcher>
+#include <QScopeGuard>
 
 // --------------------------------------------------
 // Konstruktor
@@ -51,11 +53,39 @@ ProjectController::ProjectController(QObject* parent)
         m_layoutBackend.get())),
     m_renderManager(std::make_unique<RenderManager>(
         m_themeManager.get(),
-        m_behaviorManager.get()))
+        m_behaviorManager.get())),
+    m_sourceUsage(std::make_unique<SourceUsageScanner>())
 {
     m_layoutManager->setBehaviorManager(m_behaviorManager.get());
     connect(m_layoutManager.get(), &LayoutManager::tokensReady,
             this, &ProjectController::onTokensReady);
+
+    // Lazy Behavior: aktives Fenster vor dem ersten Rendern auflösen
+    // (erste Verbindung → läuft vor Canvas-/Panel-Slots)
+    connect(this, &ProjectController::activeWindowChanged,
+            this, [this](const std::shared_ptr<WindowData>& wnd) {
+                m_layoutManager->ensureBehaviorResolved(wnd);
+
+                // Texturen des Fensters parallel vordekodieren statt beim ersten Zeichnen
+                if (wnd && m_themeManager) {
+                    QStringList textures{ wnd->texture };
+                    for (const auto& ctrl : wnd->controls)
+                        if (ctrl)
+                            textures << ctrl->texture;
+                    m_themeManager->prefetch(textures);
+                }
+            });
+
+    // Editoren speichern oft mehrfach kurz hintereinander → entprellen
+    m_configWatcher = new QFileSystemWatcher(this);
+    m_configReloadTimer = new QTimer(this);
+    m_configReloadTimer->setSingleShot(true);
+    m_configReloadTimer->setInterval(150);
+
+    connect(m_configWatcher, &QFileSystemWatcher::fileChanged,
+            this, &ProjectController::onConfigFileChanged);
+    connect(m_configReloadTimer, &QTimer::timeout,
+            this, &ProjectController::applyPendingConfigChanges);
 }
 
 void ProjectController::onTokensReady()
@@ -95,6 +125,14 @@ bool ProjectController::loadProject(const QString& configPath)
     m_loadingActive = true;
     m_tokensReady = false;
 
+    // Auch bei Abbruch: Ladeflag zurücksetzen, während des Ladens
+    // eingetroffene Config-Änderungen nachholen
+    const auto loadingDone = qScopeGuard([this] {
+        m_loadingActive = false;
+        if (!m_pendingConfigChanges.isEmpty())
+            m_configReloadTimer->start();
+    });
+
     const QString cfgFile = configPath.isEmpty()
                                 ? ConfigManager::defaultConfigPath()
                                 : configPath;
@@ -115,13 +153,11 @@ bool ProjectController::loadProject(const QString& configPath)
         QString themeDir = QFileDialog::getExistingDirectory(nullptr, "Wähle den Theme-Ordner");
         if (themeDir.isEmpty()) return false;
 
-        QString sourceDir;
-        while (sourceDir.isEmpty() || !QDir(sourceDir).exists()) {
-            sourceDir = QFileDialog::getExistingDirectory(nullptr, "Wähle den Source-Ordner (Pflicht)");
-            if (sourceDir.isEmpty()) {
-                QMessageBox::warning(nullptr, "Pflichtfeld",
-                                     "Der Source-Ordner ist erforderlich, um Flags zu erzeugen.");
-            }
+        // Optional: ohne Source-Ordner werden die eingebauten Standard-Flags verwendet
+        const QString sourceDir = QFileDialog::getExistingDirectory(nullptr, "Wähle den Source-Ordner (optional)");
+        if (sourceDir.isEmpty()) {
+            QMessageBox::information(nullptr, "Source-Ordner",
+                                     "Kein Source-Ordner gewählt – es werden die eingebauten Standard-Flags verwendet.");
         }
 
         m_configManager->setLayoutPath(resdataFile);
@@ -138,6 +174,7 @@ bool ProjectController::loadProject(const QString& configPath)
         qWarning() << "[ProjectController] Konnte Config nicht laden:" << cfgFile;
         return false;
     }
+    m_configFile = cfgFile;
 
     const QString resdataFile = m_configManager->layoutPath();
     m_fileManager->cacheLayoutPath(resdataFile);
@@ -157,7 +194,12 @@ bool ProjectController::loadProject(const QString& configPath)
         !QFileInfo::exists(wndFlagsPath) ||
         !QFileInfo::exists(ctrlFlagsPath);
 
-    if (flagsMissing) {
+    const bool hasSource = !sourceDir.isEmpty() && QDir(sourceDir).exists();
+
+    if (flagsMissing && !hasSource) {
+        // Zero-I/O-Start: BehaviorManager greift auf DefaultFlags.h zurück
+        qInfo() << "[ProjectController] Flags fehlen, kein Source-Ordner → eingebaute Standard-Flags.";
+    } else if (flagsMissing) {
         qInfo() << "[ProjectController] Flags fehlen → Erstelle neu.";
 
         m_flagManager->generateFlags(sourceDir, wndFlagsPath, ctrlFlagsPath);
@@ -184,13 +226,17 @@ bool ProjectController::loadProject(const QString& configPath)
     m_layoutBackend->setPath(resdataFile);
     m_layoutBackend->load();                      // Tokens generieren
     m_layoutManager->refreshFromParser();         // Tokens → Raw Layout
-    m_layoutManager->processLayout();             // Behavior wird HIER angewendet!
+    m_layoutManager->processLayout();             // Behavior wird lazy aufgelöst
 
     emit layoutsReady();
 
     auto windows = m_layoutManager->processedWindows();
     qInfo() << "[ProjectController] Processed Layouts:" << windows.size();
 
+    // Batch-Validierung gegen die vorkompilierten Flag-Regeln
+    const int flagIssues = m_behaviorManager->flagRules().validateAll(windows, true);
+    qInfo().noquote() << "[ProjectController] Flag-Validierung:" << flagIssues << "Verstöße";
+
     // ---------------------------------------------------
     // 5) Defines + Texte anwenden
     // ---------------------------------------------------
@@ -201,8 +247,29 @@ bool ProjectController::loadProject(const QString& configPath)
     if (!defineFile.isEmpty())
         m_defineBackend->load(defineFile, *m_defineManager);
 
+    // Sprachen aus [TextLanguages]; die gefundene textClient.txt bleibt Spalte 0
+    QVector<TextStore::Source> textSources;
     if (!textFile.isEmpty())
-        m_textBackend->loadText(textFile, *m_textManager);
+        textSources.append({ QStringLiteral("Default"), textFile });
+    for (const auto& lang : m_configManager->textLanguages()) {
+        if (QFileInfo(lang.second).absoluteFilePath() == QFileInfo(textFile).absoluteFilePath()) {
+            if (!textSources.isEmpty())
+                textSources.first().language = lang.first;
+            continue;
+        }
+        if (QFileInfo::exists(lang.second))
+            textSources.append({ lang.first, lang.second });
+        else
+            qWarning().noquote() << "[ProjectController] Textdatei fehlt:" << lang.first << lang.second;
+    }
+
+    if (!textSources.isEmpty()) {
+        m_textBackend->loadTexts(textSources, *m_textManager);
+
+        const int lang = m_textManager->store().languageIndex(m_configManager->textLanguage());
+        if (lang >= 0)
+            m_textManager->setCurrentLanguage(lang);
+    }
 
     if (!textIncFile.isEmpty())
         m_textBackend->loadInc(textIncFile, *m_textManager);
@@ -220,11 +287,19 @@ bool ProjectController::loadProject(const QString& configPath)
         defaultTheme = "English";
 
     qInfo().noquote() << "[ProjectController] Lade Theme:" << defaultTheme;
+    m_themeManager->setCacheBudget(qint64(m_configManager->themeCacheMB()) * 1024 * 1024);
+    m_themeManager->setDiskCacheDirectory(m_configManager->themeDiskCachePath());
     m_themeManager->loadTheme(defaultTheme);
 
     // ---------------------------------------------------
     // 7) Projekt finalisieren
     // ---------------------------------------------------
+    setupConfigWatcher();
+
+    // Nutzung von APP_/WIDC_ im Client-Code (Hintergrund, Ergebnis über sourceUsage())
+    if (hasSource)
+        m_sourceUsage->start(sourceDir, windows);
+
     emit projectLoaded();
 
     QTimer::singleShot(0, this, [this, windows]() {
@@ -234,11 +309,201 @@ bool ProjectController::loadProject(const QString& configPath)
         }
     });
 
-    m_loadingActive = false;
     return true;
 }
 
 
+// --------------------------------------------------
+// Hot-Reload der Regel- und Behavior-Dateien
+// --------------------------------------------------
+void ProjectController::setupConfigWatcher()
+{
+    if (!m_configWatcher)
+        return;
+
+    const QStringList watched = m_configWatcher->files();
+    if (!watched.isEmpty())
+        m_configWatcher->removePaths(watched);
+
+    const QStringList paths = {
+        m_fileManager->windowFlagRulesPath(),
+        m_fileManager->controlFlagRulesPath(),
+        m_fileManager->behaviorConfigPath(),
+        m_fileManager->flagGroupsPath()
+    };
+
+    for (const QString& path : paths) {
+        if (!path.isEmpty() && QFileInfo::exists(path))
+            m_configWatcher->addPath(path);
+    }
+
+    qInfo() << "[ProjectController] Config-Watcher aktiv:" << m_configWatcher->files();
+}
+
+void ProjectController::onConfigFileChanged(const QString& path)
+{
+    // Viele Editoren ersetzen die Datei (delete + rename) → Watch geht verloren
+    if (QFileInfo::exists(path) && !m_configWatcher->files().contains(path))
+        m_configWatcher->addPath(path);
+
+    m_pendingConfigChanges.insert(path);
+    m_configReloadTimer->start();
+}
+
+// Neu kompilierte Flag-Regeln auf betroffene Fenster/Controls
+// anwenden (wie beim Setzen im PropertyPanel: correct() + resolvedMask)
+int ProjectController::reapplyFlagRules(const QSet<QString>& changedKeys, bool allTargets)
+{
+    const FlagRuleEngine& rules = m_behaviorManager->flagRules();
+    if (!rules.isCompiled() || (changedKeys.isEmpty() && !allTargets))
+        return 0;
+
+    int fixed = 0;
+
+    for (const auto& wnd : m_layoutManager->processedWindows())
+    {
+        if (!wnd)
+            continue;
+
+        if (allTargets || m_behaviorManager->isAffected(*wnd, changedKeys)) {
+            const quint32 mask = FlagRuleEngine::correct(rules.rulesForWindow(wnd->name), wnd->flagsMask);
+            if (mask != wnd->flagsMask) {
+                wnd->flagsMask = mask;
+                m_behaviorManager->updateWindowFlags(wnd);
+                if (wnd->behaviorResolved)
+                    wnd->behavior = m_behaviorManager->resolveBehavior(*wnd);
+                ++fixed;
+            }
+        }
+
+        for (const auto& ctrl : wnd->controls)
+        {
+            if (!ctrl || !(allTargets || m_behaviorManager->isAffected(*ctrl, changedKeys)))
+                continue;
+
+            const quint32 mask = FlagRuleEngine::correct(rules.rulesForControl(ctrl->type), ctrl->flagsMask);
+            if (mask == ctrl->flagsMask)
+                continue;
+
+            ctrl->flagsMask = mask;
+            m_behaviorManager->updateControlFlags(ctrl, wnd->name);
+            if (wnd->behaviorResolved)
+                ctrl->behavior = m_behaviorManager->resolveBehavior(*ctrl);
+            ++fixed;
+        }
+    }
+
+    return fixed;
+}
+
+// ----------------------------------------------------------
+// Textsprache wechseln
+// ----------------------------------------------------------
+void ProjectController::setTextLanguage(int column)
+{
+    if (!m_textManager || column == m_textManager->currentLanguage())
+        return;
+
+    m_textManager->setCurrentLanguage(column);
+
+    // ConfigManager ist die einzige Quelle der Sprachwahl ("Texts/Language")
+    const QString language = m_textManager->store().language(column);
+    if (!language.isEmpty() && language != m_configManager->textLanguage()) {
+        m_configManager->setTextLanguage(language);
+        if (!m_configFile.isEmpty())
+            m_configManager->save(m_configFile);
+    }
+
+    requestUiRefresh();
+}
+
+// ----------------------------------------------------------
+// Textüberlauf prüfen (alle Sprachen, parallel)
+// ----------------------------------------------------------
+QVector<TextOverflowChecker::Issue> ProjectController::checkTextOverflow()
+{
+    if (!m_textManager || !m_layoutManager)
+        return {};
+
+    if (!m_overflowChecker)
+        m_overflowChecker = std::make_unique<TextOverflowChecker>();
+
+    const auto issues = m_overflowChecker->check(m_layoutManager->processedWindows(), *m_textManager);
+    for (const auto& issue : issues)
+        qWarning().noquote() << QString("[ProjectController] Textüberlauf %1/%2 (%3): %4 px zu breit – %5")
+                                    .arg(issue.window, issue.control, issue.language)
+                                    .arg(issue.overflow())
+                                    .arg(issue.id);
+    return issues;
+}
+
+void ProjectController::applyPendingConfigChanges()
+{
+    if (!m_behaviorManager || !m_layoutManager)
+        return;
+
+    // Während des Ladens sammeln; loadProject() stößt den Timer danach an
+    if (m_loadingActive)
+        return;
+
+    const QSet<QString> pending = m_pendingConfigChanges;
+    m_pendingConfigChanges.clear();
+
+    QSet<QString> changedKeys;     // behavior_config.json
+    QSet<QString> ruleKeys;        // window/control_flag_rules.json
+    bool rulesRecompiled = false;
+    bool groupsChanged = false;
+
+    for (const QString& path : pending)
+    {
+        const QString fileName = QFileInfo(path).fileName();
+        QStringList keys;
+
+        if (fileName.compare("window_flag_rules.json", Qt::CaseInsensitive) == 0)
+            keys = m_behaviorManager->reloadRuleFile(BehaviorManager::RuleFile::WindowRules);
+        else if (fileName.compare("control_flag_rules.json", Qt::CaseInsensitive) == 0)
+            keys = m_behaviorManager->reloadRuleFile(BehaviorManager::RuleFile::ControlRules);
+        else if (fileName.compare("behavior_config.json", Qt::CaseInsensitive) == 0)
+            keys = m_behaviorManager->reloadRuleFile(BehaviorManager::RuleFile::BehaviorConfig);
+        else if (fileName.compare("flag_groups.json", Qt::CaseInsensitive) == 0)
+            keys = m_behaviorManager->reloadRuleFile(BehaviorManager::RuleFile::FlagGroups);
+        else
+            continue;
+
+        const bool isBehavior = fileName.startsWith("behavior_config", Qt::CaseInsensitive);
+        if (!isBehavior)
+            rulesRecompiled = true;
+        if (fileName.startsWith("flag_groups", Qt::CaseInsensitive))
+            groupsChanged = true;
+
+        qInfo().noquote() << "[ProjectController] Hot-Reload:" << fileName
+                          << "→" << keys.size() << "Keys geändert";
+
+        for (const QString& key : keys)
+            (isBehavior ? changedKeys : ruleKeys).insert(key);
+    }
+
+    if (rulesRecompiled) {
+        // Flag-Gruppen gelten für alle Typen → alles neu anwenden
+        const int fixed = reapplyFlagRules(ruleKeys, groupsChanged);
+        const int issues = m_behaviorManager->flagRules()
+                               .validateAll(m_layoutManager->processedWindows());
+        qInfo().noquote() << "[ProjectController] Flag-Regeln angewendet:" << fixed
+                          << "korrigiert," << issues << "Verstöße";
+    }
+
+    if (changedKeys.isEmpty() && !rulesRecompiled)
+        return;
+
+    if (!changedKeys.isEmpty())
+        m_layoutManager->reresolveBehaviors(changedKeys);
+
+    // Canvas + PropertyPanel sofort aktualisieren
+    if (m_renderManager)
+        m_renderManager->refresh();
+    emit uiRefreshRequested();
+}
+
 // --------------------------------------------------
 // Projekt speichern
 // --------------------------------------------------
@@ -277,6 +542,8 @@ bool ProjectController::saveProject()
     // ----------------------------------------------------------
     // 1️⃣ Layout speichern
     // ----------------------------------------------------------
+    m_layoutManager->ensureAllBehaviorsResolved();   // projektweit vollständige Daten
+
     QString layoutContent = m_layoutManager->serializeLayout();
     if (!m_layoutBackend->writeFile(layoutPath, layoutContent)) {
         qWarning() << "[ProjectController] Layout speichern fehlgeschlagen!";
@@ -348,6 +615,8 @@ void ProjectController::selectWindow(const QString& windowName)
     if (!wnd)
         return;
 
+    m_layoutManager->ensureBehaviorResolved(wnd);
+
     m_currentWindow  = wnd;
     m_currentControl = nullptr;     // wenn Fenster gewählt → Control zurücksetzen
 
@@ -379,6 +648,8 @@ void ProjectController::selectControl(const QString& windowName, const QString&
     if (!foundCtrl)
         return;
 
+    m_layoutManager->ensureBehaviorResolved(wnd);
+
     m_currentWindow  = wnd;
     m_currentControl = foundCtrl;
 
@@ -479,7 +750,7 @@ void ProjectController::bindPanels(WindowPanel* windowPanel, PropertyPanel* prop
                     }
 
                     // Konsistent: BehaviorManager darf noch zusätzliche Dinge tun
-                    m_behaviorManager->updateControlFlags(ctrl);
+                    m_behaviorManager->updateControlFlags(ctrl, wnd ? wnd->name : QString());
 
                     qInfo() << "[ProjectController] Control flags aktualisiert für" << ctrl->id;
                 }
@@ -632,6 +903,12 @@ void ProjectController::updateWindowFlags(const QString& windowName, quint32 mas
         wnd->resolvedMask.removeAll(flagName);
     }
 
+    // Exklusiv-Gruppen / Implikationen: neu gesetztes Flag gewinnt
+    const FlagRuleEngine& rules = m_behaviorManager->flagRules();
+    if (enabled && rules.isCompiled())
+        wnd->flagsMask = FlagRuleEngine::correct(rules.rulesForWindow(wnd->name),
+                                                 wnd->flagsMask, mask);
+
     // BehaviorManager aktualisiert ggf. weitere abgeleitete Infos
     m_behaviorManager->updateWindowFlags(wnd);
 
@@ -678,8 +955,15 @@ void ProjectController::updateControlFlags(const QString& controlId, quint32 mas
     else
         ctrl->flagsMask &= ~mask;
 
+    // Exklusiv-Gruppen / Implikationen: neu gesetztes Flag gewinnt
+    const FlagRuleEngine& rules = m_behaviorManager->flagRules();
+    if (enabled && rules.isCompiled())
+        ctrl->flagsMask = FlagRuleEngine::correct(rules.rulesForControl(ctrl->type),
+                                                  ctrl->flagsMask, mask);
+
     // BehaviorManager baut resolvedMask neu auf / ergänzt
-    m_behaviorManager->updateControlFlags(ctrl);
+    const auto wnd = currentWindow();
+    m_behaviorManager->updateControlFlags(ctrl, wnd ? wnd->name : QString());
 
     qInfo().noquote() << QString("[ProjectController] Control '%1' Flags aktualisiert → %2 (%3)")
                              .arg(controlId)
@@ -6,6 +6,7 @@
 #include <QIcon>
 #include <QPixmap>
 #include <QString>
+#include <QSet>
 #include <QDebug>
 
 #include "CanvasHandler.h"
@@ -19,11 +20,16 @@
 #include "define/FlagManager.h"
 #include "text/TextManager.h"
 #include "text/TextBackend.h"
+#include "text/TextOverflowChecker.h"
 #include "layout/LayoutManager.h"
+#include "layout/SourceUsageScanner.h"
 #include "render/RenderManager.h"
 #include "theme/ThemeManager.h"
 #include "behavior/BehaviorManager.h"
 
+class QFileSystemWatcher;
+class QTimer;
+
 class ProjectController : public QObject
 {
     Q_OBJECT
@@ -45,6 +51,7 @@ public:
     BehaviorManager* behaviorManager() const { return m_behaviorManager.get(); }
     RenderManager* renderManager() const { return m_renderManager.get(); }
     ThemeManager* themeManager() const { return m_themeManager.get(); }
+    SourceUsageScanner* sourceUsage() const { return m_sourceUsage.get(); }
 
     std::shared_ptr<WindowData>  currentWindow() const { return m_currentWindow; }
     std::shared_ptr<ControlData> currentControl() const { return m_currentControl; }
@@ -56,6 +63,12 @@ public:
 
     void requestUiRefreshAsync();
 
+    // Textsprache umschalten (nur Spaltenwechsel, kein Reload)
+    void setTextLanguage(int column);
+
+    // Alle Control-Titel in allen Sprachen gegen die Control-Breite prüfen
+    QVector<TextOverflowChecker::Issue> checkTextOverflow();
+
 signals:
     void projectLoaded();
     void projectSaved();
@@ -76,6 +89,8 @@ public slots:
 
 private slots:
     void onTokensReady();
+    void onConfigFileChanged(const QString& path);
+    void applyPendingConfigChanges();
 
 private:
     // 🔧 Manager
@@ -92,6 +107,8 @@ private:
     std::unique_ptr<ThemeManager>  m_themeManager;
     std::unique_ptr<BehaviorManager> m_behaviorManager;
     std::unique_ptr<RenderManager> m_renderManager;
+    std::unique_ptr<SourceUsageScanner> m_sourceUsage;
+    std::unique_ptr<TextOverflowChecker> m_overflowChecker;   // behält die Breitentabelle
 
 
     // 🔧 Ressourcen
@@ -103,7 +120,16 @@ private:
     std::shared_ptr<WindowData> findWindow(const QString& name) const;
     std::shared_ptr<ControlData> findControl(const QString& id) const;
 
+    QString m_configFile;   // geladene config.ini (Sprachwahl wird dort gespeichert)
+
     bool m_loadingActive = false;
     bool m_tokensReady = false;
+
+    // 🔧 Hot-Reload: Regel-/Behavior-Dateien im Config-Ordner beobachten
+    void setupConfigWatcher();
+    int reapplyFlagRules(const QSet<QString>& changedKeys, bool allTargets);
+    QFileSystemWatcher* m_configWatcher = nullptr;
+    QTimer* m_configReloadTimer = nullptr;
+    QSet<QString> m_pendingConfigChanges;
 };
 
@@ -0,0 +1,197 @@
+#pragma once
+
+#include <QtGlobal>
+#include <algorithm>
+#include <array>
+#include <string_view>
+
+// ------------------------------------------------------------
+// Eingebaute Standard-Flags (zur Compile-Zeit sortiert)
+// ------------------------------------------------------------
+// Ersetzt die früheren QMap-Listen in FlagManager::applyDefault*.
+// Die Tabelle liegt fertig sortiert im Binary; Nachschlagen ist
+// eine Binärsuche ohne Heap und ohne Datei-I/O. Damit kann der
+// Editor auch ohne Source-Ordner (Artists, CI) mit Flags starten.
+// Aus Headern gescannte Werte haben weiterhin Vorrang.
+// ------------------------------------------------------------
+enum class FlagClass : quint8
+{
+    Window,         // WBS_* (High-Word)
+    LegacyWindow,   // alte WBS_* – nur Legacy-Tabelle bzw. Override
+    Control,        // BS_/ES_/SS_/LBS_* (Low-Word)
+    WindowType      // WTYPE_*
+};
+
+struct DefaultFlag
+{
+    std::string_view name;
+    quint32          value;
+    FlagClass        cls;
+};
+
+namespace DefaultFlags {
+
+namespace detail {
+
+template <std::size_t N>
+constexpr std::array<DefaultFlag, N> sortedByName(std::array<DefaultFlag, N> flags)
+{
+    std::sort(flags.begin(), flags.end(),
+              [](const DefaultFlag& a, const DefaultFlag& b) { return a.name < b.name; });
+    return flags;
+}
+
+template <std::size_t N>
+constexpr bool uniqueNames(const std::array<DefaultFlag, N>& flags)
+{
+    for (std::size_t i = 1; i < N; ++i)
+        if (!(flags[i - 1].name < flags[i].name))
+            return false;
+    return true;
+}
+
+} // namespace detail
+
+inline constexpr auto table = detail::sortedByName(std::array{
+    // 🪟 Window-Flags
+    DefaultFlag{ "WBS_CAPTION",        0x02000000, FlagClass::Window },
+    DefaultFlag{ "WBS_CHILD",          0x00020000, FlagClass::Window },
+    DefaultFlag{ "WBS_CHILDFRAME",     0x00800000, FlagClass::Window },
+    DefaultFlag{ "WBS_DOCKING",        0x04000000, FlagClass::Window },
+    DefaultFlag{ "WBS_EXTENSION",      0x00000020, FlagClass::Window },
+    DefaultFlag{ "WBS_HELP",           0x00000004, FlagClass::Window },
+    DefaultFlag{ "WBS_MOVE",           0x00010000, FlagClass::Window },
+    DefaultFlag{ "WBS_MODAL",          0x00080000, FlagClass::Window },
+    DefaultFlag{ "WBS_NOFOCUS",        0x80000000, FlagClass::Window },
+    DefaultFlag{ "WBS_NOFRAME",        0x00200000, FlagClass::Window },
+    DefaultFlag{ "WBS_NODRAWFRAME",    0x00040000, FlagClass::Window },
+    DefaultFlag{ "WBS_TOPMOST",        0x10000000, FlagClass::Window },
+    DefaultFlag{ "WBS_RESIZEABLE",     0x00000040, FlagClass::Window },
+    DefaultFlag{ "WBS_THICKFRAME",     0x00000040, FlagClass::Window },
+    DefaultFlag{ "WBS_POPUP",          0x08000000, FlagClass::Window },
+    DefaultFlag{ "WBS_VSCROLL",        0x20000000, FlagClass::Window },
+    DefaultFlag{ "WBS_HSCROLL",        0x40000000, FlagClass::Window },
+    DefaultFlag{ "WBS_VIEW",           0x00000008, FlagClass::Window },
+    DefaultFlag{ "WBS_PIN",            0x00000010, FlagClass::Window },
+    DefaultFlag{ "WBS_MANAGER",        0x00100000, FlagClass::Window },
+    DefaultFlag{ "WBS_KEY",            0x01000000, FlagClass::Window },
+    DefaultFlag{ "WBS_SOUND",          0x00400000, FlagClass::Window },
+    DefaultFlag{ "WBS_NOMENUICON",     0x00000400, FlagClass::Window },
+    DefaultFlag{ "WBS_OVERRIDE_FIRST", 0x00000040, FlagClass::Window },
+    DefaultFlag{ "WBS_NOCENTER",       0x00000080, FlagClass::Window },
+    DefaultFlag{ "WBS_MAXIMIZEBOX",    0x00000002, FlagClass::Window },
+    DefaultFlag{ "WBS_MINIMIZEBOX",    0x00000001, FlagClass::Window },
+
+    // 🕰️ Legacy-Window-Flags
+    DefaultFlag{ "WBS_CHECK",          0x00000008, FlagClass::LegacyWindow },
+    DefaultFlag{ "WBS_PUSHLIKE",       0x00000200, FlagClass::LegacyWindow },
+    DefaultFlag{ "WBS_RADIO",          0x00000004, FlagClass::LegacyWindow },
+    DefaultFlag{ "WBS_MONEY",          0x00000004, FlagClass::LegacyWindow },
+    DefaultFlag{ "WBS_TEXT",           0x00000001, FlagClass::LegacyWindow },
+    DefaultFlag{ "WBS_SPRITE",         0x00000002, FlagClass::LegacyWindow },
+    DefaultFlag{ "WBS_MENUITEM",       0x00000100, FlagClass::LegacyWindow },
+    DefaultFlag{ "WBS_HIGHLIGHT",      0x00000010, FlagClass::LegacyWindow },
+    DefaultFlag{ "WBS_HIGHLIGHTPUSH",  0x00000020, FlagClass::LegacyWindow },
+    DefaultFlag{ "WBS_NOCLOSE",        0x00000080, FlagClass::LegacyWindow },
+
+    // 🟦 Button Styles (BS_*)
+    DefaultFlag{ "BS_PUSHBUTTON",      0x00000000, FlagClass::Control },
+    DefaultFlag{ "BS_DEFPUSHBUTTON",   0x00000001, FlagClass::Control },
+    DefaultFlag{ "BS_CHECKBOX",        0x00000002, FlagClass::Control },
+    DefaultFlag{ "BS_AUTOCHECKBOX",    0x00000003, FlagClass::Control },
+    DefaultFlag{ "BS_RADIOBUTTON",     0x00000004, FlagClass::Control },
+    DefaultFlag{ "BS_3STATE",          0x00000005, FlagClass::Control },
+    DefaultFlag{ "BS_AUTO3STATE",      0x00000006, FlagClass::Control },
+    DefaultFlag{ "BS_GROUPBOX",        0x00000007, FlagClass::Control },
+    DefaultFlag{ "BS_AUTORADIOBUTTON", 0x00000009, FlagClass::Control },
+    DefaultFlag{ "BS_ICON",            0x00000040, FlagClass::Control },
+    DefaultFlag{ "BS_BITMAP",          0x00000080, FlagClass::Control },
+    DefaultFlag{ "BS_LEFT",            0x00000100, FlagClass::Control },
+    DefaultFlag{ "BS_RIGHT",           0x00000200, FlagClass::Control },
+    DefaultFlag{ "BS_TOP",             0x00000400, FlagClass::Control },
+    DefaultFlag{ "BS_BOTTOM",          0x00000800, FlagClass::Control },
+    DefaultFlag{ "BS_VCENTER",         0x00000C00, FlagClass::Control },
+
+    // 🟩 Edit Styles (ES_*)
+    DefaultFlag{ "ES_LEFT",            0x0000, FlagClass::Control },
+    DefaultFlag{ "ES_CENTER",          0x0001, FlagClass::Control },
+    DefaultFlag{ "ES_RIGHT",           0x0002, FlagClass::Control },
+    DefaultFlag{ "ES_MULTILINE",       0x0004, FlagClass::Control },
+    DefaultFlag{ "ES_PASSWORD",        0x0020, FlagClass::Control },
+    DefaultFlag{ "ES_AUTOVSCROLL",     0x0040, FlagClass::Control },
+    DefaultFlag{ "ES_AUTOHSCROLL",     0x0080, FlagClass::Control },
+    DefaultFlag{ "ES_NOHIDESEL",       0x0100, FlagClass::Control },
+    DefaultFlag{ "ES_OEMCONVERT",      0x0400, FlagClass::Control },
+    DefaultFlag{ "ES_READONLY",        0x0800, FlagClass::Control },
+    DefaultFlag{ "ES_WANTRETURN",      0x1000, FlagClass::Control },
+    DefaultFlag{ "ES_NUMBER",          0x2000, FlagClass::Control },
+
+    // 🟨 Static Styles (SS_*)
+    DefaultFlag{ "SS_LEFT",            0x00000000, FlagClass::Control },
+    DefaultFlag{ "SS_CENTER",          0x00000001, FlagClass::Control },
+    DefaultFlag{ "SS_RIGHT",           0x00000002, FlagClass::Control },
+    DefaultFlag{ "SS_ICON",            0x00000003, FlagClass::Control },
+    DefaultFlag{ "SS_BITMAP",          0x0000000E, FlagClass::Control },
+    DefaultFlag{ "SS_NOTIFY",          0x00000100, FlagClass::Control },
+
+    // 🟥 ListBox Styles (LBS_*)
+    DefaultFlag{ "LBS_NOTIFY",            0x0001, FlagClass::Control },
+    DefaultFlag{ "LBS_SORT",              0x0002, FlagClass::Control },
+    DefaultFlag{ "LBS_NOREDRAW",          0x0004, FlagClass::Control },
+    DefaultFlag{ "LBS_MULTIPLESEL",       0x0008, FlagClass::Control },
+    DefaultFlag{ "LBS_OWNERDRAWFIXED",    0x0010, FlagClass::Control },
+    DefaultFlag{ "LBS_OWNERDRAWVARIABLE", 0x0020, FlagClass::Control },
+    DefaultFlag{ "LBS_HASSTRINGS",        0x0040, FlagClass::Control },
+    DefaultFlag{ "LBS_USETABSTOPS",       0x0080, FlagClass::Control },
+    DefaultFlag{ "LBS_NOINTEGRALHEIGHT",  0x0100, FlagClass::Control },
+    DefaultFlag{ "LBS_MULTICOLUMN",       0x0200, FlagClass::Control },
+    DefaultFlag{ "LBS_WANTKEYBOARDINPUT", 0x0400, FlagClass::Control },
+    DefaultFlag{ "LBS_EXTENDEDSEL",       0x0800, FlagClass::Control },
+    DefaultFlag{ "LBS_DISABLENOSCROLL",   0x1000, FlagClass::Control },
+
+    // 🧩 Window Types (WTYPE_*)
+    DefaultFlag{ "WTYPE_NONE",         0x00000000, FlagClass::WindowType },
+    DefaultFlag{ "WTYPE_BASE",         0x00000001, FlagClass::WindowType },
+    DefaultFlag{ "WTYPE_STATIC",       0x00000002, FlagClass::WindowType },
+    DefaultFlag{ "WTYPE_BUTTON",       0x00000003, FlagClass::WindowType },
+    DefaultFlag{ "WTYPE_EDIT",         0x00000004, FlagClass::WindowType },
+    DefaultFlag{ "WTYPE_SCROLLBAR",    0x00000005, FlagClass::WindowType },
+    DefaultFlag{ "WTYPE_LISTBOX",      0x00000006, FlagClass::WindowType },
+    DefaultFlag{ "WTYPE_CUSTOM",       0x00000007, FlagClass::WindowType }
+});
+
+static_assert(detail::uniqueNames(table), "Doppelter Name in DefaultFlags::table");
+
+// Binärsuche über die sortierte Tabelle (nullptr = unbekannt)
+constexpr const DefaultFlag* find(std::string_view name)
+{
+    const auto it = std::lower_bound(table.begin(), table.end(), name,
+                                     [](const DefaultFlag& f, std::string_view n) { return f.name < n; });
+    return (it != table.end() && it->name == name) ? &*it : nullptr;
+}
+
+static_assert(find("WBS_CHILD") && find("WBS_CHILD")->value == 0x00020000);
+static_assert(find("BS_AUTOCHECKBOX") && find("BS_AUTOCHECKBOX")->cls == FlagClass::Control);
+
+// Legacy-Flags, die zusätzlich in der aktiven Window-Tabelle stehen;
+// alle übrigen LegacyWindow-Einträge gehören nur in die Legacy-Tabelle
+// (ihre Werte überschneiden sich mit aktuellen WBS_*-Flags)
+inline constexpr std::array<std::string_view, 1> legacyOverrides{ "WBS_NOCLOSE" };
+
+constexpr bool isLegacyOverride(std::string_view name)
+{
+    return std::find(legacyOverrides.begin(), legacyOverrides.end(), name) != legacyOverrides.end();
+}
+
+static_assert(isLegacyOverride("WBS_NOCLOSE") && !isLegacyOverride("WBS_TEXT"));
+
+// Alle Einträge einer Klasse (in Namensreihenfolge)
+template <typename Fn>
+void forEach(FlagClass cls, Fn&& fn)
+{
+    for (const DefaultFlag& f : table)
+        if (f.cls == cls)
+            fn(f);
+}
+
+} // namespace DefaultFlags
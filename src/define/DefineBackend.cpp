@@ -3,9 +3,27 @@
 #include "EncodingUtils.h"
 #include "DefineManager.h"
 #include <QDebug>
+#include <QSaveFile>
+#include <QTextStream>
 
 bool DefineBackend::load(const QString& path, DefineManager& mgr)
 {
+    // Kodierung, BOM und Zeilenende aus den Rohbytes (Text-Modus
+    // würde "\r\n" unter Windows bereits umwandeln)
+    QFile raw(path);
+    if (raw.open(QIODevice::ReadOnly)) {
+        const QByteArray head = raw.read(4096);
+        if (head.startsWith("\xFF\xFE"))
+            m_encoding = QStringConverter::Utf16LE;
+        else if (head.startsWith("\xFE\xFF"))
+            m_encoding = QStringConverter::Utf16BE;
+        else
+            m_encoding = QStringConverter::Utf8;
+
+        m_bom  = m_encoding != QStringConverter::Utf8 || head.startsWith("\xEF\xBB\xBF");
+        m_crlf = head.contains("\r\n") || head.contains(QByteArray("\r\0\n", 3));
+    }
+
     QFile file;
     QTextStream in;
     if (!EncodingUtils::openTextStream(file, in, path)) {
@@ -13,34 +31,58 @@ bool DefineBackend::load(const QString& path, DefineManager& mgr)
         return false;
     }
 
-    // Lies jede Zeile und gib sie dem Manager zur Auswertung
-    mgr.clear();
+    // Alle Zeilen lesen – der Manager indiziert die Defines und
+    // behält den Originaltext für den Patch-Save
+    QStringList lines;
+    while (!in.atEnd())
+        lines << in.readLine();
 
-    while (!in.atEnd()) {
-        const QString line = in.readLine();
-        mgr.processDefineLine(line);
-    }
+    mgr.loadSource(lines);
 
     qInfo() << "[DefineBackend] Datei geladen:" << path;
     return true;
 }
 
-bool DefineBackend::saveDefines(const QString& path, const DefineManager& mgr) const
+bool DefineBackend::saveDefines(const QString& path, DefineManager& mgr) const
 {
-    QFile file(path);
-    if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+    // Nichts geändert → Datei unangetastet lassen
+    if (mgr.modifiedCount() == 0 && !mgr.sourceLines().isEmpty()) {
+        qInfo() << "[DefineBackend] Keine Änderungen – überspringe:" << path;
+        return true;
+    }
+
+    QStringList lines;
+    if (!mgr.sourceLines().isEmpty()) {
+        lines = mgr.patchedSource();
+    } else {
+        // Keine Quelldatei geladen → vollständige Liste schreiben
+        for (const Token& t : mgr.exportToTokens())
+            lines << t.value;
+    }
+
+    // Binär schreiben – Zeilenende kommt aus der geladenen Datei
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly)) {
         qWarning() << "[DefineBackend] Konnte Datei nicht öffnen zum Schreiben:" << path;
         return false;
     }
 
+    const char* eol = m_crlf ? "\r\n" : "\n";
     QTextStream out(&file);
-    out.setEncoding(QStringConverter::Utf8);
+    out.setEncoding(m_encoding);
+    out.setGenerateByteOrderMark(m_bom);
+    for (const QString& line : lines)
+        out << line << eol;
+    out.flush();
+
+    if (!file.commit()) {
+        qWarning() << "[DefineBackend] Schreiben fehlgeschlagen:" << path;
+        return false;
+    }
 
-    const auto& defines = mgr.allDefines();
-    for (auto it = defines.cbegin(); it != defines.cend(); ++it)
-        out << "#define " << it.key() << " 0x"
-            << QString::number(it.value(), 16).toUpper() << "\n";
+    const int changed = mgr.modifiedCount();
+    mgr.markSaved(lines);
 
-    qInfo() << "[DefineBackend] Datei gespeichert:" << path;
+    qInfo() << "[DefineBackend] Datei gespeichert:" << path << "(" << changed << "Defines geändert)";
     return true;
 }
@@ -1,11 +1,19 @@
 #pragma once
 #include "DefineManager.h"
 #include <QString>
+#include <QStringConverter>
 
 class DefineManager;
 class DefineBackend {
 public:
     DefineBackend() = default;
     bool load(const QString& path, DefineManager& mgr);
-    bool saveDefines(const QString& path, const DefineManager& mgr) const;
+    bool saveDefines(const QString& path, DefineManager& mgr) const;
+
+private:
+    // Format der geladenen Datei – beim Speichern unverändert übernehmen
+    // (wie TextTable/TextStore: Kodierung, BOM, Zeilenende)
+    QStringConverter::Encoding m_encoding = QStringConverter::Utf8;
+    bool m_bom  = false;
+    bool m_crlf = false;
 };
@@ -0,0 +1,531 @@
+#include "DefineEvaluator.h"
+
+#include <QSet>
+#include <QDebug>
+#include <limits>
+
+namespace {
+
+inline bool isIdentStart(QChar c) { return c.isLetter() || c == QLatin1Char('_'); }
+inline bool isIdentChar(QChar c)  { return c.isLetterOrNumber() || c == QLatin1Char('_'); }
+
+// Typnamen, die in Casts vorkommen – "(DWORD)0x10", "(unsigned long)1"
+const QSet<QString>& castTypeNames()
+{
+    static const QSet<QString> names = {
+        "DWORD", "UINT", "INT", "LONG", "ULONG", "WORD", "BYTE", "BOOL",
+        "DWORD_PTR", "UINT_PTR", "LONG_PTR", "ULONG_PTR", "SIZE_T",
+        "int", "unsigned", "signed", "long", "short", "char",
+        "u_int", "u_long", "u_short", "u_char",
+        "int8_t", "int16_t", "int32_t", "int64_t",
+        "uint8_t", "uint16_t", "uint32_t", "uint64_t", "size_t"
+    };
+    return names;
+}
+
+// ------------------------------------------------------------
+// 64-Bit-Arithmetik mit Überlaufprüfung – ein Überlauf ist bei
+// signed UB, daher vorher prüfen und als Fehler melden
+// ------------------------------------------------------------
+constexpr qint64 Int64Min = std::numeric_limits<qint64>::min();
+
+inline bool checkedAdd(qint64 a, qint64 b, qint64& out)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return !__builtin_add_overflow(a, b, &out);
+#else
+    if ((b > 0 && a > std::numeric_limits<qint64>::max() - b) || (b < 0 && a < Int64Min - b))
+        return false;
+    out = a + b;
+    return true;
+#endif
+}
+
+inline bool checkedSub(qint64 a, qint64 b, qint64& out)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return !__builtin_sub_overflow(a, b, &out);
+#else
+    if ((b < 0 && a > std::numeric_limits<qint64>::max() + b) || (b > 0 && a < Int64Min + b))
+        return false;
+    out = a - b;
+    return true;
+#endif
+}
+
+inline bool checkedMul(qint64 a, qint64 b, qint64& out)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return !__builtin_mul_overflow(a, b, &out);
+#else
+    if (a == -1 || b == -1) {
+        if (a == Int64Min || b == Int64Min)
+            return false;
+        out = (a == -1 ? -b : -a);
+        return true;
+    }
+    const qint64 r = qint64(quint64(a) * quint64(b));     // unsigned: definiert
+    if (a != 0 && r / a != b)
+        return false;
+    out = r;
+    return true;
+#endif
+}
+
+}
+
+// =============================================================
+// Rekursiver Abstieg nach C-Präzedenz
+// =============================================================
+class DefineEvaluator::Parser
+{
+public:
+    Parser(DefineEvaluator& owner, const QString& text)
+        : m_owner(owner), m_s(text) {}
+
+    std::optional<qint64> run()
+    {
+        const auto v = conditional();
+        skipBlanks();
+        if (!v || m_pos < m_s.size()) {
+            if (m_error.isEmpty())
+                m_error = QString("Unerwartetes Zeichen an Position %1").arg(m_pos);
+            return std::nullopt;
+        }
+        return v;
+    }
+
+    const QString& error() const { return m_error; }
+
+private:
+    using Value = std::optional<qint64>;
+
+    // ---------------------------------------------------------
+    // Lexer-Helfer
+    // ---------------------------------------------------------
+    void skipBlanks()
+    {
+        while (m_pos < m_s.size() && m_s[m_pos].isSpace())
+            ++m_pos;
+    }
+
+    QChar peek(int ahead = 0) const
+    {
+        const int i = m_pos + ahead;
+        return i < m_s.size() ? m_s[i] : QChar();
+    }
+
+    // Operator aus ein oder zwei Zeichen; verhindert "<" bei "<<" usw.
+    bool accept(const char* op)
+    {
+        skipBlanks();
+        const int len = int(qstrlen(op));
+        for (int i = 0; i < len; ++i)
+            if (peek(i) != QLatin1Char(op[i]))
+                return false;
+
+        if (len == 1) {
+            const QChar next = peek(1);
+            const QChar c = QLatin1Char(op[0]);
+            if ((c == '<' || c == '>') && (next == c || next == '='))  return false;
+            if ((c == '&' || c == '|') && next == c)                   return false;
+            if ((c == '!' || c == '=') && next == '=')                 return false;
+        }
+        m_pos += len;
+        return true;
+    }
+
+    QString identifierAt(int& pos) const
+    {
+        const int start = pos;
+        if (pos < m_s.size() && isIdentStart(m_s[pos])) {
+            while (pos < m_s.size() && isIdentChar(m_s[pos]))
+                ++pos;
+        }
+        return m_s.mid(start, pos - start);
+    }
+
+    Value fail(const QString& message)
+    {
+        if (m_error.isEmpty())
+            m_error = message;
+        return std::nullopt;
+    }
+
+    // ---------------------------------------------------------
+    // Grammatik
+    // ---------------------------------------------------------
+    Value conditional()
+    {
+        const Value cond = logicalOr();
+        if (!cond)
+            return cond;
+        if (!accept("?"))
+            return cond;
+
+        const Value a = conditional();
+        if (!a || !accept(":"))
+            return fail("':' erwartet");
+        const Value b = conditional();
+        if (!b)
+            return b;
+        return *cond ? a : b;
+    }
+
+    Value logicalOr()
+    {
+        Value l = logicalAnd();
+        while (l && accept("||")) {
+            const Value r = logicalAnd();
+            if (!r) return r;
+            l = qint64((*l != 0) || (*r != 0));
+        }
+        return l;
+    }
+
+    Value logicalAnd()
+    {
+        Value l = bitOr();
+        while (l && accept("&&")) {
+            const Value r = bitOr();
+            if (!r) return r;
+            l = qint64((*l != 0) && (*r != 0));
+        }
+        return l;
+    }
+
+    Value bitOr()
+    {
+        Value l = bitXor();
+        while (l && accept("|")) {
+            const Value r = bitXor();
+            if (!r) return r;
+            l = *l | *r;
+        }
+        return l;
+    }
+
+    Value bitXor()
+    {
+        Value l = bitAnd();
+        while (l && accept("^")) {
+            const Value r = bitAnd();
+            if (!r) return r;
+            l = *l ^ *r;
+        }
+        return l;
+    }
+
+    Value bitAnd()
+    {
+        Value l = equality();
+        while (l && accept("&")) {
+            const Value r = equality();
+            if (!r) return r;
+            l = *l & *r;
+        }
+        return l;
+    }
+
+    Value equality()
+    {
+        Value l = relational();
+        while (l) {
+            if (accept("==")) {
+                const Value r = relational();
+                if (!r) return r;
+                l = qint64(*l == *r);
+            } else if (accept("!=")) {
+                const Value r = relational();
+                if (!r) return r;
+                l = qint64(*l != *r);
+            } else break;
+        }
+        return l;
+    }
+
+    Value relational()
+    {
+        Value l = shift();
+        while (l) {
+            if (accept("<=")) {
+                const Value r = shift(); if (!r) return r; l = qint64(*l <= *r);
+            } else if (accept(">=")) {
+                const Value r = shift(); if (!r) return r; l = qint64(*l >= *r);
+            } else if (accept("<")) {
+                const Value r = shift(); if (!r) return r; l = qint64(*l < *r);
+            } else if (accept(">")) {
+                const Value r = shift(); if (!r) return r; l = qint64(*l > *r);
+            } else break;
+        }
+        return l;
+    }
+
+    Value shift()
+    {
+        Value l = additive();
+        while (l) {
+            const bool left = accept("<<");
+            if (!left && !accept(">>"))
+                break;
+            const Value r = additive();
+            if (!r) return r;
+            if (*r < 0 || *r > 63)
+                return fail(QString("Ungültige Shift-Weite %1").arg(*r));
+            l = left ? qint64(quint64(*l) << *r) : (*l >> *r);
+        }
+        return l;
+    }
+
+    Value additive()
+    {
+        Value l = multiplicative();
+        while (l) {
+            const bool add = accept("+");
+            if (!add && !accept("-"))
+                break;
+
+            const Value r = multiplicative();
+            if (!r) return r;
+            qint64 v = 0;
+            if (!(add ? checkedAdd(*l, *r, v) : checkedSub(*l, *r, v)))
+                return fail(QString("Überlauf bei %1 %2 %3").arg(*l).arg(add ? '+' : '-').arg(*r));
+            l = v;
+        }
+        return l;
+    }
+
+    Value multiplicative()
+    {
+        Value l = unary();
+        while (l) {
+            const bool mul = accept("*");
+            const bool div = !mul && accept("/");
+            const bool mod = !mul && !div && accept("%");
+            if (!mul && !div && !mod)
+                break;
+
+            const Value r = unary();
+            if (!r) return r;
+            if ((div || mod) && *r == 0)
+                return fail("Division durch 0");
+
+            qint64 v = 0;
+            if (mul) {
+                if (!checkedMul(*l, *r, v))
+                    return fail(QString("Überlauf bei %1 * %2").arg(*l).arg(*r));
+            } else if (*l == Int64Min && *r == -1) {
+                // Quotient nicht darstellbar (auch % ist dann UB)
+                return fail(QString("Überlauf bei %1 %2 -1").arg(*l).arg(div ? '/' : '%'));
+            } else {
+                v = div ? *l / *r : *l % *r;
+            }
+            l = v;
+        }
+        return l;
+    }
+
+    Value unary()
+    {
+        if (accept("+")) return unary();
+        if (accept("-")) {
+            const Value v = unary();
+            if (v && *v == Int64Min)
+                return fail(QString("Überlauf bei -(%1)").arg(*v));
+            return v ? Value(-*v) : v;
+        }
+        if (accept("~")) { const Value v = unary(); return v ? Value(~*v) : v; }
+        if (accept("!")) { const Value v = unary(); return v ? Value(qint64(*v == 0)) : v; }
+
+        if (tryCast())
+            return unary();
+
+        return primary();
+    }
+
+    // "(TYPE)" bzw. "(unsigned long)" vor einem Operanden überspringen
+    bool tryCast()
+    {
+        skipBlanks();
+        if (peek() != QLatin1Char('('))
+            return false;
+
+        int pos = m_pos + 1;
+        int words = 0;
+        while (true) {
+            while (pos < m_s.size() && m_s[pos].isSpace()) ++pos;
+            const QString word = identifierAt(pos);
+            if (word.isEmpty())
+                break;
+            if (!castTypeNames().contains(word))
+                return false;
+            ++words;
+        }
+        while (pos < m_s.size() && m_s[pos] == QLatin1Char('*')) ++pos;   // Zeiger-Casts
+        while (pos < m_s.size() && m_s[pos].isSpace()) ++pos;
+
+        if (words == 0 || pos >= m_s.size() || m_s[pos] != QLatin1Char(')'))
+            return false;
+
+        m_pos = pos + 1;
+        return true;
+    }
+
+    Value primary()
+    {
+        skipBlanks();
+
+        if (accept("(")) {
+            const Value v = conditional();
+            if (!v) return v;
+            if (!accept(")"))
+                return fail("')' erwartet");
+            return v;
+        }
+
+        const QChar c = peek();
+        if (c.isDigit())
+            return number();
+
+        if (isIdentStart(c)) {
+            int pos = m_pos;
+            const QString name = identifierAt(pos);
+            m_pos = pos;
+
+            // defined(X) / defined X – wie im Präprozessor
+            if (name == QLatin1String("defined")) {
+                const bool paren = accept("(");
+                skipBlanks();
+                int p = m_pos;
+                const QString sym = identifierAt(p);
+                m_pos = p;
+                if (sym.isEmpty() || (paren && !accept(")")))
+                    return fail("defined(): Name erwartet");
+                return qint64(m_owner.contains(sym));
+            }
+
+            const Value v = m_owner.resolve(name);
+            if (!v)
+                return fail(QString("Unbekanntes oder zyklisches Symbol '%1'").arg(name));
+            return v;
+        }
+
+        return fail(QString("Operand erwartet an Position %1").arg(m_pos));
+    }
+
+    Value number()
+    {
+        int base = 10;
+        int start = m_pos;
+
+        if (peek() == QLatin1Char('0') && (peek(1) == 'x' || peek(1) == 'X')) {
+            base = 16; start += 2;
+        } else if (peek() == QLatin1Char('0') && (peek(1) == 'b' || peek(1) == 'B')) {
+            base = 2; start += 2;
+        } else if (peek() == QLatin1Char('0') && peek(1).isDigit()) {
+            base = 8; start += 1;
+        }
+
+        int end = start;
+        while (end < m_s.size() && m_s[end].isLetterOrNumber())
+            ++end;
+
+        // Suffixe u/U/l/L (beliebig kombiniert) abschneiden
+        int digitsEnd = end;
+        while (digitsEnd > start && QStringLiteral("uUlL").contains(m_s[digitsEnd - 1]))
+            --digitsEnd;
+
+        bool ok = false;
+        const quint64 v = m_s.mid(start, digitsEnd - start).toULongLong(&ok, base);
+        if (!ok)
+            return fail(QString("Ungültiges Literal '%1'").arg(m_s.mid(m_pos, end - m_pos)));
+        m_pos = end;
+        return qint64(v);
+    }
+
+private:
+    DefineEvaluator& m_owner;
+    const QString&   m_s;
+    int              m_pos = 0;
+    QString          m_error;
+};
+
+// =============================================================
+// DefineEvaluator
+// =============================================================
+DefineEvaluator::DefineEvaluator(const QVector<HeaderDefine>& defines)
+{
+    addDefines(defines);
+}
+
+void DefineEvaluator::addDefines(const QVector<HeaderDefine>& defines)
+{
+    m_symbols.reserve(m_symbols.size() + defines.size());
+    for (const HeaderDefine& d : defines)
+        m_symbols.insert(d.name, Symbol{ d.value });
+
+    // Neue Definitionen können bereits aufgelöste Werte ändern
+    for (Symbol& s : m_symbols)
+        s.state = State::Pending;
+    m_cycles = 0;
+}
+
+void DefineEvaluator::clear()
+{
+    m_symbols.clear();
+    m_cycles = 0;
+}
+
+std::optional<qint64> DefineEvaluator::resolve(const QString& name)
+{
+    auto it = m_symbols.find(name);
+    if (it == m_symbols.end())
+        return std::nullopt;
+
+    switch (it->state) {
+    case State::Resolved:  return it->value;
+    case State::Failed:    return std::nullopt;
+    case State::Resolving:
+        // Zyklus: Symbol verweist (indirekt) auf sich selbst
+        ++m_cycles;
+        qWarning().noquote() << "[DefineEvaluator] Zyklischer Verweis:" << name;
+        it->state = State::Failed;
+        return std::nullopt;
+    case State::Pending:
+        break;
+    }
+
+    it->state = State::Resolving;
+    const QString expression = it->expression;
+
+    Parser parser(*this, expression);
+    const std::optional<qint64> v = parser.run();
+
+    // Rekursion fügt nichts ein – Eintrag trotzdem frisch nachschlagen
+    Symbol& sym = m_symbols[name];
+    if (sym.state == State::Failed)              // im Zyklus bereits verworfen
+        return std::nullopt;
+
+    sym.state = v ? State::Resolved : State::Failed;
+    sym.value = v.value_or(0);
+    return v;
+}
+
+std::optional<quint32> DefineEvaluator::value(const QString& name)
+{
+    const std::optional<qint64> v = resolve(name);
+    if (!v)
+        return std::nullopt;
+    return quint32(*v);
+}
+
+std::optional<quint32> DefineEvaluator::evaluate(const QString& expression, QString* error)
+{
+    Parser parser(*this, expression);
+    const std::optional<qint64> v = parser.run();
+    if (!v) {
+        if (error) *error = parser.error();
+        return std::nullopt;
+    }
+    return quint32(*v);
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include "HeaderScanner.h"
+
+#include <QHash>
+#include <QString>
+#include <QVector>
+#include <optional>
+
+// ------------------------------------------------------------
+// DefineEvaluator
+// ------------------------------------------------------------
+// Wertet #define-Werte als C-Konstantenausdrücke aus:
+//  - Literale (dez/hex/oktal/binär) inkl. Suffixe u/l/ul/ull
+//  - Klammern, Casts wie (DWORD) / (unsigned long)
+//  - unär + - ~ !, * / %, + -, << >>, Vergleiche, & ^ |, && ||, ?:
+//  - Verweise auf andere Defines (z. B. (WBS_CHILD | WBS_VISIBLE))
+//
+// Die Symboltabelle wird einmal aus allen gescannten Headern
+// aufgebaut. Aufgelöste Werte werden gemerkt, zyklische Verweise
+// (A → B → A) erkannt und als Fehler markiert.
+// ------------------------------------------------------------
+class DefineEvaluator
+{
+public:
+    DefineEvaluator() = default;
+    explicit DefineEvaluator(const QVector<HeaderDefine>& defines);
+
+    // Spätere Definitionen überschreiben frühere (wie bisher beim Scan)
+    void addDefines(const QVector<HeaderDefine>& defines);
+    void clear();
+
+    // Wert eines Defines (gemerkt); std::nullopt bei Fehler / Zyklus / unbekannt
+    std::optional<quint32> value(const QString& name);
+
+    // Freien Ausdruck auswerten (Verweise über die Symboltabelle)
+    std::optional<quint32> evaluate(const QString& expression, QString* error = nullptr);
+
+    bool contains(const QString& name) const { return m_symbols.contains(name); }
+    int  cycleCount() const { return m_cycles; }
+
+private:
+    enum class State : quint8 { Pending, Resolving, Resolved, Failed };
+
+    struct Symbol {
+        QString expression;
+        State   state = State::Pending;
+        qint64  value = 0;
+    };
+
+    class Parser;
+
+    std::optional<qint64> resolve(const QString& name);
+
+    QHash<QString, Symbol> m_symbols;
+    int m_cycles = 0;
+};
@@ -3,8 +3,12 @@
 #include "WindowData.h"
 #include "ControlData.h"
 
-#include <QRegularExpression>
 #include <QDebug>
+#include <QElapsedTimer>
+#include <QtConcurrent/QtConcurrent>
+
+#include <algorithm>
+#include <atomic>
 
 DefineManager::DefineManager(QObject* parent)
     : BaseManager(parent)
@@ -12,53 +16,350 @@ DefineManager::DefineManager(QObject* parent)
     qInfo() << "[DefineManager] Initialisiert.";
 }
 
+namespace {
+inline bool isWindowDefine(const QString& name)
+{
+    return name.startsWith("APP_") || name.startsWith("WND_", Qt::CaseInsensitive);
+}
+
+// Grenzen des Werte-Tokens in einer "#define NAME VALUE"-Zeile
+bool valueSpan(const QString& line, int& begin, int& end)
+{
+    int i = line.indexOf(QLatin1String("define"));
+    if (i < 0)
+        return false;
+    i += 6;
+
+    auto skipSpace = [&](int p) { while (p < line.size() && line[p].isSpace()) ++p; return p; };
+    auto skipToken = [&](int p) { while (p < line.size() && !line[p].isSpace()) ++p; return p; };
+
+    i = skipToken(skipSpace(i));                 // NAME
+    begin = skipSpace(i);
+    end = begin;
+    while (end < line.size() && !line[end].isSpace() && line[end] != QLatin1Char('/'))
+        ++end;
+    return end > begin;
+}
+
+// Neuen Wert im Stil des alten schreiben (hex/dez, Stellenzahl, Groß-/Kleinschreibung)
+QString formatLike(const QString& oldToken, quint32 value)
+{
+    if (oldToken.startsWith("0x", Qt::CaseInsensitive)) {
+        const int digits = oldToken.size() - 2;
+        QString hex = QString::number(value, 16);
+        if (oldToken.mid(2) == oldToken.mid(2).toUpper())
+            hex = hex.toUpper();
+        return oldToken.left(2) + hex.rightJustified(digits, QLatin1Char('0'));
+    }
+    return QString::number(value);
+}
+
+QString formatNew(const QString& name, quint32 value)
+{
+    return QString("#define %1 0x%2").arg(name, QString::number(value, 16).toUpper());
+}
+}
+
 // --------------------------------------------------
 // Alles löschen
 // --------------------------------------------------
 void DefineManager::clear()
 {
-    m_all.clear();
-    m_windowDefines.clear();
-    m_controlDefines.clear();
+    m_entries.clear();
+    m_byName.clear();
+    m_byValue.clear();
+    m_sourceLines.clear();
+    m_removedSpans.clear();
+    m_windowIds.clear();
+    m_controlIds.clear();
+    m_nextSequence = 0;
     setDirty();
 }
 
+void DefineManager::insertEntry(DefineEntry entry)
+{
+    // Doppelte Definition: spätere gewinnt (wie bisher bei QMap)
+    auto it = m_byName.constFind(entry.name);
+    if (it != m_byName.constEnd()) {
+        DefineEntry& old = m_entries[it.value()];
+        m_byValue[old.value].removeOne(old.name);
+        untrackValue(old.name, old.value);
+        old.value = entry.value;
+        old.line = entry.line;
+        old.lineCount = entry.lineCount;
+        old.modified = entry.modified;
+        m_byValue[old.value].append(old.name);
+        trackValue(old.name, old.value);
+        return;
+    }
+
+    entry.sequence = m_nextSequence++;
+    m_byName.insert(entry.name, m_entries.size());
+    m_byValue[entry.value].append(entry.name);
+    trackValue(entry.name, entry.value);
+    m_entries.append(std::move(entry));
+}
+
+QVector<const DefineEntry*> DefineManager::entriesInOrder() const
+{
+    QVector<const DefineEntry*> ordered;
+    ordered.reserve(m_entries.size());
+    for (const DefineEntry& e : m_entries)
+        ordered.append(&e);
+
+    std::sort(ordered.begin(), ordered.end(),
+              [](const DefineEntry* a, const DefineEntry* b) { return a->sequence < b->sequence; });
+    return ordered;
+}
+
 // --------------------------------------------------
 // Neues Define hinzufügen oder aktualisieren
 // --------------------------------------------------
 void DefineManager::addDefine(const QString& name, quint32 value)
 {
-    if (m_all.value(name) == value)
-        return; // keine Änderung
+    auto it = m_byName.constFind(name);
+    if (it != m_byName.constEnd())
+    {
+        DefineEntry& e = m_entries[it.value()];
+        if (e.value == value)
+            return; // keine Änderung
+
+        m_byValue[e.value].removeOne(name);
+        untrackValue(name, e.value);
+        e.value = value;
+        e.modified = true;
+        m_byValue[value].append(name);
+        trackValue(name, value);
+    }
+    else
+    {
+        DefineEntry e;
+        e.name = name;
+        e.value = value;
+        e.modified = true;
+        insertEntry(std::move(e));
+    }
 
-    m_all[name] = value;
+    // Fenster-IDs müssen eindeutig sein – Kollision sofort melden
+    if (isWindowDefine(name) && hasCollision(name))
+        qWarning().noquote() << "[DefineManager] ⚠️ ID-Kollision:" << name << "="
+                             << namesForValue(value).join(", ");
 
-    if (name.startsWith("APP_") || name.startsWith("WND_", Qt::CaseInsensitive))
-        m_windowDefines[name] = value;
-    else if (name.startsWith("WIDC_") || name.startsWith("WTYPE_", Qt::CaseInsensitive))
-        m_controlDefines[name] = value;
+    setDirty();
+}
+
+// --------------------------------------------------
+// Define entfernen (gibt die ID wieder frei)
+// --------------------------------------------------
+void DefineManager::removeDefine(const QString& name)
+{
+    auto it = m_byName.constFind(name);
+    if (it == m_byName.constEnd())
+        return;
+
+    const int index = it.value();
+    const DefineEntry e = m_entries[index];
+
+    m_byValue[e.value].removeOne(name);
+    if (m_byValue[e.value].isEmpty())
+        m_byValue.remove(e.value);
+    untrackValue(name, e.value);
+
+    if (e.line >= 0)
+        m_removedSpans.insert(e.line, e.lineCount);
+
+    // Letzten Eintrag in die Lücke ziehen – nur ein Index ändert sich;
+    // Speichern/Export ordnen über sequence, nicht über m_entries
+    const int last = int(m_entries.size()) - 1;
+    if (index != last) {
+        m_entries[index] = std::move(m_entries[last]);
+        m_byName[m_entries[index].name] = index;
+    }
+    m_entries.removeLast();
+    m_byName.remove(name);
 
     setDirty();
 }
 
 // --------------------------------------------------
-// Eine Zeile aus einer Define-Datei verarbeiten
+// ID-Bitmaps
 // --------------------------------------------------
-void DefineManager::processDefineLine(const QString& line)
+IdAllocator* DefineManager::allocatorFor(const QString& name)
+{
+    if (isWindowDefine(name))
+        return &m_windowIds;
+    if (name.startsWith("WIDC_"))
+        return &m_controlIds;
+    return nullptr;
+}
+
+void DefineManager::trackValue(const QString& name, quint32 value)
+{
+    if (IdAllocator* a = allocatorFor(name))
+        a->mark(value);
+}
+
+void DefineManager::untrackValue(const QString& name, quint32 value)
 {
-    QString trimmed = line.trimmed();
-    if (!trimmed.startsWith("#define"))
+    IdAllocator* a = allocatorFor(name);
+    if (!a)
         return;
 
-    const QStringList parts = trimmed.split(QRegularExpression("\\s+"), Qt::SkipEmptyParts);
+    // Nur freigeben, wenn kein anderer Name derselben Art den Wert hält
+    for (const QString& other : m_byValue.value(value))
+        if (other != name && allocatorFor(other) == a)
+            return;
+
+    a->release(value);
+}
+
+void DefineManager::setIdRange(IdKind kind, const IdRange& range)
+{
+    (kind == IdKind::Window ? m_windowRange : m_controlRange) = range;
+}
+
+IdRange DefineManager::idRange(IdKind kind) const
+{
+    return kind == IdKind::Window ? m_windowRange : m_controlRange;
+}
+
+IdRange DefineManager::controlRangeForWindow(quint32 windowId)
+{
+    const quint64 first = quint64(windowId) * ControlIdStep;
+    const quint64 last  = first + ControlIdStep - 1;
+    if (last > 0xFFFFFFFFull)
+        return { 1, 0 };   // leerer Bereich
+    return { quint32(first), quint32(last) };
+}
+
+bool DefineManager::isIdUsed(IdKind kind, quint32 value) const
+{
+    return (kind == IdKind::Window ? m_windowIds : m_controlIds).isUsed(value);
+}
+
+std::optional<quint32> DefineManager::createDefine(const QString& name, IdKind kind)
+{
+    return createDefine(name, kind, idRange(kind));
+}
+
+std::optional<quint32> DefineManager::createDefine(const QString& name, IdKind kind, const IdRange& range)
+{
+    if (allocatorFor(name) != &allocator(kind)) {
+        qWarning().noquote() << "[DefineManager] ⚠️ Name passt nicht zur ID-Art:" << name;
+        return std::nullopt;
+    }
+
+    if (const DefineEntry* e = find(name))
+        return e->value;
+
+    const auto id = allocator(kind).allocate(range);
+    if (!id) {
+        qWarning().noquote() << QString("[DefineManager] ⚠️ Keine freie ID in [%1, %2] für %3")
+                                    .arg(range.first).arg(range.last).arg(name);
+        return std::nullopt;
+    }
+
+    addDefine(name, *id);   // Bit ist bereits gesetzt, trackValue bestätigt es nur
+    return id;
+}
+
+QVector<quint32> DefineManager::createDefines(const QStringList& names, IdKind kind,
+                                              const IdRange& range, bool contiguous)
+{
+    QStringList fresh;
+    for (const QString& name : names) {
+        if (allocatorFor(name) != &allocator(kind)) {
+            qWarning().noquote() << "[DefineManager] ⚠️ Name passt nicht zur ID-Art:" << name;
+            return {};
+        }
+        if (!hasDefine(name) && !fresh.contains(name))
+            fresh << name;
+    }
+
+    const QVector<quint32> ids = allocator(kind).allocate(int(fresh.size()), range, contiguous);
+    if (ids.size() != fresh.size()) {
+        qWarning().noquote() << QString("[DefineManager] ⚠️ %1 IDs in [%2, %3] nicht verfügbar")
+                                    .arg(fresh.size()).arg(range.first).arg(range.last);
+        return {};
+    }
+
+    for (int i = 0; i < fresh.size(); ++i)
+        addDefine(fresh[i], ids[i]);
+
+    QVector<quint32> result;
+    result.reserve(names.size());
+    for (const QString& name : names)
+        result.append(getValue(name));
+    return result;
+}
+
+// --------------------------------------------------
+// "#define NAME VALUE" ab einer Zeile lesen
+// --------------------------------------------------
+bool DefineManager::parseDefineAt(const QStringList& lines, int index, DefineEntry& out) const
+{
+    const QString& first = lines[index];
+
+    int p = 0;
+    while (p < first.size() && first[p].isSpace()) ++p;
+    if (!first.mid(p, 7).startsWith(QLatin1String("#define")))
+        return false;
+
+    // Umfang inkl. '\'-Fortsetzungen
+    int span = 1;
+    while (index + span < lines.size() && lines[index + span - 1].trimmed().endsWith(QLatin1Char('\\')))
+        ++span;
+
+    const QStringList parts = first.simplified().split(' ', Qt::SkipEmptyParts);
     if (parts.size() < 3)
-        return;
+        return false;
 
-    QString name = parts[1];
     bool ok = false;
-    quint32 value = parts[2].toUInt(&ok, 0);
-    if (ok)
-        addDefine(name, value);
+    const quint32 value = parts[2].toUInt(&ok, 0);
+    if (!ok)
+        return false;
+
+    out.name = parts[1];
+    out.value = value;
+    out.line = index;
+    out.lineCount = span;
+    out.modified = false;
+    return true;
+}
+
+// --------------------------------------------------
+// Dateiinhalt übernehmen
+// --------------------------------------------------
+void DefineManager::loadSource(const QStringList& lines)
+{
+    m_entries.clear();
+    m_byName.clear();
+    m_byValue.clear();
+    m_removedSpans.clear();
+    m_windowIds.clear();
+    m_controlIds.clear();
+    m_nextSequence = 0;
+    m_sourceLines = lines;
+
+    for (int i = 0; i < lines.size(); )
+    {
+        DefineEntry e;
+        if (parseDefineAt(lines, i, e)) {
+            i += e.lineCount;
+            insertEntry(std::move(e));
+        } else {
+            ++i;
+        }
+    }
+
+    const QStringList windowCollisions = collisions("APP_");
+    if (!windowCollisions.isEmpty())
+        qWarning().noquote() << "[DefineManager] ⚠️ Fenster-ID-Kollisionen:" << windowCollisions.join(", ");
+
+    qInfo() << "[DefineManager] Defines geladen:" << m_entries.size()
+            << "aus" << lines.size() << "Zeilen.";
+
+    clearDirty();
 }
 
 // --------------------------------------------------
@@ -66,7 +367,7 @@ void DefineManager::processDefineLine(const QString& line)
 // --------------------------------------------------
 bool DefineManager::hasDefine(const QString& name) const
 {
-    return m_all.contains(name);
+    return m_byName.contains(name);
 }
 
 // --------------------------------------------------
@@ -74,7 +375,134 @@ bool DefineManager::hasDefine(const QString& name) const
 // --------------------------------------------------
 quint32 DefineManager::getValue(const QString& name) const
 {
-    return m_all.value(name, 0);
+    const DefineEntry* e = find(name);
+    return e ? e->value : 0;
+}
+
+const DefineEntry* DefineManager::find(const QString& name) const
+{
+    auto it = m_byName.constFind(name);
+    return it != m_byName.constEnd() ? &m_entries[it.value()] : nullptr;
+}
+
+// --------------------------------------------------
+// Umkehrsuche / Kollisionen
+// --------------------------------------------------
+QStringList DefineManager::namesForValue(quint32 value) const
+{
+    return m_byValue.value(value);
+}
+
+bool DefineManager::hasCollision(const QString& name) const
+{
+    const DefineEntry* e = find(name);
+    if (!e)
+        return false;
+
+    // Nur Namen derselben Kategorie (APP_ mit APP_, WIDC_ mit WIDC_) zählen
+    const QString prefix = name.section('_', 0, 0) + '_';
+    int same = 0;
+    for (const QString& other : m_byValue.value(e->value))
+        if (other.startsWith(prefix) && ++same > 1)
+            return true;
+    return false;
+}
+
+QStringList DefineManager::collisions(const QString& prefix) const
+{
+    QStringList result;
+    for (auto it = m_byValue.constBegin(); it != m_byValue.constEnd(); ++it)
+    {
+        QStringList same;
+        for (const QString& n : it.value())
+            if (n.startsWith(prefix))
+                same << n;
+        if (same.size() > 1)
+            result += same;
+    }
+    result.sort();
+    return result;
+}
+
+int DefineManager::modifiedCount() const
+{
+    int n = m_removedSpans.size();
+    for (const DefineEntry& e : m_entries)
+        if (e.modified) ++n;
+    return n;
+}
+
+// --------------------------------------------------
+// Patch-Save: nur geänderte Zeilen ersetzen, neue anhängen
+// --------------------------------------------------
+QStringList DefineManager::patchedSource() const
+{
+    QHash<int, const DefineEntry*> changedAt;   // Startzeile → geänderter Eintrag
+    QVector<const DefineEntry*> added;
+    int lastDefineLine = -1;
+
+    for (auto it = m_removedSpans.constBegin(); it != m_removedSpans.constEnd(); ++it)
+        lastDefineLine = qMax(lastDefineLine, it.key() + it.value() - 1);
+
+    for (const DefineEntry& e : m_entries) {
+        if (e.line >= 0)
+            lastDefineLine = qMax(lastDefineLine, e.line + e.lineCount - 1);
+        if (!e.modified)
+            continue;
+        if (e.line >= 0)
+            changedAt.insert(e.line, &e);
+        else
+            added.append(&e);
+    }
+
+    QStringList out;
+    out.reserve(m_sourceLines.size() + added.size());
+
+    // Neue Defines in Anlegereihenfolge (removeDefine verschiebt Einträge)
+    std::sort(added.begin(), added.end(),
+              [](const DefineEntry* a, const DefineEntry* b) { return a->sequence < b->sequence; });
+
+    auto appendAdded = [&]() {
+        for (const DefineEntry* e : added)
+            out << formatNew(e->name, e->value);
+    };
+
+    if (lastDefineLine < 0)
+        appendAdded();   // Datei ohne Defines → neue Einträge vorne
+
+    for (int i = 0; i < m_sourceLines.size(); )
+    {
+        const DefineEntry* e = changedAt.value(i, nullptr);
+        int consumed = 1;
+
+        if (m_removedSpans.contains(i)) {
+            consumed = m_removedSpans.value(i);   // entfernte Defines fallen weg
+        } else if (e) {
+            // Erste Zeile behalten, nur den Wert tauschen (Kommentare/Einrückung bleiben)
+            QString line = m_sourceLines[i];
+            int vb = 0, ve = 0;
+            if (e->lineCount == 1 && valueSpan(line, vb, ve))
+                line.replace(vb, ve - vb, formatLike(line.mid(vb, ve - vb), e->value));
+            else
+                line = formatNew(e->name, e->value);
+            out << line;
+            consumed = e->lineCount;
+        } else {
+            out << m_sourceLines[i];
+        }
+
+        const int last = i + consumed - 1;
+        i += consumed;
+        if (last == lastDefineLine)
+            appendAdded();   // neue Defines direkt hinter dem letzten bestehenden
+    }
+
+    return out;
+}
+
+void DefineManager::markSaved(const QStringList& writtenLines)
+{
+    loadSource(writtenLines);
 }
 
 // --------------------------------------------------
@@ -82,37 +510,34 @@ quint32 DefineManager::getValue(const QString& name) const
 // --------------------------------------------------
 void DefineManager::generateDefines(const QMap<QString, std::shared_ptr<WindowData>>& windows)
 {
-    m_windowDefines.clear();
-    m_controlDefines.clear();
-
-    quint32 nextWindowId = 100;
-    quint32 baseStep = 1000;
+    int windowCount = 0;
+    int controlCount = 0;
 
+    // IDs kommen aus den Bitmaps – vorhandene Defines behalten ihren Wert,
+    // neue bekommen die nächste freie ID (Fenster ab m_windowRange, Controls
+    // im Block des Fensters)
     for (auto it = windows.constBegin(); it != windows.constEnd(); ++it)
     {
-        QString wndName = it.key();
-        auto wnd = it.value();
-
-        QString wndDefine = QString("WND_%1").arg(wndName.toUpper());
-        addDefine(wndDefine, nextWindowId);
+        const QString wndName = it.key().toUpper();
+        const auto& wnd = it.value();
 
-        quint32 nextControlId = nextWindowId * baseStep;
+        const auto windowId = createDefine(QString("WND_%1").arg(wndName), IdKind::Window);
+        if (!windowId)
+            continue;
+        ++windowCount;
 
+        const IdRange range = controlRangeForWindow(*windowId);
         for (const auto& ctrl : wnd->controls)
         {
-            QString ctrlName = ctrl->id;
-            QString ctrlDefine = QString("WIDC_%1_%2")
-                                     .arg(wndName.toUpper())
-                                     .arg(ctrlName.toUpper());
-            addDefine(ctrlDefine, nextControlId++);
+            const QString ctrlDefine = QString("WIDC_%1_%2").arg(wndName, ctrl->id.toUpper());
+            if (createDefine(ctrlDefine, IdKind::Control, range))
+                ++controlCount;
         }
-
-        nextWindowId++;
     }
 
     qInfo().noquote() << QString("[DefineManager] GenerateDefines abgeschlossen: %1 Fenster, %2 Controls")
-                             .arg(m_windowDefines.size())
-                             .arg(m_controlDefines.size());
+                             .arg(windowCount)
+                             .arg(controlCount);
 
     setDirty();
 }
@@ -128,25 +553,14 @@ void DefineManager::rebuildFromTokens(const QList<Token>& tokens)
     {
         if (t.type == "Define")
         {
-            QString line = t.value.trimmed();
-            if (!line.startsWith("#define"))
-                continue;
-
-            const QStringList parts = line.split(QRegularExpression("\\s+"), Qt::SkipEmptyParts);
-            if (parts.size() < 3)
-                continue;
-
-            QString name = parts[1];
-            bool ok = false;
-            quint32 value = parts[2].toUInt(&ok, 0);
-            if (ok)
-                addDefine(name, value);
+            DefineEntry e;
+            if (parseDefineAt(QStringList{ t.value }, 0, e))
+                addDefine(e.name, e.value);
         }
     }
 
     qInfo() << "[DefineManager] rebuildFromTokens() abgeschlossen:"
-            << m_windowDefines.size() << "Fenster,"
-            << m_controlDefines.size() << "Controls.";
+            << m_entries.size() << "Defines.";
 
     setDirty();
 }
@@ -167,19 +581,57 @@ QList<Token> DefineManager::exportToTokens() const
 {
     QList<Token> tokens;
 
-    for (auto it = m_all.constBegin(); it != m_all.constEnd(); ++it)
+    for (const DefineEntry* e : entriesInOrder())
     {
         Token t;
         t.type = "Define";
-        t.value = QString("#define %1 0x%2")
-                      .arg(it.key())
-                      .arg(QString::number(it.value(), 16).toUpper());
+        t.value = formatNew(e->name, e->value);
         tokens.append(t);
     }
 
     return tokens;
 }
 
+// --------------------------------------------------
+// Verknüpfung Layout ↔ Defines
+// --------------------------------------------------
+void DefineManager::rebuildLinkIndex()
+{
+    m_linkIndex.clear();
+    m_linkIndex.reserve(m_entries.size());
+
+    for (int i = 0; i < m_entries.size(); ++i) {
+        LinkKey key;
+        key.add(m_entries[i].name);
+        m_linkIndex.insert(key.hash, i);   // Kollisionen bleiben als weitere Werte erhalten
+    }
+}
+
+const DefineEntry* DefineManager::lookupLink(const LinkKey& key,
+                                             std::initializer_list<QStringView> parts) const
+{
+    // Hash-Treffer gegen die Teile prüfen (ohne String zu bauen); bei
+    // einer 64-Bit-Kollision liegen mehrere Indizes unter dem Hash
+    auto matches = [&](const DefineEntry& e) {
+        if (e.name.size() != key.length)
+            return false;
+
+        int pos = 0;
+        for (QStringView part : parts)
+            for (QChar c : part)
+                if (e.name[pos++] != c.toUpper())
+                    return false;
+        return true;
+    };
+
+    for (auto it = m_linkIndex.constFind(key.hash); it != m_linkIndex.constEnd() && it.key() == key.hash; ++it) {
+        const DefineEntry& e = m_entries[it.value()];
+        if (matches(e))
+            return &e;
+    }
+    return nullptr;
+}
+
 void DefineManager::applyDefinesToLayout(const std::vector<std::shared_ptr<WindowData>>& windows)
 {
     if (windows.empty()) {
@@ -187,65 +639,73 @@ void DefineManager::applyDefinesToLayout(const std::vector<std::shared_ptr<Windo
         return;
     }
 
-    if (m_all.isEmpty() && m_windowDefines.isEmpty() && m_controlDefines.isEmpty()) {
+    if (m_entries.isEmpty()) {
         qInfo() << "[DefineManager] applyDefinesToLayout(): keine Defines geladen – überspringe.";
         return;
     }
 
-    qInfo() << "[DefineManager] applyDefinesToLayout(): Mapping startet. Fenster:" << windows.size();
+    QElapsedTimer timer;
+    timer.start();
+
+    rebuildLinkIndex();
+
+    std::atomic_int linkedWindows { 0 };
+    std::atomic_int linkedControls { 0 };
 
-    for (const auto& wnd : windows)
+    // Pro Fenster unabhängig → parallel; der Index wird nur gelesen
+    auto linkWindow = [&](const std::shared_ptr<WindowData>& wnd)
     {
-        if (!wnd)
-            continue;
+        if (!wnd || wnd->name.isEmpty())
+            return;
 
-        const QString wndName = wnd->name;
-        if (wndName.isEmpty())
-            continue;
+        const QStringView wndName(wnd->name);
 
-        // Fenster-Define-Name wie in generateDefines()
-        const QString wndDefine = QStringLiteral("WND_%1").arg(wndName.toUpper());
+        // Fenster: "WND_<NAME>" wie in generateDefines(), sonst der Name selbst (APP_*)
+        LinkKey wndKey;
+        wndKey.add(u"WND_");
+        wndKey.addUpper(wndName);
 
-        quint32 wndId = 0;
+        const DefineEntry* wndDef = lookupLink(wndKey, { u"WND_", wndName });
+        if (!wndDef)
+            wndDef = find(wnd->name);
 
-        if (m_windowDefines.contains(wndDefine))
-            wndId = m_windowDefines.value(wndDefine);
-        else if (m_all.contains(wndDefine))
-            wndId = m_all.value(wndDefine);
+        wnd->defineName = wndDef ? wndDef->name : QString();
+        wnd->defineId   = wndDef ? wndDef->value : 0;
+        if (wndDef)
+            ++linkedWindows;
 
-        if (wndId != 0) {
-            wnd->behavior.attributes["defineName"] = wndDefine;
-            wnd->behavior.attributes["defineId"]   = wndId;
-        }
+        // Controls: Präfix "WIDC_<FENSTER>_" einmal pro Fenster hashen
+        LinkKey ctrlPrefix;
+        ctrlPrefix.add(u"WIDC_");
+        ctrlPrefix.addUpper(wndName);
+        ctrlPrefix.add(u"_");
 
-        // Controls
         for (const auto& ctrl : wnd->controls)
         {
-            if (!ctrl)
-                continue;
-
-            const QString ctrlName = ctrl->id;
-            if (ctrlName.isEmpty())
+            if (!ctrl || ctrl->id.isEmpty())
                 continue;
 
-            // Control-Define-Name wie in generateDefines()
-            const QString ctrlDefine = QStringLiteral("WIDC_%1_%2")
-                                           .arg(wndName.toUpper())
-                                           .arg(ctrlName.toUpper());
+            const QStringView ctrlName(ctrl->id);
 
-            quint32 ctrlId = 0;
+            LinkKey ctrlKey = ctrlPrefix;
+            ctrlKey.addUpper(ctrlName);
 
-            if (m_controlDefines.contains(ctrlDefine))
-                ctrlId = m_controlDefines.value(ctrlDefine);
-            else if (m_all.contains(ctrlDefine))
-                ctrlId = m_all.value(ctrlDefine);
+            const DefineEntry* ctrlDef = lookupLink(ctrlKey, { u"WIDC_", wndName, u"_", ctrlName });
+            if (!ctrlDef)
+                ctrlDef = find(ctrl->id);
 
-            if (ctrlId != 0) {
-                ctrl->behavior.attributes["defineName"] = ctrlDefine;
-                ctrl->behavior.attributes["defineId"]   = ctrlId;
-            }
+            ctrl->defineName = ctrlDef ? ctrlDef->name : QString();
+            ctrl->defineId   = ctrlDef ? ctrlDef->value : 0;
+            if (ctrlDef)
+                ++linkedControls;
         }
-    }
+    };
+
+    QtConcurrent::blockingMap(windows.begin(), windows.end(), linkWindow);
 
-    qInfo() << "[DefineManager] applyDefinesToLayout(): Mapping abgeschlossen.";
+    qInfo().noquote() << QString("[DefineManager] applyDefinesToLayout(): %1/%2 Fenster, %3 Controls verknüpft (%4 ms).")
+                             .arg(linkedWindows.load())
+                             .arg(windows.size())
+                             .arg(linkedControls.load())
+                             .arg(timer.elapsed());
 }
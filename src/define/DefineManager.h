@@ -1,21 +1,43 @@
 #pragma once
 #include <QObject>
+#include <QHash>
 #include <QMap>
 #include <QString>
+#include <QStringList>
 #include <QList>
+#include <QVector>
+#include <QStringView>
+#include <initializer_list>
 #include <memory>
 #include <vector>
 
 #include "utils/BaseManager.h"
+#include "define/IdAllocator.h"
 #include "layout/model/TokenData.h"
 
 struct WindowData;
 struct ControlData;
 
+// ------------------------------------------------------------
+// Ein #define aus resdata.h inkl. Herkunft in der Datei
+// ------------------------------------------------------------
+struct DefineEntry
+{
+    QString name;
+    quint32 value = 0;
+    int  line = -1;          // erste Zeile in resdata.h (0-basiert), -1 = neu
+    int  lineCount = 0;      // Umfang inkl. '\'-Fortsetzungen
+    bool modified = false;   // seit Laden/Speichern geändert
+    quint64 sequence = 0;    // Anlegereihenfolge (Reihenfolge in m_entries ist es nicht)
+};
+
 // ------------------------------------------------------------
 // DefineManager
 //  - Verwalten und Analysieren aller Define-Daten (#define ...)
-//  - Arbeitet mit Token-System zusammen
+//  - Indiziertes Modell: Name → Eintrag, Wert → Namen
+//    (ID-Kollisionen in O(1) erkennbar)
+//  - Merkt sich die Originalzeilen, damit beim Speichern nur
+//    geänderte / neue Zeilen gepatcht werden
 //  - Erbt von BaseManager (für Dirty-Flag & Änderungs-Signale)
 // ------------------------------------------------------------
 class DefineManager : public BaseManager
@@ -24,12 +46,45 @@ class DefineManager : public BaseManager
 public:
     explicit DefineManager(QObject* parent = nullptr);
 
+    // Getrennte ID-Räume: Fenster (APP_/WND_) und Controls (WIDC_)
+    enum class IdKind { Window, Control };
+
+    // Schrittweite der Control-IDs pro Fenster (siehe generateDefines)
+    static constexpr quint32 ControlIdStep = 1000;
+
     void clear();
     void addDefine(const QString& name, quint32 value);
-    void processDefineLine(const QString& line);
+    void removeDefine(const QString& name);
+
+    // Kompletten Dateiinhalt übernehmen (Zeilen bleiben für den Patch-Save erhalten)
+    void loadSource(const QStringList& lines);
 
     bool hasDefine(const QString& name) const;
     quint32 getValue(const QString& name) const;
+    const DefineEntry* find(const QString& name) const;
+
+    // Umkehrsuche / Kollisionen
+    QStringList namesForValue(quint32 value) const;
+    bool hasCollision(const QString& name) const;
+    QStringList collisions(const QString& prefix) const;   // Namen mit geteiltem Wert
+
+    // Freie IDs (Bitmap, amortisiert O(1))
+    void setIdRange(IdKind kind, const IdRange& range);
+    IdRange idRange(IdKind kind) const;
+    static IdRange controlRangeForWindow(quint32 windowId);
+
+    bool isIdUsed(IdKind kind, quint32 value) const;
+
+    // Neues Define mit freier ID anlegen – Vergabe und Eintrag in einem
+    // Schritt, die ID lebt damit so lange wie das Define. Existiert der
+    // Name bereits, bleibt sein Wert. nullopt bei vollem Bereich oder
+    // wenn der Name nicht zur Art passt (APP_/WND_ ↔ WIDC_).
+    std::optional<quint32> createDefine(const QString& name, IdKind kind);
+    std::optional<quint32> createDefine(const QString& name, IdKind kind, const IdRange& range);
+    // Mehrere auf einmal (z. B. eingefügte Control-Gruppen); contiguous =
+    // lückenloser Block. Alles oder nichts – leer, wenn der Bereich nicht reicht.
+    QVector<quint32> createDefines(const QStringList& names, IdKind kind, const IdRange& range,
+                                   bool contiguous = false);
 
     void generateDefines(const QMap<QString, std::shared_ptr<WindowData>>& windows);
     void rebuildFromTokens(const QList<Token>& tokens);
@@ -37,14 +92,51 @@ public:
     void importFromTokens(const QList<Token>& tokens);
     QList<Token> exportToTokens() const;
 
-    const QMap<QString, quint32>& allDefines() const { return m_all; }
-    const QMap<QString, quint32>& windowDefines() const { return m_windowDefines; }
-    const QMap<QString, quint32>& controlDefines() const { return m_controlDefines; }
+    const QVector<DefineEntry>& entries() const { return m_entries; }
+    const QStringList& sourceLines() const { return m_sourceLines; }
+    int modifiedCount() const;
+
+    // Quelltext mit eingearbeiteten Änderungen (nur betroffene Zeilen neu)
+    QStringList patchedSource() const;
+    void markSaved(const QStringList& writtenLines);
 
     void applyDefinesToLayout(const std::vector<std::shared_ptr<WindowData>>& windows);
 
 private:
-    QMap<QString, quint32> m_all;
-    QMap<QString, quint32> m_windowDefines;
-    QMap<QString, quint32> m_controlDefines;
+    // "#define NAME VALUE" ab Zeile index → Eintrag (Fortsetzungen eingeschlossen)
+    bool parseDefineAt(const QStringList& lines, int index, DefineEntry& out) const;
+    void insertEntry(DefineEntry entry);
+    QVector<const DefineEntry*> entriesInOrder() const;   // nach sequence
+
+    // FNV-1a über UTF-16-Einheiten, schrittweise aufbaubar
+    // (Präfix pro Fenster einmal, dann je Control fortsetzen)
+    struct LinkKey {
+        quint64 hash = 14695981039346656037ull;
+        int length = 0;
+
+        void add(QChar c) { hash = (hash ^ c.unicode()) * 1099511628211ull; ++length; }
+        void add(QStringView s) { for (QChar c : s) add(c); }
+        void addUpper(QStringView s) { for (QChar c : s) add(c.toUpper()); }
+    };
+
+    void rebuildLinkIndex();
+    const DefineEntry* lookupLink(const LinkKey& key, std::initializer_list<QStringView> parts) const;
+
+    IdAllocator* allocatorFor(const QString& name);
+    IdAllocator& allocator(IdKind kind) { return kind == IdKind::Window ? m_windowIds : m_controlIds; }
+    void trackValue(const QString& name, quint32 value);
+    void untrackValue(const QString& name, quint32 value);
+
+    QVector<DefineEntry>        m_entries;
+    QHash<QString, int>         m_byName;     // Name → Index in m_entries
+    QHash<quint32, QStringList> m_byValue;    // Wert → Namen
+    QStringList                 m_sourceLines;
+    QHash<int, int>             m_removedSpans; // Startzeile → Zeilen entfernter Defines
+    QMultiHash<quint64, int>    m_linkIndex;    // Namens-Hash → Index(e) (applyDefinesToLayout)
+    quint64                     m_nextSequence = 0;
+
+    IdAllocator m_windowIds;
+    IdAllocator m_controlIds;
+    IdRange     m_windowRange  { 100, 0xFFFF };
+    IdRange     m_controlRange { 1, 0x00FFFFFF };
 };
@@ -1,10 +1,13 @@
 #include "FlagManager.h"
 #include "ConfigManager.h"
+#include "DefaultFlags.h"
+#include "DefineEvaluator.h"
+#include "HeaderScanner.h"
 #include <QDirIterator>
 #include <QFile>
 #include <QJsonDocument>
 #include <QJsonObject>
-#include <QRegularExpression>
+#include <QSet>
 #include <QTextStream>
 #include <QDebug>
 #include <qjsonarray.h>
@@ -15,52 +18,34 @@
 FlagManager::FlagManager(ConfigManager* config)
     : m_config(config)
 {
-    m_legacyOverrides = {
-        "WBS_NOCLOSE"
-    };
+    for (std::string_view name : DefaultFlags::legacyOverrides)
+        m_legacyOverrides << QString::fromLatin1(name.data(), qsizetype(name.size()));
     qInfo() << "[FlagManager] Initialisiert.";
 }
 
 // ============================================================================
-// Hilfsfunktion: Numerische Werte -> Hexstring (0xXXXXXXXX)
+// JSON nur schreiben, wenn sich der Inhalt tatsächlich geändert hat
 // ============================================================================
-static QString toHex(const QString& valStr)
+// Verglichen wird der Hash der kompakten Serialisierung – Formatierung
+// und Schlüsselreihenfolge der Datei spielen keine Rolle. Unveränderte
+// Starts schreiben so keine Config-Datei neu (mtime bleibt stabil).
+static bool writeJsonIfChanged(const QString& path,
+                               const QJsonObject& original,
+                               const QJsonObject& merged)
 {
-    QString s = valStr.trimmed();
-    quint32 value = 0;
-
-    // Bitshift: (1 << x)
-    QRegularExpression shiftRe(R"(\(?\s*1\s*<<\s*(\d+)\s*\)?)");
-    QRegularExpressionMatch sm = shiftRe.match(s);
-    if (sm.hasMatch()) {
-        value = (1u << sm.captured(1).toUInt());
-    }
-    // Bitmasken mit OR
-    else if (s.contains("|")) {
-        QStringList parts = s.split("|");
-        for (QString p : parts)
-            value |= p.trimmed().startsWith("0x", Qt::CaseInsensitive)
-                         ? p.trimmed().toUInt(nullptr, 16)
-                         : p.trimmed().toUInt(nullptr, 10);
-    }
-    // Kombination mit +
-    else if (s.contains("+")) {
-        QStringList parts = s.split("+");
-        for (QString p : parts)
-            value += p.trimmed().startsWith("0x", Qt::CaseInsensitive)
-                         ? p.trimmed().toUInt(nullptr, 16)
-                         : p.trimmed().toUInt(nullptr, 10);
-    }
-    // Hexwert
-    else if (s.startsWith("0x", Qt::CaseInsensitive)) {
-        value = s.toUInt(nullptr, 16);
-    }
-    // Plain Decimal
-    else if (s.contains(QRegularExpression("^[0-9]+$"))) {
-        value = s.toUInt(nullptr, 10);
-    }
+    const size_t before = qHash(QJsonDocument(original).toJson(QJsonDocument::Compact));
+    const size_t after  = qHash(QJsonDocument(merged).toJson(QJsonDocument::Compact));
+    if (before == after)
+        return false;
 
-    return QString("0x%1").arg(value, 8, 16, QLatin1Char('0')).toUpper();
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+        qWarning() << "[FlagManager] Fehler beim Schreiben:" << path;
+        return false;
+    }
+    file.write(QJsonDocument(merged).toJson(QJsonDocument::Indented));
+    file.close();
+    return true;
 }
 
 // ============================================================================
@@ -96,57 +81,34 @@ static void classifyAndInsert(
 }
 
 // ============================================================================
-// Scannt eine Header-Datei und extrahiert alle relevanten Flag-Definitionen
+// Übernimmt ein ausgewertetes #define, falls es ein relevantes Flag ist
 // ============================================================================
-void FlagManager::parseHeaderFile(const QString& filePath)
+void FlagManager::applyHeaderDefine(const QString& key, quint32 numeric)
 {
-    QFile file(filePath);
-    if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
-        return;
-
-    QTextStream in(&file);
-    while (!in.atEnd())
-    {
-        QString line = in.readLine().trimmed();
-        if (!line.startsWith("#define"))
-            continue;
-
-        const QStringList tokens = line.split(QRegularExpression("\\s+"), Qt::SkipEmptyParts);
-        if (tokens.size() < 3)
-            continue;
-
-        QString key   = tokens[1];
-        QString value = tokens[2].trimmed();
-
-        // 🔹 Entferne Endungen wie "L", "UL", "U"
-        value.remove(QRegularExpression("[lLuU]+$"));
-
-        // 🔹 Zahlenwert in Hex normalisieren
-        if (!value.startsWith("0x", Qt::CaseInsensitive)) {
-            bool ok = false;
-            quint32 dec = value.toUInt(&ok, 10);
-            if (ok)
-                value = QString("0x%1").arg(dec, 8, 16, QLatin1Char('0')).toUpper();
-            else
-                continue;
-        } else {
-            bool ok = false;
-            value.toUInt(&ok, 16);
-            if (!ok)
-                continue;
-            value = value.toUpper();
-        }
+    const QString value = QString("0x%1").arg(numeric, 8, 16, QLatin1Char('0')).toUpper();
+
+    // 🔸 Gruppierung
+    if      (key.startsWith("WBS_"))   m_windowFlags.insert(key, value);
+    else if (key.startsWith("BS_"))    m_controlFlags.insert(key, value);
+    else if (key.startsWith("EBS_"))   m_controlFlags.insert(key, value);
+    else if (key.startsWith("TCS_"))   m_controlFlags.insert(key, value);
+    else if (key.startsWith("WLVS_"))  m_controlFlags.insert(key, value);
+    else if (key.startsWith("SS_"))    m_controlFlags.insert(key, value);
+    else if (key.startsWith("WTYPE_")) m_windowTypes.insert(key, value);
+}
 
-        // 🔸 Gruppierung
-        if      (key.startsWith("WBS_"))   m_windowFlags.insert(key, value);
-        else if (key.startsWith("BS_"))    m_controlFlags.insert(key, value);
-        else if (key.startsWith("EBS_"))   m_controlFlags.insert(key, value);
-        else if (key.startsWith("TCS_"))   m_controlFlags.insert(key, value);
-        else if (key.startsWith("WLVS_"))  m_controlFlags.insert(key, value);
-        else if (key.startsWith("SS_"))    m_controlFlags.insert(key, value);
-        else if (key.startsWith("WTYPE_")) m_windowTypes.insert(key, value);
-    }
+// ============================================================================
+// Relevante Flag-Präfixe (alles andere dient nur als Symbol für Verweise)
+// ============================================================================
+static bool isFlagDefine(const QString& key)
+{
+    static const QStringList prefixes = { "WBS_", "BS_", "EBS_", "TCS_", "WLVS_", "SS_", "WTYPE_" };
+    for (const QString& p : prefixes)
+        if (key.startsWith(p))
+            return true;
+    return false;
 }
+
 // ============================================================================
 // Generiert alle Flags aus den angegebenen Header-Pfaden (rekursiv)
 // ============================================================================
@@ -167,17 +129,40 @@ void FlagManager::generateFlags(const QString& sourceDir,
 
     qInfo().noquote() << QString("[FlagManager] Starte Header-Scan in: %1").arg(sourceDir);
 
-    // 🔍 Alle Headerdateien rekursiv durchsuchen
-    QStringList headerFiles;
-    QDirIterator it(sourceDir, QStringList() << "*.h", QDir::Files, QDirIterator::Subdirectories);
-    while (it.hasNext())
-        headerFiles << it.next();
+    // 🔍 Alle Headerdateien parallel lexen – Manifest im Config-Ordner
+    //    sorgt dafür, dass nur geänderte Header neu gelesen werden
+    const QString configDir = QFileInfo(wndPath).absolutePath();
+    HeaderScanner scanner(configDir + "/header_manifest.bin");
+    const QVector<HeaderDefine> defines = scanner.scan(sourceDir);
+
+    qInfo().noquote() << QString("[FlagManager] %1 Header-Dateien gefunden (%2 neu gelesen).")
+                             .arg(scanner.lastStats().files)
+                             .arg(scanner.lastStats().parsed);
 
-    qInfo().noquote() << QString("[FlagManager] %1 Header-Dateien gefunden.").arg(headerFiles.size());
+    // 🧮 Werte als Konstantenausdrücke auflösen – Symboltabelle über alle
+    //    Header, damit z. B. (WBS_CHILD | WBS_VISIBLE) nicht verloren geht
+    DefineEvaluator evaluator(defines);
+    QSet<QString> seen;
+    int unresolved = 0;
+
+    for (const HeaderDefine& def : defines)
+    {
+        if (!isFlagDefine(def.name) || seen.contains(def.name))
+            continue;
+        seen.insert(def.name);
+
+        const std::optional<quint32> value = evaluator.value(def.name);
+        if (!value) {
+            ++unresolved;
+            continue;
+        }
+        applyHeaderDefine(def.name, *value);
+    }
 
-    // 🔄 Alle Headerdateien parsen
-    for (const QString& filePath : headerFiles)
-        parseHeaderFile(filePath);
+    if (unresolved > 0 || evaluator.cycleCount() > 0)
+        qWarning().noquote() << QString("[FlagManager] %1 Flag-Defines nicht auswertbar (%2 Zyklen).")
+                                    .arg(unresolved)
+                                    .arg(evaluator.cycleCount());
 
     // Defaults injizieren
     applyDefaultWindowFlags();
@@ -221,7 +206,6 @@ void FlagManager::generateFlags(const QString& sourceDir,
     //
     // IMPORTANT PART (was previously missing)
     //
-    const QString configDir = QFileInfo(wndPath).absolutePath();
 
     // 1.) Rule templates erzeugen
     generateRuleTemplates(configDir);
@@ -230,7 +214,7 @@ void FlagManager::generateFlags(const QString& sourceDir,
     generateFlagGroups(configDir);
 
     // 3.) Fehlende Flags ergänzen
-    extendFlagGroups(configDir);
+    extendFlagGroups(configDir + "/flag_groups.json");
 }
 void FlagManager::generateRuleTemplates(const QString& configDir)
 {
@@ -325,7 +309,8 @@ void FlagManager::autoFillSemantics(const QString& ruleFilePath)
         return;
     }
 
-    QJsonObject root = doc.object();
+    const QJsonObject original = doc.object();
+    QJsonObject root = original;
 
     //
     // STARTE SEMANTIK-ERGÄNZUNG
@@ -362,14 +347,13 @@ void FlagManager::autoFillSemantics(const QString& ruleFilePath)
     }
 
     //
-    // JSON zurückschreiben
+    // JSON zurückschreiben (nur bei echter Änderung)
     //
-    file.open(QIODevice::WriteOnly | QIODevice::Text);
-    file.write(QJsonDocument(root).toJson(QJsonDocument::Indented));
-    file.close();
+    const bool written = writeJsonIfChanged(ruleFilePath, original, root);
 
     qInfo().noquote() << "[FlagManager] autoFillSemantics abgeschlossen für:"
-                      << QFileInfo(ruleFilePath).fileName();
+                      << QFileInfo(ruleFilePath).fileName()
+                      << (written ? "(aktualisiert)" : "(unverändert)");
 }
 
 void FlagManager::extendRuleFile(const QString& filePath,
@@ -386,7 +370,7 @@ void FlagManager::extendRuleFile(const QString& filePath,
         return;
     }
 
-    QJsonObject root;
+    QJsonObject original;
 
     // -----------------------------
     // Datei laden
@@ -394,10 +378,12 @@ void FlagManager::extendRuleFile(const QString& filePath,
     if (f.open(QIODevice::ReadOnly | QIODevice::Text)) {
         QByteArray data = f.readAll();
         QJsonDocument doc = QJsonDocument::fromJson(data);
-        root = doc.object();
+        original = doc.object();
         f.close();
     }
 
+    QJsonObject root = original;
+
     bool changed = false;
 
     // -----------------------------
@@ -430,13 +416,8 @@ void FlagManager::extendRuleFile(const QString& filePath,
     // -----------------------------
     // Änderungen speichern
     // -----------------------------
-    if (f.open(QIODevice::WriteOnly | QIODevice::Text)) {
-        f.write(QJsonDocument(root).toJson(QJsonDocument::Indented));
-        f.close();
+    if (writeJsonIfChanged(filePath, original, root))
         qInfo() << "[FlagManager] Aktualisiert:" << filePath;
-    } else {
-        qWarning() << "[FlagManager] Fehler beim Schreiben:" << filePath;
-    }
 }
 
 void FlagManager::initDefaultSemantics()
@@ -1052,6 +1033,21 @@ void FlagManager::initDefaultSemantics()
 
 }
 
+// Prefix → Control-Typ (gemeinsam für generate/extend)
+static QMap<QString, QStringList> controlTypePrefixes()
+{
+    QMap<QString, QStringList> typeFlagMap;
+
+    typeFlagMap["WTYPE_BUTTON"]   << "BS_";
+    typeFlagMap["WTYPE_EDIT"]     << "ES_" << "EBS_";
+    typeFlagMap["WTYPE_LISTBOX"]  << "LBS_";
+    typeFlagMap["WTYPE_LISTCTRL"] << "WLVS_";
+    typeFlagMap["WTYPE_TREE"]     << "WLVS_";
+    typeFlagMap["WTYPE_STATIC"]   << "SS_" << "WSS_";
+
+    return typeFlagMap;
+}
+
 void FlagManager::generateFlagGroups(const QString& configDir)
 {
     QString path = configDir + "/flag_groups.json";
@@ -1116,14 +1112,7 @@ void FlagManager::generateFlagGroups(const QString& configDir)
     //
 
     // Prefix → Typ
-    QMap<QString, QStringList> typeFlagMap;
-
-    typeFlagMap["WTYPE_BUTTON"]   << "BS_";
-    typeFlagMap["WTYPE_EDIT"]     << "ES_" << "EBS_";
-    typeFlagMap["WTYPE_LISTBOX"]  << "LBS_";
-    typeFlagMap["WTYPE_LISTCTRL"] << "WLVS_";
-    typeFlagMap["WTYPE_TREE"]     << "WLVS_";
-    typeFlagMap["WTYPE_STATIC"]   << "SS_" << "WSS_";
+    const QMap<QString, QStringList> typeFlagMap = controlTypePrefixes();
 
     // Default styles for all controls
     QJsonArray defaultWndFlags = QJsonArray{"WBS_CHILD","WBS_NOFRAME"};
@@ -1188,96 +1177,78 @@ void FlagManager::extendFlagGroups(const QString& groupsPath)
     if (!doc.isObject())
         return;
 
-    QJsonObject root = doc.object();
+    const QJsonObject original = doc.object();
+    QJsonObject root = original;
 
-    // alle Flags zusammenführen
-    QStringList allFlags = m_controlFlags.keys() + m_windowFlags.keys();
+    // "window"/"control" sind Objekte – nur die controlStyle-Listen
+    // der bekannten Control-Typen um neue Flags mit passendem Prefix ergänzen
+    const QMap<QString, QStringList> typeFlagMap = controlTypePrefixes();
+    QJsonObject controlObj = root.value("control").toObject();
+    int added = 0;
 
-    // Ergänzen
-    for (auto it = root.begin(); it != root.end(); ++it)
+    for (auto it = typeFlagMap.constBegin(); it != typeFlagMap.constEnd(); ++it)
     {
-        QString groupName = it.key();
-        QJsonArray arr = it.value().toArray();
+        QJsonObject entry = controlObj.value(it.key()).toObject();
+        QJsonArray ctrlFlags = entry.value("controlStyle").toArray();
 
-        QSet<QString> set;
-        for (const QJsonValue& v : arr)
-            set.insert(v.toString());
+        QSet<QString> present;
+        for (const QJsonValue& v : ctrlFlags)
+            present.insert(v.toString());
 
-        // automatisch Flags hinzufügen, deren Prefix passt
-        for (const QString& f : allFlags)
-            if (!set.contains(f) && groupName.contains("Style", Qt::CaseInsensitive))
-                set.insert(f);
+        for (auto f = m_controlFlags.constBegin(); f != m_controlFlags.constEnd(); ++f)
+        {
+            const QString& flag = f.key();
+            if (present.contains(flag))
+                continue;
 
-        // zurück in Array
-        QJsonArray newArr;
-        for (const QString& f : set)
-            newArr.append(f);
+            for (const QString& p : it.value())
+            {
+                if (flag.startsWith(p))
+                {
+                    ctrlFlags.append(flag);
+                    ++added;
+                    break;
+                }
+            }
+        }
 
-        root[groupName] = newArr;
+        if (!entry.contains("windowStyle"))
+            entry.insert("windowStyle", QJsonArray{"WBS_CHILD","WBS_NOFRAME"});
+        entry.insert("controlStyle", ctrlFlags);
+        controlObj.insert(it.key(), entry);
     }
 
-    // speichern
-    file.open(QIODevice::WriteOnly | QIODevice::Text);
-    file.write(QJsonDocument(root).toJson(QJsonDocument::Indented));
-    file.close();
+    root.insert("control", controlObj);
 
-    qInfo() << "[FlagManager] flag_groups.json erweitert.";
+    // speichern – nur wenn sich das Ergebnis vom Dateiinhalt unterscheidet
+    if (writeJsonIfChanged(groupsPath, original, root))
+        qInfo() << "[FlagManager] flag_groups.json erweitert:" << added << "neue Control-Flags";
 }
 // -------------------------------------------------------------
-// Standard-Window-Flags ergänzen (wenn nicht vorhanden)
+// Eingebaute Tabelle (DefaultFlags.h) → QString-Darstellung
 // -------------------------------------------------------------
-void FlagManager::applyDefaultWindowFlags()
+static QString defaultName(const DefaultFlag& f)
 {
-    static const QMap<QString, QString> defaults = {
-        {"WBS_CAPTION",       "0X02000000"},
-        {"WBS_CHILD",         "0X00020000"},
-        {"WBS_CHILDFRAME",    "0X00800000"},
-        {"WBS_DOCKING",       "0X04000000"},
-        {"WBS_EXTENSION",     "0X00000020"},
-        {"WBS_HELP",          "0X00000004"},
-        {"WBS_MOVE",          "0X00010000"},
-        {"WBS_MODAL",         "0X00080000"},
-        {"WBS_NOFOCUS",       "0X80000000"},
-        {"WBS_NOFRAME",       "0X00200000"},
-        {"WBS_NODRAWFRAME",   "0X00040000"},
-        {"WBS_TOPMOST",       "0X10000000"},
-        {"WBS_RESIZEABLE",    "0X00000040"},
-        {"WBS_THICKFRAME",    "0X00000040"},
-        {"WBS_POPUP",         "0X08000000"},
-        {"WBS_VSCROLL",       "0X20000000"},
-        {"WBS_HSCROLL",       "0X40000000"},
-        {"WBS_VIEW",          "0X00000008"},
-        {"WBS_PIN",           "0X00000010"},
-        {"WBS_MANAGER",       "0X00100000"},
-        {"WBS_KEY",           "0X01000000"},
-        {"WBS_SOUND",         "0X00400000"},
-        {"WBS_NOMENUICON",    "0X00000400"},
-        {"WBS_OVERRIDE_FIRST","0X00000040"},
-        {"WBS_NOCENTER",      "0X00000080"},
-        {"WBS_MAXIMIZEBOX",   "0X00000002"},
-        {"WBS_MINIMIZEBOX",   "0X00000001"}
-    };
+    return QString::fromLatin1(f.name.data(), qsizetype(f.name.size()));
+}
 
-    static const QMap<QString, QString> legacyDefaults = {
-        {"WBS_CHECK",         "0X00000008"},
-        {"WBS_PUSHLIKE",      "0X00000200"},
-        {"WBS_RADIO",         "0X00000004"},
-        {"WBS_MONEY",         "0X00000004"},
-        {"WBS_TEXT",          "0X00000001"},
-        {"WBS_SPRITE",        "0X00000002"},
-        {"WBS_MENUITEM",      "0X00000100"},
-        {"WBS_HIGHLIGHT",     "0X00000010"},
-        {"WBS_HIGHLIGHTPUSH", "0X00000020"},
-        {"WBS_NOCLOSE",       "0X00000080"} // eigentlich legacy
-    };
+static QString defaultHex(const DefaultFlag& f, const char* prefix)
+{
+    return QLatin1String(prefix) + QString("%1").arg(f.value, 8, 16, QLatin1Char('0')).toUpper();
+}
 
+// -------------------------------------------------------------
+// Standard-Window-Flags ergänzen (wenn nicht vorhanden)
+// -------------------------------------------------------------
+void FlagManager::applyDefaultWindowFlags()
+{
     int added = 0;
     int legacy = 0;
 
     // 🔹 Schritt 1: Legacy mit Override-Behandlung
-    for (auto it = legacyDefaults.constBegin(); it != legacyDefaults.constEnd(); ++it) {
-        const QString key = it.key();
-        const QString value = it.value();
+    DefaultFlags::forEach(FlagClass::LegacyWindow, [&](const DefaultFlag& f) {
+        const QString key = defaultName(f);
+        const QString value = defaultHex(f, "0X");
 
         if (m_legacyOverrides.contains(key)) {
             // Legacy-Flag bleibt aktiv (z. B. NOCLOSE)
@@ -1286,7 +1257,7 @@ void FlagManager::applyDefaultWindowFlags()
                 added++;
                 qInfo().noquote() << "[FlagManager] ⚙️ Legacy-Override aktiv:" << key;
             }
-            continue;
+            return;
         }
 
         // Normales Legacy-Flag speichern
@@ -1294,18 +1265,16 @@ void FlagManager::applyDefaultWindowFlags()
             m_legacyWindowFlags.insert(key, value);
             legacy++;
         }
-    }
-
-    // 🔹 Schritt 2: Aktive Defaults einfügen
-    for (auto it = defaults.constBegin(); it != defaults.constEnd(); ++it) {
-        const QString key = it.key();
-        const QString value = it.value();
+    });
 
+    // 🔹 Schritt 2: Aktive Defaults einfügen (gescannte Werte haben Vorrang)
+    DefaultFlags::forEach(FlagClass::Window, [&](const DefaultFlag& f) {
+        const QString key = defaultName(f);
         if (!m_windowFlags.contains(key)) {
-            m_windowFlags.insert(key, value);
+            m_windowFlags.insert(key, defaultHex(f, "0X"));
             added++;
         }
-    }
+    });
 
     // 🔹 Schritt 3: Sortieren (alphabetisch, case-insensitive)
     QStringList sortedKeys = m_windowFlags.keys();
@@ -1328,72 +1297,17 @@ void FlagManager::applyDefaultWindowFlags()
 
 void FlagManager::applyDefaultControlFlags()
 {
-    static const QMap<QString, QString> win32Defaults = {
-        // 🟦 Button Styles (BS_*)
-        {"BS_PUSHBUTTON",     "0x00000000"},
-        {"BS_DEFPUSHBUTTON",  "0x00000001"},
-        {"BS_CHECKBOX",       "0x00000002"},
-        {"BS_AUTOCHECKBOX",   "0x00000003"},
-        {"BS_RADIOBUTTON",    "0x00000004"},
-        {"BS_3STATE",         "0x00000005"},
-        {"BS_AUTO3STATE",     "0x00000006"},
-        {"BS_GROUPBOX",       "0x00000007"},
-        {"BS_AUTORADIOBUTTON","0x00000009"},
-        {"BS_ICON",           "0x00000040"},
-        {"BS_BITMAP",         "0x00000080"},
-        {"BS_LEFT",           "0x00000100"},
-        {"BS_RIGHT",          "0x00000200"},
-        {"BS_TOP",            "0x00000400"},
-        {"BS_BOTTOM",         "0x00000800"},
-        {"BS_VCENTER",        "0x00000C00"},
-
-        // 🟩 Edit Styles (ES_*)
-        {"ES_LEFT",           "0x0000"},
-        {"ES_CENTER",         "0x0001"},
-        {"ES_RIGHT",          "0x0002"},
-        {"ES_MULTILINE",      "0x0004"},
-        {"ES_PASSWORD",       "0x0020"},
-        {"ES_AUTOVSCROLL",    "0x0040"},
-        {"ES_AUTOHSCROLL",    "0x0080"},
-        {"ES_NOHIDESEL",      "0x0100"},
-        {"ES_OEMCONVERT",     "0x0400"},
-        {"ES_READONLY",       "0x0800"},
-        {"ES_WANTRETURN",     "0x1000"},
-        {"ES_NUMBER",         "0x2000"},
-
-        // 🟨 Static Styles (SS_*)
-        {"SS_LEFT",           "0x00000000"},
-        {"SS_CENTER",         "0x00000001"},
-        {"SS_RIGHT",          "0x00000002"},
-        {"SS_ICON",           "0x00000003"},
-        {"SS_BITMAP",         "0x0000000E"},
-        {"SS_NOTIFY",         "0x00000100"},
-
-        // 🟥 ListBox Styles (LBS_*)
-        {"LBS_NOTIFY",        "0x0001"},
-        {"LBS_SORT",          "0x0002"},
-        {"LBS_NOREDRAW",      "0x0004"},
-        {"LBS_MULTIPLESEL",   "0x0008"},
-        {"LBS_OWNERDRAWFIXED","0x0010"},
-        {"LBS_OWNERDRAWVARIABLE","0x0020"},
-        {"LBS_HASSTRINGS",    "0x0040"},
-        {"LBS_USETABSTOPS",   "0x0080"},
-        {"LBS_NOINTEGRALHEIGHT","0x0100"},
-        {"LBS_MULTICOLUMN",   "0x0200"},
-        {"LBS_WANTKEYBOARDINPUT","0x0400"},
-        {"LBS_EXTENDEDSEL",   "0x0800"},
-        {"LBS_DISABLENOSCROLL","0x1000"}
-    };
-
     int added = 0;
-    for (auto it = win32Defaults.constBegin(); it != win32Defaults.constEnd(); ++it) {
-        if (!m_controlFlags.contains(it.key())) {
-            m_controlFlags.insert(it.key(), it.value());
+    DefaultFlags::forEach(FlagClass::Control, [&](const DefaultFlag& f) {
+        const QString key = defaultName(f);
+        if (!m_controlFlags.contains(key)) {
+            const QString value = defaultHex(f, "0x");
+            m_controlFlags.insert(key, value);
             qInfo() << "[FlagManager] Default Win32 Control-Flag ergänzt:"
-                    << it.key() << "=" << it.value();
+                    << key << "=" << value;
             ++added;
         }
-    }
+    });
 
     qInfo() << QString("[FlagManager] Default ControlFlags hinzugefügt: %1 neu, gesamt: %2")
                    .arg(added)
@@ -1405,23 +1319,13 @@ void FlagManager::applyDefaultControlFlags()
 // -------------------------------------------------------------
 void FlagManager::applyDefaultWindowTypes()
 {
-    static const QMap<QString, QString> defaults = {
-        {"WTYPE_NONE",      "0x00000000"},
-        {"WTYPE_BASE",      "0x00000001"},
-        {"WTYPE_STATIC",    "0x00000002"},
-        {"WTYPE_BUTTON",    "0x00000003"},
-        {"WTYPE_EDIT",      "0x00000004"},
-        {"WTYPE_SCROLLBAR", "0x00000005"},
-        {"WTYPE_LISTBOX",   "0x00000006"},
-        {"WTYPE_CUSTOM",    "0x00000007"}
-    };
-
-    for (auto it = defaults.constBegin(); it != defaults.constEnd(); ++it) {
-        if (!m_windowTypes.contains(it.key())) {
-            m_windowTypes[it.key()] = it.value();
-            qInfo() << "[FlagManager] Default Window-Type ergänzt:" << it.key() << "=" << it.value();
+    DefaultFlags::forEach(FlagClass::WindowType, [&](const DefaultFlag& f) {
+        const QString key = defaultName(f);
+        if (!m_windowTypes.contains(key)) {
+            m_windowTypes[key] = defaultHex(f, "0x");
+            qInfo() << "[FlagManager] Default Window-Type ergänzt:" << key << "=" << m_windowTypes[key];
         }
-    }
+    });
 }
 
 // -------------------------------------------------------------
@@ -47,8 +47,8 @@ private:
     // Hilfsfunktionen
     // ------------------------------------------------------------
 
-    /// durchsucht eine Header-Datei nach relevanten Defines
-    void parseHeaderFile(const QString& filePath);
+    /// übernimmt ein ausgewertetes #define, falls relevant
+    void applyHeaderDefine(const QString& key, quint32 numeric);
 
     /// ergänzt Standard-Fenster-Flags (falls im Code nicht gefunden)
     void applyDefaultWindowFlags();
@@ -0,0 +1,295 @@
+#include "HeaderScanner.h"
+
+#include <QtConcurrent/QtConcurrent>
+#include <QDataStream>
+#include <QDateTime>
+#include <QDirIterator>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QDebug>
+
+#include <algorithm>
+#include <cstring>
+
+namespace {
+constexpr quint32 ManifestMagic   = 0x464C4D31;   // "FLM1"
+constexpr quint32 ManifestVersion = 1;
+
+inline bool isBlank(char c)      { return c == ' ' || c == '\t'; }
+inline bool isIdentStart(char c) { return (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z') || c == '_'; }
+inline bool isIdentChar(char c)  { return isIdentStart(c) || (c >= '0' && c <= '9'); }
+}
+
+HeaderScanner::HeaderScanner(const QString& manifestPath)
+    : m_manifestPath(manifestPath)
+{
+}
+
+// =============================================================
+// Lexer: "#define NAME value" (objektartig, ohne Parameterliste)
+// =============================================================
+QVector<HeaderDefine> HeaderScanner::lexDefines(const char* data, qint64 size)
+{
+    QVector<HeaderDefine> out;
+
+    const char* p   = data;
+    const char* end = data + size;
+
+    QByteArray value;
+
+    while (p < end)
+    {
+        // --- Zeilenanfang ---
+        while (p < end && isBlank(*p)) ++p;
+
+        if (p < end && *p == '#')
+        {
+            ++p;
+            while (p < end && isBlank(*p)) ++p;
+
+            if (end - p > 6 && std::memcmp(p, "define", 6) == 0 && isBlank(p[6]))
+            {
+                p += 6;
+                while (p < end && isBlank(*p)) ++p;
+
+                const char* nameBegin = p;
+                if (p < end && isIdentStart(*p)) {
+                    while (p < end && isIdentChar(*p)) ++p;
+                }
+                const char* nameEnd = p;
+
+                // Funktionsartige Makros (NAME( ...) überspringen
+                const bool functionLike = (p < end && *p == '(');
+
+                if (nameEnd > nameBegin && !functionLike)
+                {
+                    // --- Wert bis Zeilenende (inkl. '\' Fortsetzung), Kommentare raus ---
+                    value.clear();
+                    bool quoted = false;
+
+                    while (p < end && *p != '\n')
+                    {
+                        const char c = *p;
+
+                        if (c == '\\' && p + 1 < end && (p[1] == '\n' || p[1] == '\r')) {
+                            p += (p[1] == '\r' && p + 2 < end && p[2] == '\n') ? 3 : 2;
+                            value += ' ';
+                            continue;
+                        }
+                        if (c == '/' && p + 1 < end && p[1] == '/')
+                            break;
+                        if (c == '/' && p + 1 < end && p[1] == '*') {
+                            p += 2;
+                            while (p + 1 < end && !(p[0] == '*' && p[1] == '/'))
+                                ++p;
+                            p = qMin(end, p + 2);
+                            value += ' ';
+                            continue;
+                        }
+                        if (c == '"' || c == '\'')
+                            quoted = true;
+                        if (c != '\r')
+                            value += c;
+                        ++p;
+                    }
+
+                    const QByteArray trimmed = value.trimmed();
+                    if (!quoted && !trimmed.isEmpty()) {
+                        out.append({ QString::fromLatin1(nameBegin, int(nameEnd - nameBegin)),
+                                     QString::fromLatin1(trimmed) });
+                    }
+                }
+            }
+        }
+
+        // --- Rest der Zeile überspringen ---
+        const void* nl = std::memchr(p, '\n', size_t(end - p));
+        p = nl ? static_cast<const char*>(nl) + 1 : end;
+    }
+
+    return out;
+}
+
+// =============================================================
+// Manifest laden / speichern (QDataStream, binär)
+// =============================================================
+bool HeaderScanner::loadManifest()
+{
+    m_manifest.clear();
+
+    QFile f(m_manifestPath);
+    if (m_manifestPath.isEmpty() || !f.open(QIODevice::ReadOnly))
+        return false;
+
+    QDataStream in(&f);
+    in.setVersion(QDataStream::Qt_6_0);
+
+    quint32 magic = 0, version = 0;
+    qint32 count = 0;
+    in >> magic >> version >> count;
+    if (magic != ManifestMagic || version != ManifestVersion || count < 0)
+        return false;
+
+    m_manifest.reserve(count);
+    for (qint32 i = 0; i < count && in.status() == QDataStream::Ok; ++i)
+    {
+        HeaderFileScan e;
+        qint32 defCount = 0;
+        in >> e.path >> e.size >> e.mtime >> e.hash >> defCount;
+
+        e.defines.reserve(qMax(0, defCount));
+        for (qint32 d = 0; d < defCount && in.status() == QDataStream::Ok; ++d) {
+            HeaderDefine def;
+            in >> def.name >> def.value;
+            e.defines.append(def);
+        }
+        m_manifest.insert(e.path, e);
+    }
+
+    if (in.status() != QDataStream::Ok) {
+        qWarning() << "[HeaderScanner] Manifest beschädigt – vollständiger Scan:" << m_manifestPath;
+        m_manifest.clear();
+        return false;
+    }
+    return true;
+}
+
+bool HeaderScanner::saveManifest() const
+{
+    if (m_manifestPath.isEmpty())
+        return false;
+
+    QSaveFile f(m_manifestPath);
+    if (!f.open(QIODevice::WriteOnly)) {
+        qWarning() << "[HeaderScanner] Manifest nicht schreibbar:" << m_manifestPath;
+        return false;
+    }
+
+    QDataStream out(&f);
+    out.setVersion(QDataStream::Qt_6_0);
+    out << ManifestMagic << ManifestVersion << qint32(m_manifest.size());
+
+    for (const HeaderFileScan& e : m_manifest) {
+        out << e.path << e.size << e.mtime << e.hash << qint32(e.defines.size());
+        for (const HeaderDefine& d : e.defines)
+            out << d.name << d.value;
+    }
+
+    return f.commit();
+}
+
+// =============================================================
+// Scan
+// =============================================================
+QVector<HeaderDefine> HeaderScanner::scan(const QString& sourceDir)
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    m_stats = Stats{};
+    loadManifest();
+
+    // 1) Dateiliste + stat (QDirIterator liefert QFileInfo ohne Extra-Syscall)
+    QVector<HeaderFileScan> current;
+    QDirIterator it(sourceDir, QStringList() << "*.h", QDir::Files, QDirIterator::Subdirectories);
+    while (it.hasNext()) {
+        it.next();
+        const QFileInfo fi = it.fileInfo();
+
+        HeaderFileScan e;
+        e.path  = fi.absoluteFilePath();
+        e.size  = fi.size();
+        e.mtime = fi.lastModified().toMSecsSinceEpoch();
+        current.append(e);
+    }
+
+    std::sort(current.begin(), current.end(),
+              [](const HeaderFileScan& a, const HeaderFileScan& b) { return a.path < b.path; });
+
+    // 2) Unveränderte Einträge übernehmen, Rest zum Parsen vormerken
+    QVector<int> dirty;
+    for (int i = 0; i < current.size(); ++i) {
+        auto old = m_manifest.constFind(current[i].path);
+        if (old != m_manifest.constEnd()
+            && old->size == current[i].size && old->mtime == current[i].mtime) {
+            current[i].hash    = old->hash;
+            current[i].defines = old->defines;
+        } else {
+            dirty.append(i);
+        }
+    }
+
+    // 3) Geänderte Dateien parallel einblenden + lexen
+    const QHash<QString, HeaderFileScan>& manifest = m_manifest;
+
+    auto parseOne = [&current, &manifest](int index) {
+        HeaderFileScan e = current[index];
+
+        QFile f(e.path);
+        if (!f.open(QIODevice::ReadOnly)) {
+            qWarning() << "[HeaderScanner] Header nicht lesbar:" << e.path;
+            e.readOk = false;
+            return e;
+        }
+
+        const qint64 size = f.size();
+        if (size <= 0)
+            return e;
+
+        uchar* mapped = f.map(0, size);
+        QByteArray fallback;
+        const char* data = reinterpret_cast<const char*>(mapped);
+        if (!mapped) {
+            fallback = f.readAll();
+            data = fallback.constData();
+        }
+
+        e.hash = qHashBits(data, size_t(size));
+
+        // Nur mtime geändert (touch / checkout) → Defines wiederverwenden
+        auto old = manifest.constFind(e.path);
+        if (old != manifest.constEnd() && old->hash == e.hash)
+            e.defines = old->defines;
+        else
+            e.defines = HeaderScanner::lexDefines(data, size);
+
+        if (mapped)
+            f.unmap(mapped);
+        return e;
+    };
+
+    const QVector<HeaderFileScan> parsed = QtConcurrent::blockingMapped(dirty, parseOne);
+    for (int i = 0; i < dirty.size(); ++i)
+        current[dirty[i]] = parsed[i];
+
+    // 4) Manifest aktualisieren (entfernte Dateien fallen heraus)
+    const bool removed = m_manifest.size() + dirty.size() != current.size();
+    m_manifest.clear();
+    m_manifest.reserve(current.size());
+    QVector<HeaderDefine> result;
+    for (const HeaderFileScan& e : current) {
+        if (e.readOk)
+            m_manifest.insert(e.path, e);
+        result += e.defines;
+    }
+
+    if (!dirty.isEmpty() || removed)
+        saveManifest();
+
+    m_stats.files     = current.size();
+    m_stats.parsed    = dirty.size();
+    m_stats.reused    = current.size() - dirty.size();
+    m_stats.elapsedMs = timer.elapsed();
+
+    qInfo().noquote()
+        << QString("[HeaderScanner] %1 Header, %2 neu gelesen, %3 aus Manifest, %4 Defines in %5 ms")
+               .arg(m_stats.files)
+               .arg(m_stats.parsed)
+               .arg(m_stats.reused)
+               .arg(result.size())
+               .arg(m_stats.elapsedMs);
+
+    return result;
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <QHash>
+#include <QString>
+#include <QVector>
+
+// ------------------------------------------------------------
+// Ein #define aus einem Header (Wert = roher Ausdruckstext)
+// ------------------------------------------------------------
+struct HeaderDefine
+{
+    QString name;
+    QString value;
+};
+
+// ------------------------------------------------------------
+// Manifest-Eintrag pro Header-Datei
+// ------------------------------------------------------------
+struct HeaderFileScan
+{
+    QString path;
+    qint64  size  = 0;
+    qint64  mtime = 0;      // ms seit Epoch
+    quint64 hash  = 0;      // Inhalts-Hash (qHashBits)
+    QVector<HeaderDefine> defines;
+    bool    readOk = true;  // false = nicht lesbar → nicht ins Manifest, nächster Scan versucht es erneut
+};
+
+// ------------------------------------------------------------
+// HeaderScanner
+// ------------------------------------------------------------
+// Sammelt alle objektartigen #defines unter einem Source-Ordner.
+//  - Dateien werden per QFile::map() eingeblendet und mit einem
+//    einfachen Byte-Lexer gelesen (kein QTextStream, keine Regex)
+//  - geänderte Dateien werden parallel (QtConcurrent) geparst
+//  - ein Manifest (Pfad, Größe, mtime, Hash + Defines) erlaubt es,
+//    bei der nächsten Generierung nur geänderte Header neu zu lesen
+// ------------------------------------------------------------
+class HeaderScanner
+{
+public:
+    struct Stats {
+        int files  = 0;     // gefundene Header
+        int parsed = 0;     // neu gelext
+        int reused = 0;     // aus Manifest übernommen
+        qint64 elapsedMs = 0;
+    };
+
+    explicit HeaderScanner(const QString& manifestPath);
+
+    // Alle Defines aller Header, nach Pfad sortiert (stabile Reihenfolge)
+    QVector<HeaderDefine> scan(const QString& sourceDir);
+
+    const Stats& lastStats() const { return m_stats; }
+
+    // Lexer – öffentlich, damit auch einzelne Puffer gelesen werden können
+    static QVector<HeaderDefine> lexDefines(const char* data, qint64 size);
+
+private:
+    bool loadManifest();
+    bool saveManifest() const;
+
+    QString m_manifestPath;
+    QHash<QString, HeaderFileScan> m_manifest;
+    Stats m_stats;
+};
@@ -0,0 +1,231 @@
+#include "IdAllocator.h"
+
+#include <bit>
+
+void IdAllocator::clear()
+{
+    m_pages.clear();
+    m_cursor.clear();
+    m_pageRanges.clear();
+    m_used = 0;
+}
+
+bool IdAllocator::mark(quint32 value)
+{
+    Page& page = m_pages[value >> kPageBits];
+    quint64& word = page.words[(value & (kPageSize - 1)) >> 6];
+    const quint64 bit = quint64(1) << (value & 63);
+
+    if (word & bit)
+        return false;
+
+    word |= bit;
+    ++page.used;
+    ++m_used;
+    return true;
+}
+
+void IdAllocator::release(quint32 value)
+{
+    const quint32 pageIndex = value >> kPageBits;
+    auto it = m_pages.find(pageIndex);
+    if (it == m_pages.end())
+        return;
+
+    quint64& word = it->words[(value & (kPageSize - 1)) >> 6];
+    const quint64 bit = quint64(1) << (value & 63);
+    if (!(word & bit))
+        return;
+
+    word &= ~bit;
+    --m_used;
+
+    if (--it->used == 0) {
+        // Seite leer → Zuordnung lösen, Cursor ohne Seiten verwerfen
+        // (nächste Vergabe beginnt dort wieder bei range.first)
+        m_pages.erase(it);
+        for (quint64 key : m_pageRanges.take(pageIndex)) {
+            auto c = m_cursor.find(key);
+            if (c != m_cursor.end() && --c->pages == 0)
+                m_cursor.erase(c);
+        }
+        return;
+    }
+
+    // Freigegebene ID bei der nächsten Vergabe wiederverwenden – nur
+    // Bereiche, die in dieser Seite vergeben haben
+    auto owners = m_pageRanges.constFind(pageIndex);
+    if (owners == m_pageRanges.constEnd())
+        return;
+
+    for (quint64 key : *owners) {
+        auto c = m_cursor.find(key);
+        if (c != m_cursor.end() && rangeOf(key).contains(value) && c->next > value)
+            c->next = value;
+    }
+}
+
+bool IdAllocator::isUsed(quint32 value) const
+{
+    auto it = m_pages.constFind(value >> kPageBits);
+    if (it == m_pages.constEnd())
+        return false;
+    return it->words[(value & (kPageSize - 1)) >> 6] & (quint64(1) << (value & 63));
+}
+
+// --------------------------------------------------
+// Suche
+// --------------------------------------------------
+std::optional<quint32> IdAllocator::findFree(quint64 from, quint64 to) const
+{
+    quint64 v = from;
+    while (v <= to)
+    {
+        const quint32 pageIndex = quint32(v >> kPageBits);
+        const quint64 nextPage = (quint64(pageIndex) + 1) << kPageBits;
+
+        auto it = m_pages.constFind(pageIndex);
+        if (it == m_pages.constEnd())
+            return quint32(v);              // Seite leer → v ist frei
+
+        if (it->used == int(kPageSize)) {
+            v = nextPage;                   // volle Seite überspringen
+            continue;
+        }
+
+        int w = int((v & (kPageSize - 1)) >> 6);
+        quint64 mask = ~quint64(0) << (v & 63);
+        for (; w < kPageWords; ++w, mask = ~quint64(0))
+        {
+            const quint64 freeBits = ~it->words[size_t(w)] & mask;
+            if (!freeBits)
+                continue;
+
+            const quint64 candidate = (quint64(pageIndex) << kPageBits)
+                                    | (quint64(w) << 6)
+                                    | quint64(std::countr_zero(freeBits));
+            if (candidate > to)
+                return std::nullopt;
+            return quint32(candidate);
+        }
+
+        v = nextPage;
+    }
+    return std::nullopt;
+}
+
+std::optional<quint32> IdAllocator::findFreeRun(quint64 from, quint64 to, int count) const
+{
+    quint64 v = from;
+    while (true)
+    {
+        const auto start = findFree(v, to);
+        if (!start)
+            return std::nullopt;
+
+        const quint64 end = quint64(*start) + quint64(count) - 1;
+        if (end > to)
+            return std::nullopt;
+
+        quint64 blocked = 0;
+        for (quint64 u = quint64(*start) + 1; u <= end; ++u) {
+            if (isUsed(quint32(u))) {
+                blocked = u;
+                break;
+            }
+        }
+        if (!blocked)
+            return start;
+
+        v = blocked + 1;
+    }
+}
+
+// --------------------------------------------------
+// Cursor
+// --------------------------------------------------
+quint32 IdAllocator::cursorStart(const IdRange& range) const
+{
+    auto it = m_cursor.constFind(rangeKey(range));
+    if (it == m_cursor.constEnd() || !range.contains(it->next))
+        return range.first;
+    return it->next;
+}
+
+void IdAllocator::advanceCursor(const IdRange& range, quint32 first, quint32 last)
+{
+    const quint64 key = rangeKey(range);
+    Cursor& c = m_cursor[key];
+    c.next = last < range.last ? last + 1 : range.first;
+
+    for (quint32 page = first >> kPageBits; ; ++page) {
+        QVector<quint64>& owners = m_pageRanges[page];
+        if (!owners.contains(key)) {
+            owners.append(key);
+            ++c.pages;
+        }
+        if (page == last >> kPageBits)
+            break;
+    }
+}
+
+// --------------------------------------------------
+// Vergabe
+// --------------------------------------------------
+std::optional<quint32> IdAllocator::allocate(const IdRange& range)
+{
+    if (range.first > range.last)
+        return std::nullopt;
+
+    const quint32 start = cursorStart(range);
+
+    auto id = findFree(start, range.last);
+    if (!id && start > range.first)
+        id = findFree(range.first, quint64(start) - 1);
+    if (!id)
+        return std::nullopt;
+
+    mark(*id);
+    advanceCursor(range, *id, *id);
+    return id;
+}
+
+QVector<quint32> IdAllocator::allocate(int count, const IdRange& range, bool contiguous)
+{
+    QVector<quint32> ids;
+    if (count <= 0 || range.first > range.last)
+        return ids;
+
+    ids.reserve(count);
+
+    if (!contiguous)
+    {
+        for (int i = 0; i < count; ++i) {
+            const auto id = allocate(range);
+            if (!id) {
+                // Bereich reicht nicht → nichts halb belegt zurücklassen
+                for (quint32 taken : ids)
+                    release(taken);
+                return {};
+            }
+            ids.append(*id);
+        }
+        return ids;
+    }
+
+    const quint32 start = cursorStart(range);
+
+    auto first = findFreeRun(start, range.last, count);
+    if (!first && start > range.first)
+        first = findFreeRun(range.first, range.last, count);
+    if (!first)
+        return ids;
+
+    for (int i = 0; i < count; ++i) {
+        mark(*first + quint32(i));
+        ids.append(*first + quint32(i));
+    }
+
+    advanceCursor(range, ids.front(), ids.back());
+    return ids;
+}
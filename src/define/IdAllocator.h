@@ -0,0 +1,82 @@
+#pragma once
+
+#include <QHash>
+#include <QVector>
+#include <QtGlobal>
+#include <array>
+#include <optional>
+
+// ------------------------------------------------------------
+// Wertebereich für die ID-Vergabe (inklusive Grenzen)
+// ------------------------------------------------------------
+struct IdRange
+{
+    quint32 first = 1;
+    quint32 last  = 0xFFFFFFFFu;
+
+    bool contains(quint32 v) const { return v >= first && v <= last; }
+};
+
+// ------------------------------------------------------------
+// IdAllocator – Bitmap der belegten Define-Werte
+// ------------------------------------------------------------
+// Seitenweise Bitmap (4096 Werte pro Seite, nur belegte Seiten
+// existieren), damit auch Ausreißer wie 0x80000000 keinen Speicher
+// kosten. Volle Seiten werden übersprungen, innerhalb einer Seite
+// findet countr_zero das nächste freie Bit. Pro Bereich merkt sich
+// ein Cursor die letzte Vergabe → amortisiert O(1).
+//
+// Jede Seite kennt die Bereiche, die in ihr vergeben haben. release()
+// senkt nur deren Cursor (statt alle Bereiche zu prüfen); wird eine
+// Seite leer, fallen Cursor ohne weitere Seiten weg.
+// ------------------------------------------------------------
+class IdAllocator
+{
+public:
+    void clear();
+
+    // true, wenn der Wert vorher frei war
+    bool mark(quint32 value);
+    void release(quint32 value);
+    bool isUsed(quint32 value) const;
+
+    int usedCount() const { return m_used; }
+
+    // Nächste freie ID im Bereich (wird sofort belegt)
+    std::optional<quint32> allocate(const IdRange& range);
+
+    // Mehrere IDs auf einmal (z. B. eingefügte Control-Gruppen);
+    // contiguous = lückenloser Block. Leer, wenn der Bereich nicht reicht.
+    QVector<quint32> allocate(int count, const IdRange& range, bool contiguous = false);
+
+private:
+    static constexpr int     kPageBits  = 12;
+    static constexpr quint32 kPageSize  = 1u << kPageBits;
+    static constexpr int     kPageWords = int(kPageSize / 64);
+
+    struct Page {
+        std::array<quint64, kPageWords> words{};
+        int used = 0;
+    };
+
+    // Erster freier Wert in [from, to] oder nullopt
+    std::optional<quint32> findFree(quint64 from, quint64 to) const;
+    std::optional<quint32> findFreeRun(quint64 from, quint64 to, int count) const;
+
+    struct Cursor {
+        quint32 next = 0;               // nächster Startwert
+        int pages = 0;                  // Seiten, in denen der Bereich vergeben hat
+    };
+
+    static quint64 rangeKey(const IdRange& r) { return (quint64(r.first) << 32) | r.last; }
+    static IdRange rangeOf(quint64 key) { return { quint32(key >> 32), quint32(key) }; }
+
+    quint32 cursorStart(const IdRange& range) const;
+    // Cursor hinter [first, last] setzen und die Seiten dem Bereich zuordnen
+    void advanceCursor(const IdRange& range, quint32 first, quint32 last);
+
+    QHash<quint32, Page>             m_pages;       // Seitenindex → Bits
+    QHash<quint64, Cursor>           m_cursor;      // Bereich → Cursor
+    QHash<quint32, QVector<quint64>> m_pageRanges;  // Seitenindex → Bereiche mit Vergaben dort
+    int m_used = 0;
+};
@@ -83,6 +83,21 @@ QJsonObject LayoutBackend::loadControlFlagRules()
     return loadControlFlagRules(m_fileManager->controlFlagRulesPath());
 }
 
+QJsonObject LayoutBackend::loadBehaviorConfig()
+{
+    if (!m_fileManager)
+    {
+        qWarning() << "[LayoutBackend] Kein FileManager gesetzt für loadBehaviorConfig()";
+        return {};
+    }
+
+    // Optionale Datei – fehlt sie, gibt es einfach keine Overrides
+    const QString path = m_fileManager->behaviorConfigPath();
+    if (!QFileInfo::exists(path))
+        return {};
+
+    return loadBehaviorConfig(path);
+}
 
 bool LayoutBackend::saveControlFlagRules(const QJsonObject& json)
 {
@@ -133,6 +148,41 @@ QJsonObject LayoutBackend::loadWindowTypes(const QString& path)
     return m_fileManager ? m_fileManager->loadJsonObject(path) : QJsonObject{};
 }
 
+QJsonObject LayoutBackend::loadFlagGroups()
+{
+    if (!m_fileManager)
+    {
+        qWarning() << "[LayoutBackend] Kein FileManager gesetzt für loadFlagGroups()";
+        return {};
+    }
+
+    // Wird beim ersten Start von FlagManager::generateFlagGroups() erzeugt
+    const QString path = m_fileManager->flagGroupsPath();
+    if (!QFileInfo::exists(path))
+        return {};
+
+    return m_fileManager->loadJsonObject(path);
+}
+
+QString LayoutBackend::flagDatabasePath() const
+{
+    return m_fileManager ? m_fileManager->flagDatabasePath() : QString();
+}
+
+QStringList LayoutBackend::flagSourcePaths() const
+{
+    if (!m_fileManager)
+        return {};
+
+    return {
+        m_fileManager->windowFlagsPath(),
+        m_fileManager->controlFlagsPath(),
+        m_fileManager->windowFlagRulesPath(),
+        m_fileManager->controlFlagRulesPath(),
+        m_fileManager->flagGroupsPath()
+    };
+}
+
 QJsonObject LayoutBackend::loadWindowFlagRules(const QString& path)
 {
     return m_fileManager ? m_fileManager->loadJsonObject(path) : QJsonObject{};
@@ -143,6 +193,11 @@ QJsonObject LayoutBackend::loadControlFlagRules(const QString& path)
     return m_fileManager ? m_fileManager->loadJsonObject(path) : QJsonObject{};
 }
 
+QJsonObject LayoutBackend::loadBehaviorConfig(const QString& path)
+{
+    return m_fileManager ? m_fileManager->loadJsonObject(path) : QJsonObject{};
+}
+
 QJsonObject LayoutBackend::loadUndefinedControlFlags(const QString& path)
 {
     return m_fileManager ? m_fileManager->loadJsonObject(path) : QJsonObject{};
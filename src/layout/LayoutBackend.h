@@ -1,6 +1,7 @@
 #pragma once
 #include <QString>
 #include <QJsonObject>
+#include <QStringList>
 #include "LayoutParser.h"
 
 class FileManager;
@@ -30,6 +31,12 @@ public:
     QJsonObject loadWindowTypes();
     QJsonObject loadWindowFlagRules();
     QJsonObject loadControlFlagRules();
+    QJsonObject loadBehaviorConfig();
+    QJsonObject loadFlagGroups();
+
+    // Binäre Flag-Datenbank + ihre JSON-Quellen (Reihenfolge = Hash-Reihenfolge)
+    QString flagDatabasePath() const;
+    QStringList flagSourcePaths() const;
 
     // Regeldateien speichern (Manager liefert JSON)
     bool saveWindowFlagRules(const QJsonObject& json);
@@ -55,6 +62,7 @@ private:
 
     QJsonObject loadWindowFlagRules(const QString& path);
     QJsonObject loadControlFlagRules(const QString& path);
+    QJsonObject loadBehaviorConfig(const QString& path);
 
     QJsonObject loadUndefinedControlFlags(const QString& path);
     bool saveUndefinedControlFlags(const QString& path, const QJsonObject& json);
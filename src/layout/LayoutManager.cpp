@@ -8,6 +8,8 @@
 
 #include <QDebug>
 #include <QRegularExpression>
+#include <QElapsedTimer>
+#include <QTimer>
 
 // -------------------------------------------------------------
 // Hilfsfunktion
@@ -28,6 +30,12 @@ LayoutManager::LayoutManager(LayoutParser& parser, LayoutBackend& backend)
 {
     connect(&m_parser, &LayoutParser::tokensReady,
             this, &LayoutManager::tokensReady);
+
+    // Timeout 0 → läuft nur, wenn die Event-Queue leer ist
+    m_resolveTimer = new QTimer(this);
+    m_resolveTimer->setInterval(0);
+    connect(m_resolveTimer, &QTimer::timeout,
+            this, &LayoutManager::resolveNextSlice);
 }
 
 // -------------------------------------------------------------
@@ -35,6 +43,9 @@ LayoutManager::LayoutManager(LayoutParser& parser, LayoutBackend& backend)
 // -------------------------------------------------------------
 void LayoutManager::refreshFromParser()
 {
+    m_resolveTimer->stop();
+    m_resolveCursor = 0;
+    m_unresolved = 0;
     m_windows.clear();
 
     const auto tokenMap = TokenData::instance().all();
@@ -260,6 +271,11 @@ void LayoutManager::refreshFromParser()
 // -------------------------------------------------------------
 // Layout verarbeiten (ruft BehaviorManager)
 // -------------------------------------------------------------
+namespace {
+// Zeitbudget pro Hintergrund-Häppchen – hält die UI flüssig
+constexpr qint64 ResolveSliceBudgetMs = 8;
+}
+
 void LayoutManager::processLayout()
 {
     qInfo() << "[LayoutManager] Verarbeite Layouts...";
@@ -270,31 +286,139 @@ void LayoutManager::processLayout()
         return;
     }
 
+    // Behavior wird erst bei Bedarf aufgelöst (Auswahl / Rendern / Abfrage)
+    m_unresolved = 0;
     for (auto& wndPtr : m_windows)
     {
         if (!wndPtr) continue;
+        wndPtr->behaviorResolved = false;
+        ++m_unresolved;
+    }
+
+    // Nachgelagerte Analysen (arbeiten nur auf Flag-Masken)
+    m_behaviorManager->analyzeControlTypes(m_windows);
+    m_behaviorManager->generateUnknownControls(m_windows);
+
+    // Rest im Leerlauf nachziehen
+    m_resolveCursor = 0;
+    if (m_unresolved > 0)
+        m_resolveTimer->start();
 
-        // 1) Window-Flags validieren
-        m_behaviorManager->validateWindowFlags(wndPtr.get());
+    qInfo().noquote()
+        << QString("[LayoutManager] Layout bereit – Behavior für %1 Fenster wird lazy aufgelöst.")
+               .arg(m_unresolved);
+}
+
+// -------------------------------------------------------------
+// Lazy Behavior-Auflösung
+// -------------------------------------------------------------
+void LayoutManager::resolveWindow(WindowData& wnd)
+{
+    // 1) Window-Flags validieren + BehaviorInfo erzeugen
+    m_behaviorManager->validateWindowFlags(&wnd);
 
-        // 2) BehaviorInfo für Fenster erzeugen
-        wndPtr->behavior = m_behaviorManager->resolveBehavior(*wndPtr);
+    BehaviorInfo wndInfo = m_behaviorManager->resolveBehavior(wnd);
+    wnd.behavior = wndInfo;
+
+    // 2) Controls
+    for (auto& ctrlPtr : wnd.controls)
+    {
+        if (!ctrlPtr) continue;
+
+        m_behaviorManager->validateControlFlags(ctrlPtr.get());
+
+        BehaviorInfo info = m_behaviorManager->resolveBehavior(*ctrlPtr);
+        ctrlPtr->behavior = info;
+    }
+
+    wnd.behaviorResolved = true;
+    --m_unresolved;
+}
+
+bool LayoutManager::ensureBehaviorResolved(const std::shared_ptr<WindowData>& wnd)
+{
+    if (!wnd || wnd->behaviorResolved || !m_behaviorManager)
+        return false;
+
+    resolveWindow(*wnd);
+    return true;
+}
+
+void LayoutManager::ensureAllBehaviorsResolved()
+{
+    if (!m_behaviorManager || m_unresolved <= 0)
+        return;
+
+    for (auto& wndPtr : m_windows)
+    {
+        if (wndPtr && !wndPtr->behaviorResolved)
+            resolveWindow(*wndPtr);
+    }
+
+    m_resolveTimer->stop();
+    emit behaviorsResolved();
+}
+
+void LayoutManager::resolveNextSlice()
+{
+    if (!m_behaviorManager) {
+        m_resolveTimer->stop();
+        return;
+    }
+
+    QElapsedTimer budget;
+    budget.start();
+
+    while (m_resolveCursor < m_windows.size() && budget.elapsed() < ResolveSliceBudgetMs)
+    {
+        auto& wndPtr = m_windows[m_resolveCursor++];
+        if (wndPtr && !wndPtr->behaviorResolved)
+            resolveWindow(*wndPtr);
+    }
+
+    if (m_resolveCursor >= m_windows.size())
+    {
+        m_resolveTimer->stop();
+        qInfo() << "[LayoutManager] Hintergrund-Auflösung abgeschlossen.";
+        emit behaviorsResolved();
+    }
+}
+
+// -------------------------------------------------------------
+// Gezielte Neuauflösung nach Regel-Änderung (Hot-Reload)
+// -------------------------------------------------------------
+int LayoutManager::reresolveBehaviors(const QSet<QString>& changedKeys)
+{
+    if (!m_behaviorManager || changedKeys.isEmpty())
+        return 0;
+
+    int count = 0;
+
+    for (auto& wndPtr : m_windows)
+    {
+        // Noch nicht aufgelöste Fenster bekommen die neuen Regeln ohnehin
+        if (!wndPtr || !wndPtr->behaviorResolved) continue;
+
+        if (m_behaviorManager->isAffected(*wndPtr, changedKeys)) {
+            BehaviorInfo fresh = m_behaviorManager->resolveBehavior(*wndPtr);
+            wndPtr->behavior = fresh;
+            ++count;
+        }
 
-        // 3) Controls
         for (auto& ctrlPtr : wndPtr->controls)
         {
-            if (!ctrlPtr) continue;
+            if (!ctrlPtr || !m_behaviorManager->isAffected(*ctrlPtr, changedKeys))
+                continue;
 
-            m_behaviorManager->validateControlFlags(ctrlPtr.get());
-            ctrlPtr->behavior = m_behaviorManager->resolveBehavior(*ctrlPtr);
+            BehaviorInfo fresh = m_behaviorManager->resolveBehavior(*ctrlPtr);
+            ctrlPtr->behavior = fresh;
+            ++count;
         }
     }
 
-    // Nachgelagerte Analysen
-    m_behaviorManager->analyzeControlTypes(m_windows);
-    m_behaviorManager->generateUnknownControls(m_windows);
-
-    qInfo() << "[LayoutManager] Validierung & Behavior-Zuordnung abgeschlossen.";
+    qInfo().noquote()
+        << QString("[LayoutManager] Hot-Reload: %1 Fenster/Controls neu aufgelöst.").arg(count);
+    return count;
 }
 
 // -------------------------------------------------------------
@@ -12,6 +12,7 @@
 
 class LayoutBackend;
 class BehaviorManager;
+class QTimer;
 
 // ================================================================
 // LayoutManager – kümmert sich um Layoutstruktur & Serialisierung
@@ -37,6 +38,19 @@ public:
     // ------------------------------
     void processLayout();
 
+    // ------------------------------
+    // 🔹 Lazy Behavior-Auflösung
+    //    Auslöser: Auswahl, Rendern, Abfrage – der Rest wird im
+    //    Leerlauf scheibchenweise nachgezogen.
+    // ------------------------------
+    bool ensureBehaviorResolved(const std::shared_ptr<WindowData>& wnd);
+    void ensureAllBehaviorsResolved();   // für projektweite Werkzeuge
+    int unresolvedCount() const { return m_unresolved; }
+
+    // Nur Fenster/Controls neu auflösen, die von geänderten Regel-Keys
+    // betroffen sind (Hot-Reload). Liefert Anzahl neu aufgelöster Objekte.
+    int reresolveBehaviors(const QSet<QString>& changedKeys);
+
     // ------------------------------
     // 🔹 Serialisierung / Suche
     // ------------------------------
@@ -57,6 +71,7 @@ public:
 
 signals:
     void tokensReady();
+    void behaviorsResolved();           // Hintergrund-Auflösung abgeschlossen
 
 private:
     LayoutParser&   m_parser;
@@ -65,5 +80,13 @@ private:
 
     std::vector<std::shared_ptr<WindowData>> m_windows;
 
+    // Hintergrund-Auflösung (GUI-Thread, zeitlich begrenzte Häppchen)
+    QTimer* m_resolveTimer = nullptr;
+    size_t  m_resolveCursor = 0;
+    int     m_unresolved = 0;
+
+    void resolveWindow(WindowData& wnd);
+    void resolveNextSlice();
+
     QString unquote(const QString& s) const;
 };
@@ -0,0 +1,345 @@
+#include "SourceUsageScanner.h"
+#include "layout/model/WindowData.h"
+
+#include <QtConcurrent/QtConcurrent>
+#include <QDir>
+#include <QDirIterator>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QSet>
+#include <QDebug>
+
+#include <algorithm>
+#include <cstring>
+
+namespace {
+inline bool isIdentChar(char c)
+{
+    return (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z') || (c >= '0' && c <= '9') || c == '_';
+}
+
+bool isIdentifier(const QString& s)
+{
+    if (s.isEmpty() || s.front().isDigit())
+        return false;
+    for (QChar c : s)
+        if (c.unicode() > 0x7F || !isIdentChar(char(c.unicode())))
+            return false;
+    return true;
+}
+
+// Ergebnis pro Datei (Map-Schritt)
+struct FileResult
+{
+    QString file;
+    QVector<IdentifierAutomaton::Match> matches;
+    QVector<QPair<QByteArray, int>> unknown;
+};
+}
+
+// =============================================================
+// IdentifierAutomaton
+// =============================================================
+int IdentifierAutomaton::child(int state, char c) const
+{
+    const State& s = m_states[size_t(state)];
+    const auto begin = m_edges.begin() + s.firstEdge;
+    const auto end   = begin + s.edgeCount;
+    const auto it = std::lower_bound(begin, end, c,
+                                     [](const Edge& e, char ch) { return e.c < ch; });
+    return (it != end && it->c == c) ? it->target : -1;
+}
+
+int IdentifierAutomaton::next(int state, char c) const
+{
+    while (true) {
+        const int t = child(state, c);
+        if (t >= 0)
+            return t;
+        if (state == 0)
+            return 0;
+        state = m_states[size_t(state)].fail;
+    }
+}
+
+void IdentifierAutomaton::build(const QStringList& patterns)
+{
+    m_patterns = patterns;
+    m_states.assign(1, State{});
+    m_edges.clear();
+
+    // 1) Trie mit temporären Kinderlisten
+    std::vector<std::vector<Edge>> kids(1);
+
+    for (int p = 0; p < patterns.size(); ++p)
+    {
+        const QByteArray bytes = patterns[p].toLatin1();
+        int state = 0;
+
+        for (char c : bytes) {
+            auto& list = kids[size_t(state)];
+            auto it = std::find_if(list.begin(), list.end(), [c](const Edge& e) { return e.c == c; });
+            if (it != list.end()) {
+                state = it->target;
+                continue;
+            }
+
+            const int created = int(m_states.size());
+            State s;
+            s.depth = m_states[size_t(state)].depth + 1;
+            m_states.push_back(s);
+            kids.emplace_back();
+            kids[size_t(state)].push_back({ c, created });
+            state = created;
+        }
+        m_states[size_t(state)].output = p;
+    }
+
+    // 2) Kanten flach und sortiert ablegen
+    for (size_t i = 0; i < kids.size(); ++i) {
+        auto& list = kids[i];
+        std::sort(list.begin(), list.end(), [](const Edge& a, const Edge& b) { return a.c < b.c; });
+        m_states[i].firstEdge = int(m_edges.size());
+        m_states[i].edgeCount = int(list.size());
+        m_edges.insert(m_edges.end(), list.begin(), list.end());
+    }
+
+    // 3) Fail- und Dictionary-Links per Breitensuche
+    std::vector<int> queue;
+    queue.reserve(m_states.size());
+    queue.push_back(0);
+
+    for (size_t head = 0; head < queue.size(); ++head)
+    {
+        const int u = queue[head];
+        const State su = m_states[size_t(u)];
+
+        for (int e = su.firstEdge; e < su.firstEdge + su.edgeCount; ++e)
+        {
+            const char c = m_edges[size_t(e)].c;
+            const int  v = m_edges[size_t(e)].target;
+
+            int f = 0;
+            if (u != 0) {
+                f = su.fail;
+                while (f != 0 && child(f, c) < 0)
+                    f = m_states[size_t(f)].fail;
+                const int t = child(f, c);
+                f = (t >= 0 && t != v) ? t : 0;
+            }
+
+            State& sv = m_states[size_t(v)];
+            sv.fail = f;
+            sv.dictLink = m_states[size_t(f)].output >= 0 ? f : m_states[size_t(f)].dictLink;
+
+            queue.push_back(v);
+        }
+    }
+}
+
+void IdentifierAutomaton::scan(const char* data, qint64 size,
+                               QVector<Match>& out,
+                               const QList<QByteArray>& unknownPrefixes,
+                               QVector<QPair<QByteArray, int>>* unknownOut) const
+{
+    int state = 0;
+    int line = 1;
+    qint64 tokenStart = -1;
+    bool tokenMatched = false;
+
+    auto closeToken = [&](qint64 end) {
+        if (tokenMatched || !unknownOut)
+            return;
+        const qint64 len = end - tokenStart;
+        for (const QByteArray& prefix : unknownPrefixes) {
+            if (len > prefix.size() && std::memcmp(data + tokenStart, prefix.constData(), size_t(prefix.size())) == 0) {
+                unknownOut->append({ QByteArray(data + tokenStart, qsizetype(len)), line });
+                break;
+            }
+        }
+    };
+
+    for (qint64 i = 0; i < size; ++i)
+    {
+        const char c = data[i];
+
+        if (!isIdentChar(c)) {
+            if (tokenStart >= 0) {
+                closeToken(i);
+                tokenStart = -1;
+            }
+            // Muster bestehen nur aus Bezeichnerzeichen → zurück zur Wurzel
+            state = 0;
+            if (c == '\n')
+                ++line;
+            continue;
+        }
+
+        if (tokenStart < 0) {
+            tokenStart = i;
+            tokenMatched = false;
+        }
+
+        state = next(state, c);
+
+        const State& s = m_states[size_t(state)];
+        for (int o = s.output >= 0 ? state : s.dictLink; o >= 0; o = m_states[size_t(o)].dictLink)
+        {
+            const State& hit = m_states[size_t(o)];
+
+            // Nur ganze Bezeichner: Anfang = Token-Anfang, danach kein Bezeichnerzeichen
+            if (i - hit.depth + 1 != tokenStart)
+                continue;
+            if (i + 1 < size && isIdentChar(data[i + 1]))
+                continue;
+
+            out.append({ hit.output, line });
+            tokenMatched = true;
+        }
+    }
+
+    if (tokenStart >= 0)
+        closeToken(size);
+}
+
+// =============================================================
+// SourceUsageScanner
+// =============================================================
+SourceUsageScanner::SourceUsageScanner(QObject* parent)
+    : QObject(parent)
+{
+    m_pool.setMaxThreadCount(1);
+    connect(&m_watcher, &QFutureWatcher<UsageTable>::finished,
+            this, &SourceUsageScanner::onScanFinished);
+}
+
+SourceUsageScanner::~SourceUsageScanner()
+{
+    cancel();
+    m_pool.waitForDone();
+}
+
+void SourceUsageScanner::cancel()
+{
+    if (m_cancel)
+        m_cancel->store(true);
+}
+
+void SourceUsageScanner::start(const QString& sourceDir,
+                               const std::vector<std::shared_ptr<WindowData>>& windows)
+{
+    cancel();
+
+    if (sourceDir.isEmpty() || !QDir(sourceDir).exists()) {
+        qWarning().noquote() << "[SourceUsageScanner] Source-Ordner fehlt:" << sourceDir;
+        return;
+    }
+
+    // Bezeichner aus dem Layout (GUI-Thread, bevor der Task startet)
+    QStringList identifiers;
+    QSet<QString> seen;
+    for (const auto& wnd : windows) {
+        if (!wnd)
+            continue;
+        if (isIdentifier(wnd->name) && !seen.contains(wnd->name)) {
+            seen.insert(wnd->name);
+            identifiers << wnd->name;
+        }
+        for (const auto& ctrl : wnd->controls) {
+            if (ctrl && isIdentifier(ctrl->id) && !seen.contains(ctrl->id)) {
+                seen.insert(ctrl->id);
+                identifiers << ctrl->id;
+            }
+        }
+    }
+
+    auto cancelFlag = std::make_shared<std::atomic_bool>(false);
+    m_cancel = cancelFlag;
+
+    auto task = [sourceDir, identifiers, cancelFlag]() -> UsageTable
+    {
+        QElapsedTimer timer;
+        timer.start();
+
+        auto automaton = std::make_shared<IdentifierAutomaton>();
+        automaton->build(identifiers);
+
+        QStringList files;
+        QDirIterator it(sourceDir, QStringList() << "*.h" << "*.cpp",
+                        QDir::Files, QDirIterator::Subdirectories);
+        while (it.hasNext())
+            files << it.next();
+
+        const QDir base(sourceDir);
+        const QList<QByteArray> prefixes = { QByteArrayLiteral("APP_"), QByteArrayLiteral("WIDC_") };
+
+        auto mapFile = [automaton, cancelFlag, &base, &prefixes](const QString& path) {
+            FileResult r;
+            r.file = base.relativeFilePath(path);
+            if (cancelFlag->load())
+                return r;
+
+            QFile f(path);
+            if (!f.open(QIODevice::ReadOnly) || f.size() <= 0)
+                return r;
+
+            const qint64 size = f.size();
+            uchar* mapped = f.map(0, size);
+            QByteArray fallback;
+            const char* data = reinterpret_cast<const char*>(mapped);
+            if (!mapped) {
+                fallback = f.readAll();
+                data = fallback.constData();
+            }
+
+            automaton->scan(data, size, r.matches, prefixes, &r.unknown);
+
+            if (mapped)
+                f.unmap(mapped);
+            return r;
+        };
+
+        auto reduce = [automaton](UsageTable& table, const FileResult& r) {
+            for (const IdentifierAutomaton::Match& m : r.matches)
+                table.hits[automaton->patterns().at(m.pattern)].append({ r.file, m.line });
+            for (const auto& u : r.unknown)
+                table.missing[QString::fromLatin1(u.first)].append({ r.file, u.second });
+        };
+
+        UsageTable table = QtConcurrent::blockingMappedReduced<UsageTable>(
+            files, mapFile, reduce,
+            QtConcurrent::UnorderedReduce);
+
+        for (const QString& id : identifiers)
+            if (!table.hits.contains(id))
+                table.unused << id;
+
+        table.files = files.size();
+        table.elapsedMs = timer.elapsed();
+        return table;
+    };
+
+    m_watcher.setFuture(QtConcurrent::run(&m_pool, task));
+
+    qInfo().noquote() << QString("[SourceUsageScanner] Scan gestartet: %1 Bezeichner in %2")
+                             .arg(identifiers.size())
+                             .arg(sourceDir);
+}
+
+void SourceUsageScanner::onScanFinished()
+{
+    if (m_cancel && m_cancel->load())
+        return;
+
+    m_table = m_watcher.result();
+
+    qInfo().noquote()
+        << QString("[SourceUsageScanner] %1 Dateien in %2 ms: %3 Bezeichner benutzt, %4 unbenutzt, %5 nur im Code")
+               .arg(m_table.files)
+               .arg(m_table.elapsedMs)
+               .arg(m_table.hits.size())
+               .arg(m_table.unused.size())
+               .arg(m_table.missing.size());
+
+    emit finished();
+}
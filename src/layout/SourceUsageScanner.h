@@ -0,0 +1,117 @@
+#pragma once
+
+#include <QObject>
+#include <QFutureWatcher>
+#include <QHash>
+#include <QString>
+#include <QStringList>
+#include <QThreadPool>
+#include <QVector>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+struct WindowData;
+
+// ------------------------------------------------------------
+// IdentifierAutomaton – Aho-Corasick über Bezeichner
+// ------------------------------------------------------------
+// Findet alle Muster in einem Durchlauf. Treffer zählen nur als
+// ganze Bezeichner (APP_FOO trifft nicht in APP_FOOBAR).
+// Unveränderlich nach build() → ohne Locks von mehreren Threads
+// gleichzeitig nutzbar.
+// ------------------------------------------------------------
+class IdentifierAutomaton
+{
+public:
+    struct Match {
+        int pattern = -1;   // Index in patterns()
+        int line    = 0;    // 1-basiert
+    };
+
+    void build(const QStringList& patterns);
+
+    const QStringList& patterns() const { return m_patterns; }
+    int stateCount() const { return int(m_states.size()); }
+
+    // Durchsucht einen Puffer; unbekannte Bezeichner mit einem der
+    // Präfixe landen in unknownOut (Code kennt sie, Layout nicht)
+    void scan(const char* data, qint64 size,
+              QVector<Match>& out,
+              const QList<QByteArray>& unknownPrefixes,
+              QVector<QPair<QByteArray, int>>* unknownOut) const;
+
+private:
+    struct Edge {
+        char c;
+        int  target;
+    };
+
+    struct State {
+        int firstEdge = 0;
+        int edgeCount = 0;
+        int fail      = 0;
+        int output    = -1;   // Musterindex, falls hier ein Muster endet
+        int depth     = 0;
+        int dictLink  = -1;   // nächster Zustand mit Ausgabe über fail-Kette
+    };
+
+    int child(int state, char c) const;
+    int next(int state, char c) const;
+
+    QStringList        m_patterns;
+    std::vector<State> m_states;
+    std::vector<Edge>  m_edges;    // nach Zustand gruppiert, je Zustand nach Zeichen sortiert
+};
+
+// ------------------------------------------------------------
+// SourceUsageScanner
+// ------------------------------------------------------------
+// Sucht alle Fensternamen (APP_*) und Control-IDs (WIDC_*) aus
+// dem Layout im Client-Quellcode (*.h / *.cpp unter sourcePath).
+// Läuft im Hintergrund (QtConcurrent, Datei-parallel) und liefert
+// eine Nutzungstabelle mit Datei:Zeile-Treffern.
+// ------------------------------------------------------------
+class SourceUsageScanner : public QObject
+{
+    Q_OBJECT
+
+public:
+    struct Hit {
+        QString file;
+        int line = 0;
+    };
+
+    struct UsageTable {
+        QHash<QString, QVector<Hit>> hits;        // Bezeichner → Fundstellen
+        QStringList unused;                       // im Layout, aber nie im Code
+        QHash<QString, QVector<Hit>> missing;     // im Code (APP_/WIDC_), aber nicht im Layout
+        int files = 0;
+        qint64 elapsedMs = 0;
+    };
+
+    explicit SourceUsageScanner(QObject* parent = nullptr);
+    ~SourceUsageScanner() override;
+
+    // Startet einen Scan im Hintergrund; ein laufender Scan wird abgebrochen
+    void start(const QString& sourceDir,
+               const std::vector<std::shared_ptr<WindowData>>& windows);
+    void cancel();
+
+    bool isRunning() const { return m_watcher.isRunning(); }
+    const UsageTable& table() const { return m_table; }
+
+    // Fundstellen eines Bezeichners (leer, wenn unbenutzt oder Scan läuft)
+    QVector<Hit> hitsFor(const QString& identifier) const { return m_table.hits.value(identifier); }
+
+signals:
+    void finished();
+
+private:
+    void onScanFinished();
+
+    QThreadPool m_pool;                          // eigener Pool für den Koordinator-Task
+    QFutureWatcher<UsageTable> m_watcher;
+    std::shared_ptr<std::atomic_bool> m_cancel;
+    UsageTable m_table;
+};
@@ -5,6 +5,13 @@
 
 #include "BehaviorManager.h"
 
+// Aufgelöster Anzeigetext (TextManager::titleText/tooltipText).
+// Gültig, solange version der Textversion des TextManagers entspricht.
+struct ResolvedText {
+    QString value;
+    quint64 version = 0;
+};
+
 enum ButtonState {
     Normal,
     Hovered,
@@ -60,5 +67,15 @@ struct ControlData
     bool isPressed = false;
     bool isHovered = false;
 
+    // Verknüpftes Define aus resdata.h (DefineManager::applyDefinesToLayout)
+    QString defineName;
+    quint32 defineId = 0;
+
+    // Zeilen im TextStore (TextManager::applyTextsToLayout), -1 = kein Text
+    int titleTextRow   = -1;
+    int tooltipTextRow = -1;
+    mutable ResolvedText titleText;
+    mutable ResolvedText tooltipText;
+
     BehaviorInfo behavior;
 };
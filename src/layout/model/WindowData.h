@@ -37,5 +37,18 @@ struct WindowData {
     int sourceLine = -1;          // Zeilennummer in resdata.inc, an der das Fenster beginnt
     QString rawHeader;            // Originaltextzeile des Fensters (z. B. "APP_CONFIRM_BUY ...")
     bool isCorrupted = false;
+
+    // Verknüpftes Define aus resdata.h (DefineManager::applyDefinesToLayout)
+    QString defineName;
+    quint32 defineId = 0;
+
+    // Zeile im TextStore (TextManager::applyTextsToLayout), -1 = kein Text
+    int titleTextRow = -1;
+    mutable ResolvedText titleText;
+
     BehaviorInfo behavior;
+
+    // Behavior (Fenster + Controls) wird lazy aufgelöst – siehe
+    // LayoutManager::ensureBehaviorResolved()
+    bool behaviorResolved = false;
 };
@@ -1,31 +1,43 @@
 #include "TextBackend.h"
 #include "TextManager.h"
 #include "EncodingUtils.h"
+#include <QElapsedTimer>
 #include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
 #include <QTextStream>
 #include <QRegularExpression>
 #include <QDebug>
 
+namespace {
+// Ab so vielen Änderungen je Sprache wird die Datei komplett neu
+// geschrieben (kompaktiert) statt zeilenweise gepatcht
+constexpr int CompactionThreshold = 4096;
+}
+
 // ------------------------------------------------------------
 // Lädt textClient.txt (reine Textdaten)
 // ------------------------------------------------------------
 bool TextBackend::loadText(const QString& path, TextManager& mgr)
 {
-    QFile file;
-    QTextStream in;
-    if (!EncodingUtils::openTextStream(file, in, path)) {
-        qWarning() << "[TextBackend] Konnte Textdatei nicht öffnen:" << path;
-        return false;
-    }
+    return loadTexts({ TextStore::Source{ QStringLiteral("Default"), path } }, mgr);
+}
 
+// ------------------------------------------------------------
+// Lädt mehrere Sprachen (je eine textClient.txt) gleichzeitig
+// ------------------------------------------------------------
+bool TextBackend::loadTexts(const QVector<TextStore::Source>& sources, TextManager& mgr)
+{
     mgr.clear();
 
-    while (!in.atEnd()) {
-        const QString line = in.readLine();
-        mgr.processTextLine(line);
+    // Dateien werden gemappt; Texte erst bei Zugriff dekodiert
+    if (!mgr.openTextFiles(sources)) {
+        qWarning() << "[TextBackend] Konnte keine Textdatei öffnen.";
+        return false;
     }
 
-    qInfo() << "[TextBackend] textClient.txt geladen:" << path;
+    for (const TextStore::Source& src : sources)
+        qInfo().noquote() << "[TextBackend] textClient.txt geladen:" << src.language << "→" << src.path;
     return true;
 }
 
@@ -48,6 +60,7 @@ bool TextBackend::loadInc(const QString& path, TextManager& mgr)
         mgr.processIncLine(line);
     }
 
+    mgr.markIncSaved();
     qInfo() << "[TextBackend] textClient.inc geladen:" << path;
     return true;
 }
@@ -55,31 +68,81 @@ bool TextBackend::loadInc(const QString& path, TextManager& mgr)
 // ------------------------------------------------------------
 // Speichert textClient.txt
 // ------------------------------------------------------------
-bool TextBackend::saveText(const QString& path, const TextManager& mgr) const
+bool TextBackend::saveText(const QString& path, TextManager& mgr) const
 {
-    QFile file(path);
-    if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+    // Suchindex liest die gemappten Dateien → vor dem Lösen fertig bauen
+    mgr.finishSearchIndex();
+
+    TextStore& store = mgr.store();
+    if (store.languageCount() == 0)
+        store.addLanguage(QStringLiteral("Default"));
+
+    // Spalte 0 → übergebener Pfad, weitere Sprachen nur bei Änderungen
+    for (int column = 0; column < store.languageCount(); ++column)
+    {
+        const QString target = column == 0 ? path : store.sourcePath(column);
+        if (column > 0 && (store.editCount(column) == 0 || target.isEmpty()))
+            continue;
+
+        if (!saveLanguage(target, store, column))
+            return false;
+    }
+    return true;
+}
+
+bool TextBackend::saveLanguage(const QString& path, TextStore& store, int column) const
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    const int edits = store.editCount(column);
+    const QString mappedPath = store.sourcePath(column);
+
+    // Unverändert am selben Ort → Datei unangetastet lassen
+    if (edits == 0 && store.canPatch(column) && QFileInfo(path) == QFileInfo(mappedPath)) {
+        qInfo() << "[TextBackend] Keine Textänderungen – überspringe:" << path;
+        return true;
+    }
+
+    // Erst alles einsammeln – die Quelldatei ist evtl. noch gemappt.
+    // Wenige Änderungen → nur die betroffenen Werte ersetzen,
+    // sonst (oder ohne Quelldatei) komplett neu schreiben.
+    const bool patch = store.canPatch(column) && edits <= CompactionThreshold;
+    const QByteArray data = patch ? store.patchedColumn(column) : store.compactedColumn(column);
+
+    // Mapping lösen, bevor die Datei ersetzt wird
+    store.detachColumn(column);
+
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly) || file.write(data) != data.size() || !file.commit()) {
         qWarning() << "[TextBackend] Konnte Textdatei nicht schreiben:" << path;
+        if (!mappedPath.isEmpty())
+            store.reattachColumn(column, mappedPath, false);   // Änderungen bleiben erhalten
         return false;
     }
 
-    QTextStream out(&file);
-    out.setEncoding(QStringConverter::Utf8);
-
-    const auto texts = mgr.allTexts();
-    for (auto it = texts.constBegin(); it != texts.constEnd(); ++it)
-        out << it.key() << "\t" << it.value() << "\n";
+    store.reattachColumn(column, path, true);
 
-    qInfo() << "[TextBackend] textClient.txt gespeichert:" << path;
+    qInfo().noquote() << QString("[TextBackend] textClient.txt gespeichert: %1 (%2, %3 Änderungen %4, %5 ms)")
+                             .arg(path, store.language(column))
+                             .arg(edits)
+                             .arg(patch ? "gepatcht" : "kompaktiert")
+                             .arg(timer.elapsed());
     return true;
 }
 
 // ------------------------------------------------------------
 // Speichert textClient.inc
 // ------------------------------------------------------------
-bool TextBackend::saveInc(const QString& path, const TextManager& mgr) const
+bool TextBackend::saveInc(const QString& path, TextManager& mgr) const
 {
-    QFile file(path);
+    // Gruppen unverändert → Datei unangetastet lassen
+    if (!mgr.isIncModified() && QFileInfo::exists(path)) {
+        qInfo() << "[TextBackend] Keine Gruppenänderungen – überspringe:" << path;
+        return true;
+    }
+
+    QSaveFile file(path);
     if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
         qWarning() << "[TextBackend] Konnte INC-Datei nicht schreiben:" << path;
         return false;
@@ -88,17 +151,20 @@ bool TextBackend::saveInc(const QString& path, const TextManager& mgr) const
     QTextStream out(&file);
     out.setEncoding(QStringConverter::Utf8);
 
-    const auto groups = mgr.allGroups();
-    for (const QString& tid : groups) {
-        const auto ids = mgr.idsForGroup(tid);
-        out << tid << " 0xffffffff\n{\n";
-        for (const QString& id : ids)
+    for (const TextGroup& group : mgr.groups()) {
+        out << group.tid << " 0xffffffff\n{\n";
+        for (const QString& id : group.ids)
             out << "    " << id << "\n";
         out << "}\n\n";
     }
+    out.flush();
 
+    if (!file.commit()) {
+        qWarning() << "[TextBackend] Konnte INC-Datei nicht schreiben:" << path;
+        return false;
+    }
+
+    mgr.markIncSaved();
     qInfo() << "[TextBackend] textClient.inc gespeichert:" << path;
     return true;
 }
-
-
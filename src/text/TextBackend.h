@@ -1,5 +1,8 @@
 #pragma once
 #include <QString>
+#include <QVector>
+
+#include "text/TextStore.h"
 
 class TextManager;
 
@@ -10,12 +13,19 @@ public:
     // Lädt textClient.txt (IDS → Text)
     bool loadText(const QString& path, TextManager& mgr);
 
+    // Lädt mehrere Sprachen parallel (Spalte 0 = erste Quelle)
+    bool loadTexts(const QVector<TextStore::Source>& sources, TextManager& mgr);
+
     // Lädt textClient.inc (TID → IDS)
     bool loadInc(const QString& path, TextManager& mgr);
 
-    // Speichert textClient.txt
-    bool saveText(const QString& path, const TextManager& mgr) const;
+    // Speichert textClient.txt (und geänderte weitere Sprachen);
+    // wenige Änderungen werden in die bestehende Datei gepatcht
+    bool saveText(const QString& path, TextManager& mgr) const;
+
+    // Speichert textClient.inc (nur bei geänderten Gruppen)
+    bool saveInc(const QString& path, TextManager& mgr) const;
 
-    // Speichert textClient.inc
-    bool saveInc(const QString& path, const TextManager& mgr) const;
+private:
+    bool saveLanguage(const QString& path, TextStore& store, int column) const;
 };
@@ -2,28 +2,77 @@
 #include "WindowData.h"
 #include "ControlData.h"
 
+#include <QtConcurrent/QtConcurrent>
+#include <QElapsedTimer>
 #include <QRegularExpression>
 #include <QDebug>
 
+TextManager::TextManager(QObject* parent)
+    : BaseManager(parent)
+{
+    connect(&m_searchWatcher, &QFutureWatcher<std::shared_ptr<TextSearchIndex>>::finished,
+            this, &TextManager::onSearchIndexBuilt);
+
+    qInfo() << "[TextManager] Initialisiert";
+}
+
+TextManager::~TextManager()
+{
+    cancelSearchIndexBuild();
+}
+
 // ------------------------------------------------------------
 // Clear
 // ------------------------------------------------------------
 
 void TextManager::clear()
 {
-    m_texts.clear();
+    cancelSearchIndexBuild();
+    m_search.reset();
+    m_usages.clear();
+    m_resolvedRefs.clear();
+    invalidateResolved();
+    m_store.clear();
     m_groups.clear();
     m_idToGroup.clear();
+    m_incModified = false;
 }
 
 void TextManager::clearIncState()
 {
     m_groups.clear();
     m_idToGroup.clear();
+    m_incModified = false;
 }
 
 // ------------------------------------------------------------
-// textClient.txt verarbeiten (IDS → Text)
+// textClient.txt je Sprache öffnen (parallel, Texte lazy dekodiert)
+// ------------------------------------------------------------
+bool TextManager::openTextFiles(const QVector<TextStore::Source>& sources)
+{
+    // Worker liest die alten Tabellen → vor dem Neuladen stoppen
+    cancelSearchIndexBuild();
+    m_search.reset();
+
+    const bool ok = m_store.load(sources);
+    invalidateResolved();
+    if (ok)
+        startSearchIndexBuild();
+    return ok;
+}
+
+void TextManager::setCurrentLanguage(int column)
+{
+    if (!m_store.setCurrentColumn(column))
+        return;
+
+    invalidateResolved();
+    qInfo().noquote() << "[TextManager] Sprache gewechselt:" << m_store.language(column);
+    emit languageChanged(column);
+}
+
+// ------------------------------------------------------------
+// Einzelne textClient.txt-Zeile übernehmen (IDS → Text)
 // ------------------------------------------------------------
 void TextManager::processTextLine(const QString& line)
 {
@@ -38,10 +87,7 @@ void TextManager::processTextLine(const QString& line)
     if (parts.size() < 2)
         return;
 
-    const QString key = parts[0];
-    const QString value = parts.mid(1).join(" ");
-    m_texts[key] = value;
-    setDirty();
+    setText(parts[0], parts.mid(1).join(" "));
 }
 
 // ------------------------------------------------------------
@@ -84,6 +130,7 @@ void TextManager::rebuildFromTokens(const QList<Token>& tokens)
 
     m_groups.clear();
     m_idToGroup.clear();
+    m_incModified = true;
 
     QString currentTid;
     int countGroups = 0;
@@ -106,8 +153,8 @@ void TextManager::rebuildFromTokens(const QList<Token>& tokens)
             addIdToGroup(tid, id);
 
             // Textwert übernehmen (falls vorhanden)
-            if (!t.value.isEmpty() && !m_texts.contains(id)) {
-                m_texts[id] = t.value;
+            if (!t.value.isEmpty() && !hasText(id)) {
+                setText(id, t.value);
             }
 
             ++countIds;
@@ -128,8 +175,10 @@ void TextManager::rebuildFromTokens(const QList<Token>& tokens)
 // ------------------------------------------------------------
 void TextManager::addGroup(const QString& tid)
 {
-    if (!m_groups.contains(tid))
-        m_groups[tid] = TextGroup{ tid, {} };
+    if (m_groups.contains(tid))
+        return;
+    m_groups[tid] = TextGroup{ tid, {} };
+    m_incModified = true;
     setDirty();
 }
 
@@ -140,6 +189,7 @@ void TextManager::addIdToGroup(const QString& tid, const QString& id)
 
     m_groups[tid].ids.append(id);
     m_idToGroup[id] = tid;
+    m_incModified = true;
     setDirty();
 }
 
@@ -148,7 +198,29 @@ void TextManager::addIdToGroup(const QString& tid, const QString& id)
 // ------------------------------------------------------------
 QString TextManager::value(const QString& id) const
 {
-    return m_texts.value(id);
+    return m_store.value(m_store.row(id));
+}
+
+bool TextManager::hasText(const QString& id) const
+{
+    return m_store.hasValue(m_store.row(id), m_store.currentColumn());
+}
+
+void TextManager::setText(const QString& id, const QString& text)
+{
+    if (m_store.languageCount() == 0)
+        m_store.addLanguage(QStringLiteral("Default"));
+
+    const int row = m_store.addRow(id);
+    const int column = m_store.currentColumn();
+    if (m_store.hasValue(row, column) && m_store.value(row, column) == text)
+        return;
+
+    m_store.setValue(row, column, text);
+    updateSearchIndex(row, column);
+    if (column == m_store.currentColumn())
+        refreshResolved(row);
+    setDirty();
 }
 
 QString TextManager::groupForId(const QString& id) const
@@ -168,6 +240,10 @@ QStringList TextManager::allGroups() const
     return m_groups.keys();
 }
 
+// ------------------------------------------------------------
+// Layout verknüpfen: nur Zeilen merken, Text kommt aus der
+// aktuellen Sprachspalte → Sprachwechsel ohne erneutes Linken
+// ------------------------------------------------------------
 void TextManager::applyTextsToLayout(const std::vector<std::shared_ptr<WindowData>>& windows)
 {
     if (windows.empty()) {
@@ -177,58 +253,200 @@ void TextManager::applyTextsToLayout(const std::vector<std::shared_ptr<WindowDat
 
     qInfo() << "[TextManager] applyTextsToLayout(): Mapping startet. Fenster:" << windows.size();
 
+    m_usages.clear();
+    m_resolvedRefs.clear();
+    invalidateResolved();
+
+    int linked = 0;
+    auto rowFor = [&](const QString& id, const TextUsage& usage,
+                      const std::shared_ptr<void>& owner, ResolvedText& slot) {
+        const int row = id.isEmpty() ? -1 : m_store.row(id.trimmed());
+        if (row >= 0) {
+            m_usages[row].append(usage);
+            m_resolvedRefs[row].append({ owner, &slot });
+            ++linked;
+        }
+        return row;
+    };
+
     for (const auto& wnd : windows)
     {
         if (!wnd)
             continue;
 
-        //
         // Fenster-Titel (WindowData::titletext enthält in FlyFF i.d.R. die Text-ID)
-        //
-        const QString titleId = wnd->titletext.trimmed();
-
-        if (!titleId.isEmpty())
-        {
-            const QString titleText = value(titleId);
-            if (!titleText.isEmpty()) {
-                wnd->behavior.attributes["titleId"]   = titleId;
-                wnd->behavior.attributes["titleText"] = titleText;
-            }
-        }
+        wnd->titleTextRow = rowFor(wnd->titletext, { wnd->name, QString(), "title" }, wnd, wnd->titleText);
 
-        //
-        // Controls
-        //
         for (const auto& ctrl : wnd->controls)
         {
             if (!ctrl)
                 continue;
 
-            // Control-Titel (LayoutManager setzt ctrl->titleId)
-            if (!ctrl->titleId.isEmpty())
-            {
-                const QString id = ctrl->titleId.trimmed();
-                const QString txt = value(id);
+            // Control-Titel (LayoutManager setzt ctrl->titleId) + Tooltip
+            ctrl->titleTextRow   = rowFor(ctrl->titleId,   { wnd->name, ctrl->id, "title" },   ctrl, ctrl->titleText);
+            ctrl->tooltipTextRow = rowFor(ctrl->tooltipId, { wnd->name, ctrl->id, "tooltip" }, ctrl, ctrl->tooltipText);
+        }
+    }
 
-                if (!txt.isEmpty()) {
-                    ctrl->behavior.attributes["titleId"]   = id;
-                    ctrl->behavior.attributes["titleText"] = txt;
-                }
-            }
+    qInfo() << "[TextManager] applyTextsToLayout(): Mapping abgeschlossen," << linked << "Texte verknüpft.";
+}
 
-            // Tooltip
-            if (!ctrl->tooltipId.isEmpty())
-            {
-                const QString id = ctrl->tooltipId.trimmed();
-                const QString txt = value(id);
+// ------------------------------------------------------------
+// Anzeigetexte (Cache im Window/Control)
+// ------------------------------------------------------------
+// Der Slot ist gültig, solange seine Version der globalen
+// entspricht; im Normalfall ist der Zugriff damit ein Vergleich
+// und eine Referenz. Sprachwechsel, Laden und Linken erhöhen die
+// Version, Einzel-Edits aktualisieren nur die Slots der Zeile.
+// ------------------------------------------------------------
+const QString& TextManager::titleText(const WindowData& wnd) const
+{
+    return resolved(wnd.titleText, wnd.titleTextRow);
+}
 
-                if (!txt.isEmpty()) {
-                    ctrl->behavior.attributes["tooltipId"]   = id;
-                    ctrl->behavior.attributes["tooltipText"] = txt;
-                }
-            }
+const QString& TextManager::titleText(const ControlData& ctrl) const
+{
+    return resolved(ctrl.titleText, ctrl.titleTextRow);
+}
+
+const QString& TextManager::tooltipText(const ControlData& ctrl) const
+{
+    return resolved(ctrl.tooltipText, ctrl.tooltipTextRow);
+}
+
+const QString& TextManager::resolved(ResolvedText& slot, int row) const
+{
+    if (slot.version != m_textVersion) {
+        slot.value   = row >= 0 ? m_store.value(row) : QString();
+        slot.version = m_textVersion;
+    }
+    return slot.value;
+}
+
+void TextManager::refreshResolved(int row)
+{
+    auto it = m_resolvedRefs.find(row);
+    if (it == m_resolvedRefs.end())
+        return;
+
+    const QString text = m_store.value(row);
+    QVector<ResolvedRef>& refs = it.value();
+    for (qsizetype i = refs.size() - 1; i >= 0; --i) {
+        // Fenster/Control inzwischen gelöscht → Eintrag verwerfen
+        const std::shared_ptr<void> owner = refs[i].owner.lock();
+        if (!owner) {
+            refs.removeAt(i);
+            continue;
         }
+        refs[i].slot->value   = text;
+        refs[i].slot->version = m_textVersion;
+    }
+    if (refs.isEmpty())
+        m_resolvedRefs.erase(it);
+}
+
+// ------------------------------------------------------------
+// Volltextsuche
+// ------------------------------------------------------------
+void TextManager::startSearchIndexBuild()
+{
+    cancelSearchIndexBuild();
+    m_search.reset();
+    m_pendingSearchUpdates.clear();
+
+    // Eingaben im GUI-Thread kopieren; im Worker wird nur die
+    // gemappte Datei gelesen (TextTable::decodeValue ist const)
+    std::vector<TextSearchIndex::Column> columns(size_t(m_store.languageCount()));
+    for (int c = 0; c < m_store.languageCount(); ++c) {
+        columns[size_t(c)].table     = &m_store.table(c);
+        columns[size_t(c)].atomOfRow = m_store.atomsOfColumn(c);
+        columns[size_t(c)].edits     = m_store.edits(c);
     }
+    const int rows = m_store.rowCount();
+
+    auto cancel = std::make_shared<std::atomic_bool>(false);
+    m_searchCancel = cancel;
+
+    m_searchWatcher.setFuture(QtConcurrent::run([columns = std::move(columns), rows, cancel]() {
+        QElapsedTimer timer;
+        timer.start();
+
+        auto index = std::make_shared<TextSearchIndex>();
+        index->build(columns, rows, cancel.get());
+
+        if (!cancel->load())
+            qInfo().noquote() << QString("[TextManager] Suchindex: %1 Texte, %2 Trigramme in %3 ms")
+                                     .arg(index->documentCount())
+                                     .arg(index->trigramCount())
+                                     .arg(timer.elapsed());
+        return index;
+    }));
+}
 
-    qInfo() << "[TextManager] applyTextsToLayout(): Mapping abgeschlossen.";
+void TextManager::cancelSearchIndexBuild()
+{
+    if (m_searchCancel)
+        m_searchCancel->store(true);
+    m_searchWatcher.waitForFinished();
+    m_pendingSearchUpdates.clear();
+}
+
+void TextManager::finishSearchIndex()
+{
+    if (!m_searchWatcher.isRunning())
+        return;
+
+    m_searchWatcher.waitForFinished();
+    onSearchIndexBuilt();
+}
+
+void TextManager::onSearchIndexBuilt()
+{
+    if (!m_searchCancel || m_searchCancel->load() || m_search)
+        return;
+
+    const QFuture<std::shared_ptr<TextSearchIndex>> future = m_searchWatcher.future();
+    if (future.resultCount() == 0)
+        return;
+
+    m_search = future.result();
+
+    // Edits, die während des Aufbaus passiert sind, nachziehen
+    const auto pending = m_pendingSearchUpdates;
+    m_pendingSearchUpdates.clear();
+    for (const auto& cell : pending)
+        updateSearchIndex(cell.first, cell.second);
+
+    emit searchIndexReady();
+}
+
+void TextManager::updateSearchIndex(int row, int column)
+{
+    if (m_search)
+        m_search->update(row, column, m_store.value(row, column));
+    else if (m_searchWatcher.isRunning())
+        m_pendingSearchUpdates.append({ row, column });
+}
+
+QVector<TextSearchResult> TextManager::search(const QString& query, int limit) const
+{
+    QVector<TextSearchResult> results;
+    if (!m_search) {
+        qInfo() << "[TextManager] Suche: Index wird noch aufgebaut.";
+        return results;
+    }
+
+    const QVector<TextSearchIndex::Hit> hits = m_search->find(query, limit);
+    results.reserve(hits.size());
+
+    for (const TextSearchIndex::Hit& hit : hits) {
+        TextSearchResult r;
+        r.id       = m_store.key(hit.row);
+        r.tid      = groupForId(r.id);
+        r.language = m_store.language(hit.column);
+        r.text     = m_store.value(hit.row, hit.column);
+        r.usages   = m_usages.value(hit.row);
+        results.append(r);
+    }
+    return results;
 }
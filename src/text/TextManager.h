@@ -1,16 +1,23 @@
 #pragma once
 #include <QObject>
+#include <QFutureWatcher>
 #include <QMap>
+#include <QHash>
 #include <QList>
 #include <QString>
 #include <vector>
 #include <memory>
+#include <atomic>
 
 #include "layout/model/TokenData.h"
 #include "utils/BaseManager.h"
+#include "text/TextStore.h"
+#include "text/TextSearchIndex.h"
 
 struct WindowData;
 struct ControlData;
+struct ResolvedText;
+
 
 // ------------------------------------------------------------
 // Datenstruktur für Textgruppen
@@ -20,6 +27,23 @@ struct TextGroup {
     QList<QString> ids;        // Zugehörige Text-IDs
 };
 
+// ------------------------------------------------------------
+// Verwendung eines Textes im Layout (für die Suche)
+// ------------------------------------------------------------
+struct TextUsage {
+    QString window;            // APP_xxx
+    QString control;           // WIDC_xxx, leer = Fenstertitel
+    QString field;             // "title" / "tooltip"
+};
+
+struct TextSearchResult {
+    QString id;                // IDS_xxx
+    QString tid;               // TID-Gruppe (groupForId)
+    QString language;
+    QString text;
+    QVector<TextUsage> usages;
+};
+
 // ------------------------------------------------------------
 // TextManager – zentrale Verwaltung aller Textdaten
 // ------------------------------------------------------------
@@ -27,11 +51,8 @@ class TextManager : public BaseManager
 {
     Q_OBJECT
 public:
-    explicit TextManager(QObject* parent = nullptr)
-        : BaseManager(parent)
-    {
-        qInfo() << "[TextManager] Initialisiert";
-    }
+    explicit TextManager(QObject* parent = nullptr);
+    ~TextManager() override;
 
     // ------------------------------------------------------------
     // Grundoperationen
@@ -42,17 +63,55 @@ public:
     // ------------------------------------------------------------
     // Verarbeitung von Zeilen aus Backend
     // ------------------------------------------------------------
-    void processTextLine(const QString& line);  // textClient.txt
+    bool openTextFiles(const QVector<TextStore::Source>& sources);  // textClient.txt je Sprache
+    void processTextLine(const QString& line);  // einzelne Zeile (überschreibt)
     void processIncLine(const QString& line);   // textClient.inc
 
     // ------------------------------------------------------------
     // Zugriffsfunktionen
     // ------------------------------------------------------------
+    // IDS-Zugriff in der aktuellen Sprache
     QString value(const QString& id) const;
+    bool hasText(const QString& id) const;
+    void setText(const QString& id, const QString& text);
+    int textCount() const { return m_store.rowCount(); }
+
+    // Zeilenzugriff (stabil über Sprachwechsel, siehe applyTextsToLayout)
+    int rowForId(const QString& id) const { return m_store.row(id); }
+    QString text(int row) const { return m_store.value(row); }
+
+    // Anzeigetexte aus dem Layout – im Control gecacht, solange sich
+    // weder Sprache noch der referenzierte Text ändern
+    const QString& titleText(const WindowData& wnd) const;
+    const QString& titleText(const ControlData& ctrl) const;
+    const QString& tooltipText(const ControlData& ctrl) const;
+
+    // ------------------------------------------------------------
+    // Sprachen
+    // ------------------------------------------------------------
+    QStringList languages() const { return m_store.languages(); }
+    int currentLanguage() const { return m_store.currentColumn(); }
+    QString currentLanguageName() const { return m_store.language(m_store.currentColumn()); }
+    void setCurrentLanguage(int column);
+
+    TextStore& store() { return m_store; }
+    const TextStore& store() const { return m_store; }
+
+    // ------------------------------------------------------------
+    // Volltextsuche (Trigramm-Index, Aufbau im Hintergrund)
+    // ------------------------------------------------------------
+    QVector<TextSearchResult> search(const QString& query, int limit = 200) const;
+    bool isSearchReady() const { return m_search != nullptr; }
+    void finishSearchIndex();   // laufenden Aufbau abwarten (z. B. vor dem Speichern)
+
     QString groupForId(const QString& id) const;
     QList<QString> idsForGroup(const QString& tid) const;
     QStringList allGroups() const;
-    QMap<QString, QString> allTexts() const { return m_texts; }
+    const QMap<QString, TextGroup>& groups() const { return m_groups; }
+
+    // textClient.inc seit Laden/Speichern geändert?
+    bool isIncModified() const { return m_incModified; }
+    void markIncSaved() { m_incModified = false; }
 
     // ------------------------------------------------------------
     // Aufbauhilfen (intern oder für Backend)
@@ -67,9 +126,38 @@ public:
 
     void applyTextsToLayout(const std::vector<std::shared_ptr<WindowData>>& windows);
 
+signals:
+    void languageChanged(int column);
+    void searchIndexReady();
+
 private:
-    // IDS → Text
-    QMap<QString, QString> m_texts;
+    void startSearchIndexBuild();
+    void cancelSearchIndexBuild();
+    void onSearchIndexBuilt();
+    void updateSearchIndex(int row, int column);
+
+    const QString& resolved(ResolvedText& slot, int row) const;
+    void refreshResolved(int row);
+    void invalidateResolved() { ++m_textVersion; }
+
+    // IDS → Text: eine Schlüsselspalte, eine Wertespalte je Sprache
+    TextStore m_store;
+
+    // Suche
+    std::shared_ptr<TextSearchIndex> m_search;
+    QFutureWatcher<std::shared_ptr<TextSearchIndex>> m_searchWatcher;
+    std::shared_ptr<std::atomic_bool> m_searchCancel;
+    QVector<QPair<int, int>> m_pendingSearchUpdates;     // (Zeile, Spalte) während des Aufbaus
+    QHash<int, QVector<TextUsage>> m_usages;             // Zeile → Verwendungen im Layout
+
+    // Anzeigetext-Cache: globale Version (Sprache/Laden/Linken) und
+    // Rückwärtsindex Zeile → Cache-Slots für Einzel-Edits
+    struct ResolvedRef {
+        std::weak_ptr<void> owner;       // Window/Control, hält den Slot am Leben
+        ResolvedText* slot = nullptr;
+    };
+    quint64 m_textVersion = 1;
+    QHash<int, QVector<ResolvedRef>> m_resolvedRefs;
 
     // TID → Gruppe
     QMap<QString, TextGroup> m_groups;
@@ -78,4 +166,5 @@ private:
     QMap<QString, QString> m_idToGroup;
 
     QString m_currentTid;
+    bool m_incModified = false;
 };
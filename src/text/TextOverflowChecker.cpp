@@ -0,0 +1,162 @@
+#include "TextOverflowChecker.h"
+#include "TextManager.h"
+#include "WindowData.h"
+#include "ControlData.h"
+
+#include <QtConcurrent/QtConcurrent>
+#include <QElapsedTimer>
+#include <QFontMetricsF>
+#include <QtMath>
+#include <QDebug>
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+namespace {
+// Buttons zeigen eine Zeile, Statics/Texte umbrechen in der Höhe
+bool isChecked(const QString& type)
+{
+    return type == QLatin1String("WTYPE_BUTTON")
+        || type == QLatin1String("WTYPE_STATIC")
+        || type == QLatin1String("WTYPE_TEXT");
+}
+
+bool isMultiLine(const QString& type)
+{
+    return type != QLatin1String("WTYPE_BUTTON");
+}
+}
+
+TextOverflowChecker::TextOverflowChecker(const QFont& font, int padding)
+    : m_padding(padding)
+{
+    setFont(font);
+}
+
+void TextOverflowChecker::setFont(const QFont& font)
+{
+    m_font = font;
+    m_lineSpacing = qMax(1, qCeil(QFontMetricsF(font).lineSpacing()));
+    m_advance.assign(0x10000, -1.0f);
+}
+
+// ------------------------------------------------------------
+// Breitentabelle: nur noch unbekannte Zeichen messen (seriell)
+// ------------------------------------------------------------
+void TextOverflowChecker::measureMissing(const std::vector<QString>& texts)
+{
+    const QFontMetricsF fm(m_font);
+    const float fallback = float(fm.averageCharWidth());
+
+    for (const QString& text : texts) {
+        for (QChar c : text) {
+            float& adv = m_advance[c.unicode()];
+            if (adv >= 0.0f)
+                continue;
+            // Surrogate einzeln nicht messbar → Durchschnittsbreite je Hälfte
+            adv = c.isSurrogate() ? fallback * 0.5f : float(fm.horizontalAdvance(c));
+        }
+    }
+}
+
+int TextOverflowChecker::widthOf(const QString& text) const
+{
+    float w = 0.0f;
+    for (QChar c : text)
+        w += m_advance[c.unicode()];
+    return int(std::ceil(w));
+}
+
+// ------------------------------------------------------------
+// Prüfen
+// ------------------------------------------------------------
+QVector<TextOverflowChecker::Issue> TextOverflowChecker::check(
+    const std::vector<std::shared_ptr<WindowData>>& windows, const TextManager& texts)
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    struct Job {
+        const WindowData*  wnd;
+        const ControlData* ctrl;
+        int available;
+    };
+
+    std::vector<Job> jobs;
+    for (const auto& wnd : windows) {
+        if (!wnd)
+            continue;
+        for (const auto& ctrl : wnd->controls) {
+            if (!ctrl || ctrl->titleTextRow < 0 || !isChecked(ctrl->type))
+                continue;
+
+            const int width  = ctrl->x2 - ctrl->x1 - 2 * m_padding;
+            const int height = ctrl->y2 - ctrl->y1;
+            const int lines  = isMultiLine(ctrl->type) ? qMax(1, height / m_lineSpacing) : 1;
+            jobs.push_back({ wnd.get(), ctrl.get(), qMax(0, width) * lines });
+        }
+    }
+
+    const TextStore& store = texts.store();
+    const int languages = store.languageCount();
+    const size_t pairs = jobs.size() * size_t(languages);
+
+    // 1) Texte parallel dekodieren (TextTable::decodeValue ist thread-sicher)
+    std::vector<QString> values(pairs);
+    std::vector<size_t> indices(pairs);
+    std::iota(indices.begin(), indices.end(), size_t(0));
+
+    QtConcurrent::blockingMap(indices, [&](size_t i) {
+        const Job& job = jobs[i / size_t(languages)];
+        const int column = int(i % size_t(languages));
+        const int row = job.ctrl->titleTextRow;
+
+        const QHash<int, QString>& edits = store.edits(column);
+        auto edit = edits.constFind(row);
+        if (edit != edits.constEnd()) {
+            values[i] = edit.value();
+            return;
+        }
+        const std::vector<int>& atoms = store.atomsOfColumn(column);
+        if (size_t(row) < atoms.size())
+            values[i] = store.table(column).decodeValue(atoms[size_t(row)]);
+    });
+
+    // 2) Neue Zeichen messen (QFont nur im aufrufenden Thread)
+    measureMissing(values);
+
+    // 3) Breiten parallel summieren
+    std::vector<int> required(pairs, 0);
+    QtConcurrent::blockingMap(indices, [&](size_t i) {
+        required[i] = widthOf(values[i]);
+    });
+
+    QVector<Issue> issues;
+    for (size_t i = 0; i < pairs; ++i) {
+        const Job& job = jobs[i / size_t(languages)];
+        if (required[i] <= job.available)
+            continue;
+
+        const int column = int(i % size_t(languages));
+        Issue issue;
+        issue.window    = job.wnd->name;
+        issue.control   = job.ctrl->id;
+        issue.type      = job.ctrl->type;
+        issue.language  = store.language(column);
+        issue.id        = store.key(job.ctrl->titleTextRow);
+        issue.text      = values[i];
+        issue.available = job.available;
+        issue.required  = required[i];
+        issues.append(issue);
+    }
+
+    std::sort(issues.begin(), issues.end(),
+              [](const Issue& a, const Issue& b) { return a.overflow() > b.overflow(); });
+
+    qInfo().noquote() << QString("[TextOverflowChecker] %1 Controls × %2 Sprachen geprüft, %3 Überläufe (%4 ms)")
+                             .arg(jobs.size())
+                             .arg(languages)
+                             .arg(issues.size())
+                             .arg(timer.elapsed());
+    return issues;
+}
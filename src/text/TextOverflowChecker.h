@@ -0,0 +1,55 @@
+#pragma once
+
+#include <QFont>
+#include <QString>
+#include <QVector>
+#include <memory>
+#include <vector>
+
+struct WindowData;
+class TextManager;
+
+// ------------------------------------------------------------
+// TextOverflowChecker – Titel aller Controls in allen Sprachen
+// gegen die Control-Breite messen
+// ------------------------------------------------------------
+// Gemessen wird mit einer Breitentabelle je UTF-16-Einheit, die
+// einmal pro Zeichen über QFontMetricsF gefüllt und über mehrere
+// Läufe behalten wird (ohne Kerning – für "passt / passt nicht"
+// genau genug). Texte dekodieren und Breiten summieren läuft
+// parallel über alle (Control × Sprache)-Paare; nur das Messen
+// neuer Zeichen passiert im aufrufenden Thread.
+// ------------------------------------------------------------
+class TextOverflowChecker
+{
+public:
+    struct Issue {
+        QString window;        // APP_xxx
+        QString control;       // WIDC_xxx
+        QString type;          // WTYPE_xxx
+        QString language;
+        QString id;            // IDS_xxx
+        QString text;
+        int available = 0;     // nutzbare Breite in px (× Zeilen bei Statics)
+        int required  = 0;     // gemessene Textbreite in px
+        int overflow() const { return required - available; }
+    };
+
+    explicit TextOverflowChecker(const QFont& font = QFont("Arial", 9), int padding = 4);
+
+    void setFont(const QFont& font);
+    const QFont& font() const { return m_font; }
+
+    // Alle Sprachen des TextManagers; Ergebnis nach Überlauf absteigend
+    QVector<Issue> check(const std::vector<std::shared_ptr<WindowData>>& windows,
+                         const TextManager& texts);
+
+private:
+    void measureMissing(const std::vector<QString>& texts);
+    int widthOf(const QString& text) const;
+
+    QFont m_font;
+    int m_padding = 4;
+    int m_lineSpacing = 0;
+    std::vector<float> m_advance;          // UTF-16-Einheit → Breite, < 0 = noch nicht gemessen
+};
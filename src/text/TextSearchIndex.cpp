@@ -0,0 +1,200 @@
+#include "TextSearchIndex.h"
+#include "TextTable.h"
+
+#include <algorithm>
+
+namespace {
+inline quint64 packTrigram(QChar a, QChar b, QChar c)
+{
+    return (quint64(a.unicode()) << 32) | (quint64(b.unicode()) << 16) | quint64(c.unicode());
+}
+}
+
+void TextSearchIndex::trigramsOf(const QString& folded, std::vector<quint64>& out)
+{
+    out.clear();
+    if (folded.size() < 3)
+        return;
+
+    out.reserve(size_t(folded.size() - 2));
+    for (qsizetype i = 0; i + 2 < folded.size(); ++i)
+        out.push_back(packTrigram(folded[i], folded[i + 1], folded[i + 2]));
+
+    std::sort(out.begin(), out.end());
+    out.erase(std::unique(out.begin(), out.end()), out.end());
+}
+
+// ------------------------------------------------------------
+// Aufbau (Hintergrund-Thread, eigenes Objekt)
+// ------------------------------------------------------------
+void TextSearchIndex::build(const std::vector<Column>& columns, int rowCount,
+                            const std::atomic_bool* cancel)
+{
+    m_columns = qMax(1, int(columns.size()));
+    m_docs.assign(size_t(rowCount) * size_t(m_columns), QString());
+    m_postings.clear();
+
+    std::vector<quint64> grams;
+
+    for (int row = 0; row < rowCount; ++row)
+    {
+        if (cancel && (row & 0x3FF) == 0 && cancel->load())
+            return;
+
+        for (int col = 0; col < int(columns.size()); ++col)
+        {
+            const Column& c = columns[size_t(col)];
+
+            QString text;
+            auto edit = c.edits.constFind(row);
+            if (edit != c.edits.constEnd())
+                text = edit.value();
+            else if (size_t(row) < c.atomOfRow.size() && c.atomOfRow[size_t(row)] >= 0 && c.table)
+                text = c.table->decodeValue(c.atomOfRow[size_t(row)]);
+
+            if (text.isEmpty())
+                continue;
+
+            const quint32 doc = docId(row, col);
+            QString& folded = m_docs[doc];
+            folded = text.toCaseFolded();
+
+            // Dokumente kommen aufsteigend → push_back hält die Listen sortiert
+            trigramsOf(folded, grams);
+            for (quint64 g : grams)
+                m_postings[g].push_back(doc);
+        }
+    }
+}
+
+// ------------------------------------------------------------
+// Inkrementelle Pflege
+// ------------------------------------------------------------
+void TextSearchIndex::addDoc(quint32 doc, const QString& folded)
+{
+    std::vector<quint64> grams;
+    trigramsOf(folded, grams);
+    for (quint64 g : grams) {
+        std::vector<quint32>& list = m_postings[g];
+        auto it = std::lower_bound(list.begin(), list.end(), doc);
+        if (it == list.end() || *it != doc)
+            list.insert(it, doc);
+    }
+}
+
+void TextSearchIndex::removeDoc(quint32 doc, const QString& folded)
+{
+    std::vector<quint64> grams;
+    trigramsOf(folded, grams);
+    for (quint64 g : grams) {
+        auto p = m_postings.find(g);
+        if (p == m_postings.end())
+            continue;
+        std::vector<quint32>& list = p.value();
+        auto it = std::lower_bound(list.begin(), list.end(), doc);
+        if (it != list.end() && *it == doc)
+            list.erase(it);
+        if (list.empty())
+            m_postings.erase(p);
+    }
+}
+
+void TextSearchIndex::setColumnCount(int columns)
+{
+    if (columns <= m_columns)
+        return;
+
+    const quint32 oldColumns = quint32(m_columns);
+    const quint32 newColumns = quint32(columns);
+    auto remap = [&](quint32 doc) { return doc / oldColumns * newColumns + doc % oldColumns; };
+
+    const size_t rows = (m_docs.size() + oldColumns - 1) / oldColumns;
+    std::vector<QString> docs(rows * newColumns);
+    for (quint32 doc = 0; doc < m_docs.size(); ++doc)
+        docs[remap(doc)] = std::move(m_docs[doc]);
+    m_docs.swap(docs);
+
+    for (std::vector<quint32>& list : m_postings)
+        for (quint32& doc : list)
+            doc = remap(doc);
+
+    m_columns = columns;
+}
+
+void TextSearchIndex::update(int row, int column, const QString& text)
+{
+    if (row < 0 || column < 0)
+        return;
+    if (column >= m_columns)
+        setColumnCount(column + 1);
+
+    const quint32 doc = docId(row, column);
+    if (doc >= m_docs.size())
+        m_docs.resize(size_t(doc) + 1);
+
+    const QString folded = text.toCaseFolded();
+    if (m_docs[doc] == folded)
+        return;
+
+    removeDoc(doc, m_docs[doc]);
+    m_docs[doc] = folded;
+    addDoc(doc, folded);
+}
+
+// ------------------------------------------------------------
+// Suche
+// ------------------------------------------------------------
+QVector<TextSearchIndex::Hit> TextSearchIndex::find(const QString& query, int limit) const
+{
+    QVector<Hit> hits;
+    const QString q = query.toCaseFolded();
+    if (q.isEmpty())
+        return hits;
+
+    auto accept = [&](quint32 doc) {
+        if (!m_docs[doc].contains(q))
+            return true;
+        hits.append({ int(doc / quint32(m_columns)), int(doc % quint32(m_columns)) });
+        return hits.size() < limit;
+    };
+
+    // Kurze Query → linear (immer noch nur ein contains() je Text)
+    if (q.size() < 3) {
+        for (quint32 doc = 0; doc < m_docs.size(); ++doc)
+            if (!m_docs[doc].isEmpty() && !accept(doc))
+                break;
+        return hits;
+    }
+
+    std::vector<quint64> grams;
+    trigramsOf(q, grams);
+
+    std::vector<const std::vector<quint32>*> lists;
+    lists.reserve(grams.size());
+    for (quint64 g : grams) {
+        auto it = m_postings.constFind(g);
+        if (it == m_postings.constEnd())
+            return hits;                         // ein Trigramm fehlt → kein Treffer
+        lists.push_back(&it.value());
+    }
+
+    std::sort(lists.begin(), lists.end(),
+              [](const auto* a, const auto* b) { return a->size() < b->size(); });
+
+    // Schnitt, beginnend mit der kürzesten Liste
+    std::vector<quint32> candidates = *lists.front();
+    std::vector<quint32> next;
+    for (size_t i = 1; i < lists.size() && !candidates.empty(); ++i) {
+        next.clear();
+        std::set_intersection(candidates.begin(), candidates.end(),
+                              lists[i]->begin(), lists[i]->end(),
+                              std::back_inserter(next));
+        candidates.swap(next);
+    }
+
+    for (quint32 doc : candidates)
+        if (!accept(doc))
+            break;
+
+    return hits;
+}
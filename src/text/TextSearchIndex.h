@@ -0,0 +1,66 @@
+#pragma once
+
+#include <QHash>
+#include <QString>
+#include <QVector>
+#include <atomic>
+#include <vector>
+
+class TextTable;
+
+// ------------------------------------------------------------
+// TextSearchIndex – Trigramm-Index über alle Textwerte
+// ------------------------------------------------------------
+// Jede Zelle (Zeile × Sprache) ist ein Dokument. Texte werden
+// case-gefaltet abgelegt; pro Trigramm (3 UTF-16-Einheiten) gibt
+// es eine sortierte Posting-Liste. Eine Suche schneidet die
+// Listen der Query-Trigramme (kürzeste zuerst) und prüft die
+// wenigen Kandidaten per contains(). Queries < 3 Zeichen laufen
+// linear über die gefalteten Texte.
+//
+// build() läuft im Hintergrund auf einem eigenen Objekt, das
+// danach im GUI-Thread übernommen wird; update() hält es bei
+// Edits aktuell. Kommt eine Sprache hinzu, werden die Dokument-
+// nummern auf die neue Spaltenzahl umgerechnet (monoton, die
+// Posting-Listen bleiben sortiert) – kein Neuaufbau nötig.
+// ------------------------------------------------------------
+class TextSearchIndex
+{
+public:
+    struct Hit {
+        int row = -1;
+        int column = -1;
+    };
+
+    // Eingaben für den Hintergrund-Aufbau (im GUI-Thread kopiert)
+    struct Column {
+        const TextTable*     table = nullptr;   // nur decodeValue() – thread-sicher
+        std::vector<int>     atomOfRow;
+        QHash<int, QString>  edits;
+    };
+
+    void build(const std::vector<Column>& columns, int rowCount,
+               const std::atomic_bool* cancel = nullptr);
+
+    // Spalte jenseits der gebauten Sprachen → Index wächst mit
+    // (neu hinzugefügte Sprache, z. B. über TextStore::addLanguage)
+    void update(int row, int column, const QString& text);
+    void setColumnCount(int columns);
+
+    QVector<Hit> find(const QString& query, int limit = 200) const;
+
+    int columnCount() const { return m_columns; }
+    int documentCount() const { return int(m_docs.size()); }
+    int trigramCount() const { return m_postings.size(); }
+
+private:
+    quint32 docId(int row, int column) const { return quint32(row) * quint32(m_columns) + quint32(column); }
+
+    static void trigramsOf(const QString& folded, std::vector<quint64>& out);
+    void addDoc(quint32 doc, const QString& folded);
+    void removeDoc(quint32 doc, const QString& folded);
+
+    int m_columns = 1;
+    std::vector<QString>                   m_docs;       // gefaltete Texte je Dokument
+    QHash<quint64, std::vector<quint32>>   m_postings;   // Trigramm → sortierte Dokumente
+};
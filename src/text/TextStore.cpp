@@ -0,0 +1,335 @@
+#include "TextStore.h"
+
+#include <QtConcurrent/QtConcurrent>
+#include <QElapsedTimer>
+#include <QDebug>
+#include <algorithm>
+
+namespace {
+// Schlüssel einer Datei in Atom-Reihenfolge (läuft im Worker-Thread)
+QStringList readKeys(TextTable& table, const QString& path)
+{
+    QStringList keys;
+    if (!table.open(path))
+        return keys;
+
+    keys.reserve(table.size());
+    for (int atom = 0; atom < table.size(); ++atom)
+        keys << table.key(atom);
+    return keys;
+}
+}
+
+void TextStore::clear()
+{
+    m_keys.clear();
+    m_rowOf.clear();
+    m_columns.clear();
+    m_current = 0;
+}
+
+// ------------------------------------------------------------
+// Laden: alle Sprachen parallel öffnen, Schlüssel zusammenführen
+// ------------------------------------------------------------
+bool TextStore::load(const QVector<Source>& sources)
+{
+    clear();
+    if (sources.isEmpty())
+        return false;
+
+    QElapsedTimer timer;
+    timer.start();
+
+    m_columns.resize(size_t(sources.size()));
+    QList<int> indices;
+    for (int i = 0; i < sources.size(); ++i) {
+        Column& c = m_columns[size_t(i)];
+        c.language = sources[i].language;
+        c.path     = sources[i].path;
+        c.table    = std::make_unique<TextTable>();
+        indices << i;
+    }
+
+    const QList<QStringList> keys = QtConcurrent::blockingMapped<QList<QStringList>>(
+        indices, [this](int i) {
+            Column& c = m_columns[size_t(i)];
+            return readKeys(*c.table, c.path);
+        });
+
+    // Zusammenführen seriell: Spalte 0 bestimmt die Zeilenreihenfolge
+    int opened = 0;
+    for (int i = 0; i < int(m_columns.size()); ++i) {
+        if (m_columns[size_t(i)].table->isOpen())
+            ++opened;
+        mapColumn(m_columns[size_t(i)], keys[i]);
+    }
+
+    qInfo().noquote() << QString("[TextStore] %1/%2 Sprachen, %3 Schlüssel in %4 ms geladen.")
+                             .arg(opened)
+                             .arg(m_columns.size())
+                             .arg(m_keys.size())
+                             .arg(timer.elapsed());
+    return opened > 0;
+}
+
+void TextStore::mapColumn(Column& column, const QStringList& keys)
+{
+    std::vector<int> rows(size_t(keys.size()));
+    for (int atom = 0; atom < keys.size(); ++atom)
+        rows[size_t(atom)] = addRow(keys[atom]);
+
+    column.atomOfRow.assign(size_t(m_keys.size()), -1);
+    for (int atom = 0; atom < keys.size(); ++atom)
+        column.atomOfRow[size_t(rows[size_t(atom)])] = atom;
+}
+
+// ------------------------------------------------------------
+// Sprachen
+// ------------------------------------------------------------
+int TextStore::addLanguage(const QString& language)
+{
+    Column c;
+    c.language = language;
+    c.table    = std::make_unique<TextTable>();
+    m_columns.push_back(std::move(c));
+    return languageCount() - 1;
+}
+
+QStringList TextStore::languages() const
+{
+    QStringList out;
+    for (const Column& c : m_columns)
+        out << c.language;
+    return out;
+}
+
+QString TextStore::language(int column) const
+{
+    if (column < 0 || column >= languageCount())
+        return {};
+    return m_columns[size_t(column)].language;
+}
+
+QString TextStore::sourcePath(int column) const
+{
+    if (column < 0 || column >= languageCount())
+        return {};
+    return m_columns[size_t(column)].path;
+}
+
+int TextStore::languageIndex(const QString& language) const
+{
+    for (int i = 0; i < languageCount(); ++i)
+        if (m_columns[size_t(i)].language.compare(language, Qt::CaseInsensitive) == 0)
+            return i;
+    return -1;
+}
+
+bool TextStore::setCurrentColumn(int column)
+{
+    if (column < 0 || column >= languageCount() || column == m_current)
+        return false;
+    m_current = column;
+    return true;
+}
+
+// ------------------------------------------------------------
+// Schlüssel / Werte
+// ------------------------------------------------------------
+int TextStore::addRow(const QString& id)
+{
+    auto it = m_rowOf.constFind(id);
+    if (it != m_rowOf.constEnd())
+        return it.value();
+
+    const int row = m_keys.size();
+    m_keys << id;
+    m_rowOf.insert(id, row);
+    return row;
+}
+
+bool TextStore::validCell(int row, int column) const
+{
+    return row >= 0 && row < m_keys.size() && column >= 0 && column < languageCount();
+}
+
+int TextStore::atom(int row, int column) const
+{
+    if (!validCell(row, column))
+        return -1;
+    const Column& c = m_columns[size_t(column)];
+    return size_t(row) < c.atomOfRow.size() ? c.atomOfRow[size_t(row)] : -1;
+}
+
+QString TextStore::value(int row, int column) const
+{
+    if (!validCell(row, column))
+        return {};
+
+    const Column& c = m_columns[size_t(column)];
+    auto it = c.edits.constFind(row);
+    if (it != c.edits.constEnd())
+        return it.value();
+
+    return c.table->value(atom(row, column));
+}
+
+bool TextStore::hasValue(int row, int column) const
+{
+    if (!validCell(row, column))
+        return false;
+    return m_columns[size_t(column)].edits.contains(row) || atom(row, column) >= 0;
+}
+
+void TextStore::setValue(int row, int column, const QString& text)
+{
+    if (!validCell(row, column))
+        return;
+
+    Column& c = m_columns[size_t(column)];
+    const int a = atom(row, column);
+
+    // Zurück auf den Dateistand → keine Änderung mehr
+    if (a >= 0 && c.table->value(a) == text) {
+        c.edits.remove(row);
+        return;
+    }
+    c.edits.insert(row, text);
+}
+
+bool TextStore::isEdited(int row, int column) const
+{
+    return validCell(row, column) && m_columns[size_t(column)].edits.contains(row);
+}
+
+int TextStore::editCount(int column) const
+{
+    if (column < 0 || column >= languageCount())
+        return 0;
+    return m_columns[size_t(column)].edits.size();
+}
+
+// ------------------------------------------------------------
+// Patch-Save
+// ------------------------------------------------------------
+bool TextStore::canPatch(int column) const
+{
+    return column >= 0 && column < languageCount() && m_columns[size_t(column)].table->isOpen();
+}
+
+QByteArray TextStore::patchedColumn(int column) const
+{
+    if (!canPatch(column))
+        return {};
+
+    const Column& c = m_columns[size_t(column)];
+    const TextTable& t = *c.table;
+    const QByteArrayView src = t.bytes();
+
+    struct Patch {
+        qint64 offset;
+        qint64 bytes;
+        QByteArray data;
+    };
+    std::vector<Patch> patches;
+    std::vector<int> added;
+    patches.reserve(size_t(c.edits.size()));
+
+    for (auto it = c.edits.constBegin(); it != c.edits.constEnd(); ++it) {
+        const int a = atom(it.key(), column);
+        if (a < 0) {
+            added.push_back(it.key());
+            continue;
+        }
+        const TextTable::Span span = t.valueSpan(a);
+        patches.push_back({ span.offset, span.bytes, t.encode(singleLine(it.value())) });
+    }
+
+    std::sort(patches.begin(), patches.end(),
+              [](const Patch& a, const Patch& b) { return a.offset < b.offset; });
+    std::sort(added.begin(), added.end());
+
+    QByteArray out;
+    out.reserve(src.size() + qsizetype(added.size()) * 64);
+
+    qint64 pos = 0;
+    for (const Patch& p : patches) {
+        out.append(src.sliced(pos, p.offset - pos));
+        out.append(p.data);
+        pos = p.offset + p.bytes;
+    }
+    out.append(src.sliced(pos));
+
+    if (!added.empty()) {
+        const QByteArray eol = t.encode(t.usesCrLf() ? u"\r\n" : u"\n");
+        const QByteArray lf  = t.encode(u"\n");
+
+        // Letzte Zeile ohne Umbruch → erst abschließen
+        if (!out.isEmpty() && !out.endsWith(lf))
+            out.append(eol);
+        for (int row : added) {
+            out.append(t.encode(QString(m_keys[row] + u'\t' + singleLine(c.edits.value(row)))));
+            out.append(eol);
+        }
+    }
+    return out;
+}
+
+QByteArray TextStore::compactedColumn(int column) const
+{
+    if (column < 0 || column >= languageCount())
+        return {};
+
+    // Kodierung, BOM und Zeilenende der bisherigen Datei beibehalten
+    const TextTable& t = *m_columns[size_t(column)].table;
+    const bool mapped = t.isOpen();
+    const QString eol = mapped && t.usesCrLf() ? QStringLiteral("\r\n") : QStringLiteral("\n");
+
+    QString text;
+    if (mapped && t.hasBom())
+        text += QChar(0xFEFF);
+
+    for (int row = 0; row < rowCount(); ++row)
+        if (hasValue(row, column))
+            text += m_keys[row] + u'\t' + singleLine(value(row, column)) + eol;
+
+    return mapped ? t.encode(text) : text.toUtf8();
+}
+
+QString TextStore::singleLine(const QString& text)
+{
+    // Ein Eintrag = eine Zeile
+    if (!text.contains(u'\n') && !text.contains(u'\r'))
+        return text;
+    QString s = text;
+    s.replace(QStringLiteral("\r\n"), QStringLiteral(" ")).replace(u'\n', u' ').replace(u'\r', u' ');
+    return s;
+}
+
+// ------------------------------------------------------------
+// Speichern: Mapping lösen / neu aufbauen (Zeilen bleiben stabil)
+// ------------------------------------------------------------
+void TextStore::detachColumn(int column)
+{
+    if (column < 0 || column >= languageCount())
+        return;
+    m_columns[size_t(column)].table->close();
+}
+
+bool TextStore::reattachColumn(int column, const QString& path, bool saved)
+{
+    if (column < 0 || column >= languageCount())
+        return false;
+
+    Column& c = m_columns[size_t(column)];
+    c.path = path;
+
+    const QStringList keys = readKeys(*c.table, path);
+    if (!c.table->isOpen())
+        return false;
+
+    mapColumn(c, keys);
+    if (saved)
+        c.edits.clear();
+    return true;
+}
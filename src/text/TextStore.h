@@ -0,0 +1,96 @@
+#pragma once
+
+#include "text/TextTable.h"
+
+#include <QHash>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <memory>
+#include <vector>
+
+// ------------------------------------------------------------
+// TextStore – spaltenweiser Textspeicher für mehrere Sprachen
+// ------------------------------------------------------------
+// Eine gemeinsame Schlüsselspalte (IDS → Zeile) und pro Sprache
+// eine Wertespalte (gemappte TextTable + Änderungen). Zeilen sind
+// stabil: Layout-Verknüpfungen speichern nur die Zeile, der
+// Sprachwechsel ändert nur den Spaltenindex.
+// ------------------------------------------------------------
+class TextStore
+{
+public:
+    struct Source {
+        QString language;   // z. B. "English"
+        QString path;       // textClient.txt dieser Sprache
+    };
+
+    // Öffnet alle Sprachen parallel; Spalte 0 = erste Quelle
+    bool load(const QVector<Source>& sources);
+    void clear();
+
+    // Leere Spalte ohne Datei (z. B. Texte aus Tokens vor dem Laden)
+    int addLanguage(const QString& language);
+
+    // --- Sprachen ---
+    int languageCount() const { return int(m_columns.size()); }
+    QStringList languages() const;
+    QString language(int column) const;
+    QString sourcePath(int column) const;
+    int languageIndex(const QString& language) const;
+
+    int currentColumn() const { return m_current; }
+    bool setCurrentColumn(int column);
+
+    // --- Schlüsselspalte ---
+    int rowCount() const { return m_keys.size(); }
+    int row(const QString& id) const { return m_rowOf.value(id, -1); }
+    const QString& key(int row) const { return m_keys[row]; }
+    int addRow(const QString& id);
+
+    // --- Werte ---
+    QString value(int row) const { return value(row, m_current); }
+    QString value(int row, int column) const;
+    bool hasValue(int row, int column) const;
+    void setValue(int row, int column, const QString& text);
+
+    // Änderungen gegenüber der Datei
+    bool isEdited(int row, int column) const;
+    int editCount(int column) const;
+    const QHash<int, QString>& edits(int column) const { return m_columns[size_t(column)].edits; }
+
+    // Zugriff auf die Datei (Atom/Zeile für Patch-Saves)
+    const TextTable& table(int column) const { return *m_columns[size_t(column)].table; }
+    int atom(int row, int column) const;
+    const std::vector<int>& atomsOfColumn(int column) const { return m_columns[size_t(column)].atomOfRow; }
+
+    // Patch-Save: Dateiinhalt + Änderungen (nur geänderte Werte
+    // ersetzt, neue Zeilen angehängt, Kodierung/Zeilenende bleiben)
+    bool canPatch(int column) const;
+    QByteArray patchedColumn(int column) const;
+    // Kompaktiert: alle Werte in Zeilenreihenfolge neu geschrieben
+    // (ohne Kommentare); Kodierung/BOM/Zeilenende der Datei, sonst UTF-8
+    QByteArray compactedColumn(int column) const;
+    static QString singleLine(const QString& text);   // Zeilenumbrüche → Leerzeichen
+
+    // Spalte vom Dateisystem lösen / neu einlesen (beim Speichern)
+    void detachColumn(int column);
+    bool reattachColumn(int column, const QString& path, bool saved);
+
+private:
+    struct Column {
+        QString language;
+        QString path;
+        std::unique_ptr<TextTable> table;
+        std::vector<int> atomOfRow;        // Zeile → Atom in der Datei (-1 = fehlt)
+        QHash<int, QString> edits;         // Zeile → geänderter Text
+    };
+
+    bool validCell(int row, int column) const;
+    void mapColumn(Column& column, const QStringList& keys);
+
+    QStringList         m_keys;
+    QHash<QString, int> m_rowOf;
+    std::vector<Column> m_columns;
+    int m_current = 0;
+};
@@ -0,0 +1,360 @@
+#include "TextTable.h"
+
+#include <QElapsedTimer>
+#include <QStringDecoder>
+#include <QStringEncoder>
+#include <QtEndian>
+#include <QDebug>
+
+namespace {
+constexpr quint64 FnvOffset = 14695981039346656037ull;
+constexpr quint64 FnvPrime  = 1099511628211ull;
+
+inline quint64 fnvStep(quint64 h, char16_t c)
+{
+    return (h ^ c) * FnvPrime;
+}
+
+// wide = UTF-16-Einheiten. In UTF-8 sind Bytes > 0x7F nur Teile einer
+// Sequenz – 0x85/0xA0 wären als QChar NEL/NBSP, sind hier aber
+// Folgebytes (à, Å, 你 …) und dürfen nicht abgeschnitten werden.
+inline bool isSpaceUnit(char16_t c, bool wide)
+{
+    return c == u' ' || c == u'\t' || c == u'\r' || c == u'\v' || c == u'\f'
+        || (wide && c > 0x7F && QChar(c).isSpace());
+}
+
+// Standardgröße des LRU in Zeichen (~8 MB UTF-16)
+constexpr qsizetype DefaultCacheChars = 4 * 1024 * 1024;
+}
+
+TextTable::TextTable()
+{
+    m_cache.setMaxCost(DefaultCacheChars);
+}
+
+TextTable::~TextTable()
+{
+    close();
+}
+
+void TextTable::close()
+{
+    m_cache.clear();
+    m_entries.clear();
+    m_index.clear();
+    m_overflow.clear();
+
+    if (m_data && m_fallback.isEmpty())
+        m_file.unmap(const_cast<uchar*>(m_data));
+    m_data = nullptr;
+    m_size = 0;
+    m_fallback.clear();
+    m_bom = false;
+    m_crlf = false;
+
+    if (m_file.isOpen())
+        m_file.close();
+    m_path.clear();
+}
+
+// ------------------------------------------------------------
+// Datei mappen + Index bauen
+// ------------------------------------------------------------
+bool TextTable::open(const QString& path)
+{
+    close();
+
+    QElapsedTimer timer;
+    timer.start();
+
+    m_file.setFileName(path);
+    if (!m_file.open(QIODevice::ReadOnly)) {
+        qWarning() << "[TextTable] Datei konnte nicht geöffnet werden:" << path;
+        return false;
+    }
+
+    m_size = m_file.size();
+    if (m_size > 0) {
+        m_data = m_file.map(0, m_size);
+        if (!m_data) {
+            // z. B. Netzlaufwerk ohne mmap → einmal komplett lesen
+            m_fallback = m_file.readAll();
+            m_data = reinterpret_cast<const uchar*>(m_fallback.constData());
+        }
+    } else {
+        // leere Datei: gültiger Zeiger, aber kein Inhalt
+        m_fallback = QByteArray(1, '\0');
+        m_data = reinterpret_cast<const uchar*>(m_fallback.constData());
+    }
+    m_path = path;
+
+    // Kodierung wie EncodingUtils::openTextStream (BOM, sonst UTF-8)
+    qint64 begin = 0;
+    if (m_size >= 2 && m_data[0] == 0xFF && m_data[1] == 0xFE) {
+        m_encoding = Encoding::Utf16LE;
+        begin = 2;
+    } else if (m_size >= 2 && m_data[0] == 0xFE && m_data[1] == 0xFF) {
+        m_encoding = Encoding::Utf16BE;
+        begin = 2;
+    } else if (m_size >= 3 && m_data[0] == 0xEF && m_data[1] == 0xBB && m_data[2] == 0xBF) {
+        m_encoding = Encoding::Utf8;
+        begin = 3;
+    } else {
+        m_encoding = Encoding::Utf8;
+    }
+    m_unit = m_encoding == Encoding::Utf8 ? 1 : 2;
+    m_bom  = begin > 0;
+
+    buildIndex(begin);
+
+    qInfo().noquote() << QString("[TextTable] %1 Einträge indiziert (%2 KB, %3 ms): %4")
+                             .arg(m_entries.size())
+                             .arg(m_size / 1024)
+                             .arg(timer.elapsed())
+                             .arg(path);
+    return true;
+}
+
+char16_t TextTable::unitAt(qint64 byteOffset) const
+{
+    switch (m_encoding) {
+    case Encoding::Utf16LE: return qFromLittleEndian<quint16>(m_data + byteOffset);
+    case Encoding::Utf16BE: return qFromBigEndian<quint16>(m_data + byteOffset);
+    case Encoding::Utf8:    break;
+    }
+    return m_data[byteOffset];
+}
+
+// ------------------------------------------------------------
+// Zeilen scannen: "IDS_xxx <ws> Text"
+// ------------------------------------------------------------
+// Entspricht dem früheren processTextLine(): Zeilen mit "//" am
+// Anfang werden übersprungen, Einträge ohne Text ebenso, bei
+// doppelten IDs gewinnt der letzte.
+// ------------------------------------------------------------
+void TextTable::buildIndex(qint64 begin)
+{
+    const int u = m_unit;
+    const bool wide = u == 2;
+    const qint64 end = m_size - (m_size - begin) % u;
+
+    // grobe Schätzung: ~60 Byte pro Zeile
+    m_entries.reserve(size_t(m_size / 60));
+
+    quint32 lineNo = 0;
+    qint64 pos = begin;
+
+    while (pos < end)
+    {
+        const qint64 lineStart = pos;
+        while (pos < end && unitAt(pos) != u'\n')
+            pos += u;
+        const qint64 lineEnd = pos;
+        pos += u;
+        const quint32 line = lineNo++;
+
+        if (line == 0 && lineEnd < end)
+            m_crlf = lineEnd > lineStart && unitAt(lineEnd - u) == u'\r';
+
+        if (lineEnd - lineStart >= 2 * u && unitAt(lineStart) == u'/' && unitAt(lineStart + u) == u'/')
+            continue;
+
+        qint64 p = lineStart;
+        while (p < lineEnd && isSpaceUnit(unitAt(p), wide))
+            p += u;
+
+        if (lineEnd - p < 4 * u
+            || unitAt(p) != u'I' || unitAt(p + u) != u'D'
+            || unitAt(p + 2 * u) != u'S' || unitAt(p + 3 * u) != u'_')
+            continue;
+
+        const qint64 keyStart = p;
+        while (p < lineEnd && !isSpaceUnit(unitAt(p), wide))
+            p += u;
+        const qint64 keyEnd = p;
+
+        while (p < lineEnd && isSpaceUnit(unitAt(p), wide))
+            p += u;
+        qint64 valueEnd = lineEnd;
+        while (valueEnd > p && isSpaceUnit(unitAt(valueEnd - u), wide))
+            valueEnd -= u;
+
+        if (valueEnd <= p || (keyEnd - keyStart) / u > 0xFFFF)
+            continue;
+
+        Entry e;
+        e.keyOffset   = quint32(keyStart);
+        e.keyUnits    = quint16((keyEnd - keyStart) / u);
+        e.valueOffset = quint32(p);
+        e.valueUnits  = quint32((valueEnd - p) / u);
+        e.line        = line;
+        insert(e);
+    }
+
+    m_entries.shrink_to_fit();
+}
+
+void TextTable::insert(const Entry& e)
+{
+    quint64 h = FnvOffset;
+    for (quint32 i = 0; i < e.keyUnits; ++i)
+        h = fnvStep(h, unitAt(e.keyOffset + qint64(i) * m_unit));
+
+    auto it = m_index.constFind(h);
+    if (it == m_index.constEnd()) {
+        m_index.insert(h, int(m_entries.size()));
+        m_entries.push_back(e);
+        return;
+    }
+
+    if (keyEquals(m_entries[size_t(it.value())], e)) {
+        m_entries[size_t(it.value())] = e;   // Duplikat: letzter gewinnt
+        return;
+    }
+
+    // Echte Hash-Kollision (selten) → über den Klartext-Schlüssel
+    const QString key = decode(e.keyOffset, e.keyUnits);
+    auto ov = m_overflow.constFind(key);
+    if (ov != m_overflow.constEnd()) {
+        m_entries[size_t(ov.value())] = e;
+        return;
+    }
+    m_overflow.insert(key, int(m_entries.size()));
+    m_entries.push_back(e);
+}
+
+bool TextTable::keyEquals(const Entry& e, QStringView id) const
+{
+    if (id.size() != e.keyUnits)
+        return false;
+    for (qsizetype i = 0; i < id.size(); ++i)
+        if (unitAt(e.keyOffset + i * m_unit) != id[i].unicode())
+            return false;
+    return true;
+}
+
+bool TextTable::keyEquals(const Entry& a, const Entry& b) const
+{
+    if (a.keyUnits != b.keyUnits)
+        return false;
+    for (quint32 i = 0; i < a.keyUnits; ++i)
+        if (unitAt(a.keyOffset + qint64(i) * m_unit) != unitAt(b.keyOffset + qint64(i) * m_unit))
+            return false;
+    return true;
+}
+
+// ------------------------------------------------------------
+// Zugriff
+// ------------------------------------------------------------
+int TextTable::atom(QStringView id) const
+{
+    if (!m_data || id.isEmpty())
+        return -1;
+
+    quint64 h = FnvOffset;
+    for (QChar c : id)
+        h = fnvStep(h, c.unicode());
+
+    auto it = m_index.constFind(h);
+    if (it != m_index.constEnd() && keyEquals(m_entries[size_t(it.value())], id))
+        return it.value();
+
+    if (m_overflow.isEmpty())
+        return -1;
+    return m_overflow.value(id.toString(), -1);
+}
+
+QString TextTable::decode(qint64 byteOffset, qint64 units) const
+{
+    const char* bytes = reinterpret_cast<const char*>(m_data + byteOffset);
+
+    switch (m_encoding) {
+    case Encoding::Utf8:
+        return QString::fromUtf8(bytes, units);
+    case Encoding::Utf16LE: {
+        QStringDecoder dec(QStringDecoder::Utf16LE);
+        return dec(QByteArrayView(bytes, units * 2));
+    }
+    case Encoding::Utf16BE: {
+        QStringDecoder dec(QStringDecoder::Utf16BE);
+        return dec(QByteArrayView(bytes, units * 2));
+    }
+    }
+    return {};
+}
+
+QString TextTable::key(int atom) const
+{
+    if (atom < 0 || atom >= size())
+        return {};
+    const Entry& e = m_entries[size_t(atom)];
+    return decode(e.keyOffset, e.keyUnits);
+}
+
+int TextTable::line(int atom) const
+{
+    if (atom < 0 || atom >= size())
+        return -1;
+    return int(m_entries[size_t(atom)].line);
+}
+
+TextTable::Span TextTable::valueSpan(int atom) const
+{
+    if (atom < 0 || atom >= size())
+        return {};
+    const Entry& e = m_entries[size_t(atom)];
+    return { qint64(e.valueOffset), qint64(e.valueUnits) * m_unit };
+}
+
+QByteArrayView TextTable::bytes() const
+{
+    if (!m_data)
+        return {};
+    return QByteArrayView(reinterpret_cast<const char*>(m_data), m_size);
+}
+
+QByteArray TextTable::encode(QStringView text) const
+{
+    switch (m_encoding) {
+    case Encoding::Utf8:
+        return text.toUtf8();
+    case Encoding::Utf16LE: {
+        QStringEncoder enc(QStringEncoder::Utf16LE);
+        return enc(text);
+    }
+    case Encoding::Utf16BE: {
+        QStringEncoder enc(QStringEncoder::Utf16BE);
+        return enc(text);
+    }
+    }
+    return {};
+}
+
+QString TextTable::decodeValue(int atom) const
+{
+    if (atom < 0 || atom >= size())
+        return {};
+    const Entry& e = m_entries[size_t(atom)];
+
+    // Wie früher split(\s+).join(" "): Leerraum zusammenfassen
+    return decode(e.valueOffset, e.valueUnits).simplified();
+}
+
+QString TextTable::value(int atom) const
+{
+    if (atom < 0 || atom >= size())
+        return {};
+
+    if (const QString* cached = m_cache.object(atom))
+        return *cached;
+
+    QString v = decodeValue(atom);
+    m_cache.insert(atom, new QString(v), qMax<qsizetype>(1, v.size()));
+    return v;
+}
+
+QString TextTable::value(QStringView id) const
+{
+    return value(atom(id));
+}
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <QCache>
+#include <QFile>
+#include <QHash>
+#include <QString>
+#include <QStringView>
+#include <vector>
+
+// ------------------------------------------------------------
+// TextTable – textClient.txt direkt aus der gemappten Datei
+// ------------------------------------------------------------
+// open() mappt die Datei und baut nur einen Offset-Index
+// (IDS → Byte-Bereich von Schlüssel und Wert). Dekodiert wird
+// erst bei value(); davor sitzt ein LRU (QCache) mit den zuletzt
+// benutzten Strings. Speicher und Ladezeit hängen damit an den
+// tatsächlich angezeigten Texten, nicht an den 100k+ Einträgen.
+//
+// Ein "Atom" ist der feste Index eines Eintrags (0..size()-1).
+// decodeValue() ist const ohne Cache → aus Worker-Threads nutzbar.
+// ------------------------------------------------------------
+class TextTable
+{
+public:
+    enum class Encoding { Utf8, Utf16LE, Utf16BE };
+
+    TextTable();
+    ~TextTable();
+
+    TextTable(const TextTable&) = delete;
+    TextTable& operator=(const TextTable&) = delete;
+
+    bool open(const QString& path);
+    void close();
+
+    bool isOpen() const { return m_data != nullptr; }
+    const QString& path() const { return m_path; }
+    Encoding encoding() const { return m_encoding; }
+    int size() const { return int(m_entries.size()); }
+
+    // IDS → Atom (-1 = unbekannt)
+    int atom(QStringView id) const;
+    bool contains(QStringView id) const { return atom(id) >= 0; }
+
+    QString key(int atom) const;
+    QString value(int atom) const;           // über LRU
+    QString value(QStringView id) const;
+    QString decodeValue(int atom) const;     // ohne Cache, thread-sicher
+
+    // Zeile (0-basiert) des Eintrags in der Datei
+    int line(int atom) const;
+
+    // --- Rohdaten für Patch-Saves ---
+    struct Span {
+        qint64 offset = 0;         // Byte-Offset in der Datei
+        qint64 bytes  = 0;
+    };
+    Span valueSpan(int atom) const;
+    QByteArrayView bytes() const;
+    bool hasBom() const { return m_bom; }
+    bool usesCrLf() const { return m_crlf; }
+
+    // Text in der Kodierung der Datei (ohne BOM)
+    QByteArray encode(QStringView text) const;
+
+    // LRU-Größe in Zeichen
+    void setCacheCapacity(qsizetype chars) { m_cache.setMaxCost(chars); }
+
+private:
+    struct Entry {
+        quint32 keyOffset   = 0;   // Byte-Offset
+        quint32 valueOffset = 0;   // Byte-Offset
+        quint32 valueUnits  = 0;   // Länge in Code-Units
+        quint32 line        = 0;
+        quint16 keyUnits    = 0;
+    };
+
+    char16_t unitAt(qint64 byteOffset) const;
+    QString decode(qint64 byteOffset, qint64 units) const;
+    bool keyEquals(const Entry& e, QStringView id) const;
+    bool keyEquals(const Entry& a, const Entry& b) const;
+    void buildIndex(qint64 begin);
+    void insert(const Entry& e);
+
+    QString        m_path;
+    QFile          m_file;
+    QByteArray     m_fallback;            // falls map() nicht möglich ist
+    const uchar*   m_data = nullptr;
+    qint64         m_size = 0;
+    Encoding       m_encoding = Encoding::Utf8;
+    int            m_unit = 1;            // Bytes pro Code-Unit
+    bool           m_bom = false;
+    bool           m_crlf = false;        // Zeilenende der Datei ("\r\n")
+
+    std::vector<Entry>   m_entries;
+    QHash<quint64, int>  m_index;         // FNV-Hash des IDS → Atom
+    QHash<QString, int>  m_overflow;      // nur bei Hash-Kollisionen
+
+    mutable QCache<int, QString> m_cache;
+};
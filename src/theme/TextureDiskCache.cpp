@@ -0,0 +1,256 @@
+#include "TextureDiskCache.h"
+
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QDebug>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+
+namespace {
+constexpr quint32 Magic     = 0x43544646;   // "FFTC"
+constexpr quint32 Version   = 1;
+constexpr int     MaxFrames = 4;             // Normal / Hover / Pressed / Disabled
+constexpr qint64  Alignment = 64;
+
+constexpr quint64 FnvOffset = 14695981039346656037ull;
+constexpr quint64 FnvPrime  = 1099511628211ull;
+
+// ------------------------------------------------------------
+// Dateiformat: Kopf, Quellpfad (UTF-8), Frames (ausgerichtet)
+// ------------------------------------------------------------
+struct FrameInfo {
+    quint32 width = 0;
+    quint32 height = 0;
+    quint32 bytesPerLine = 0;
+    quint32 reserved = 0;
+    quint64 offset = 0;
+};
+
+struct EntryHeader {
+    quint32 magic = Magic;
+    quint32 version = Version;
+    quint64 sourceSize = 0;
+    qint64  sourceMtime = 0;     // ms seit Epoch
+    quint64 contentHash = 0;     // FNV-1a über die Quelldatei
+    quint32 frameCount = 0;
+    quint32 pathBytes = 0;       // Länge des Quellpfads direkt nach dem Kopf
+    FrameInfo frames[MaxFrames];
+};
+static_assert(std::is_trivially_copyable_v<EntryHeader>);
+
+inline qint64 alignUp(qint64 v)
+{
+    return (v + Alignment - 1) & ~(Alignment - 1);
+}
+
+inline qint64 mtimeOf(const QFileInfo& info)
+{
+    return info.lastModified().toMSecsSinceEpoch();
+}
+
+quint64 fnv(const uchar* d, qint64 n, quint64 h = FnvOffset)
+{
+    for (qint64 i = 0; i < n; ++i)
+        h = (h ^ d[i]) * FnvPrime;
+    return h;
+}
+
+// Inhalts-Hash der Quelldatei (gemappt, readAll() als Fallback)
+bool hashFile(const QString& path, quint64& out)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly))
+        return false;
+
+    if (const uchar* data = file.map(0, file.size())) {
+        out = fnv(data, file.size());
+        return true;
+    }
+    const QByteArray bytes = file.readAll();
+    out = fnv(reinterpret_cast<const uchar*>(bytes.constData()), bytes.size());
+    return true;
+}
+
+// Mapping lebt, solange ein Frame-QImage (bzw. seine Kopie) lebt
+void releaseMapping(void* info)
+{
+    delete static_cast<std::shared_ptr<QFile>*>(info);
+}
+}
+
+void TextureDiskCache::setDirectory(const QString& dir)
+{
+    m_dir.clear();
+    if (dir.isEmpty()) {
+        qInfo() << "[TextureDiskCache] Deaktiviert";
+        return;
+    }
+
+    if (!QDir().mkpath(dir)) {
+        qWarning() << "[TextureDiskCache] Verzeichnis nicht anlegbar, Cache aus:" << dir;
+        return;
+    }
+
+    m_dir = QDir(dir).absolutePath();
+    qInfo() << "[TextureDiskCache] Verzeichnis:" << m_dir;
+}
+
+QString TextureDiskCache::entryPath(const QString& sourcePath) const
+{
+    const QString abs = QFileInfo(sourcePath).absoluteFilePath();
+    const quint64 h = fnv(reinterpret_cast<const uchar*>(abs.utf16()), abs.size() * qint64(sizeof(char16_t)));
+    return m_dir + '/' + QString::number(h, 16).rightJustified(16, '0') + ".ftc";
+}
+
+void TextureDiskCache::clear()
+{
+    if (!isEnabled())
+        return;
+
+    QDir dir(m_dir);
+    const QStringList entries = dir.entryList({ "*.ftc" }, QDir::Files);
+    for (const QString& name : entries)
+        dir.remove(name);
+
+    qInfo() << "[TextureDiskCache]" << entries.size() << "Einträge gelöscht";
+}
+
+// ------------------------------------------------------------
+// Laden: Kopf prüfen, Datei mappen, Frames auf das Mapping legen
+// ------------------------------------------------------------
+QVector<QImage> TextureDiskCache::load(const QString& sourcePath) const
+{
+    if (!isEnabled())
+        return {};
+
+    const QFileInfo source(sourcePath);
+    const QString path = entryPath(sourcePath);
+    auto file = std::make_shared<QFile>(path);
+
+    auto miss = [this]() {
+        ++m_misses;
+        return QVector<QImage>();
+    };
+
+    if (!source.exists() || !file->open(QIODevice::ReadOnly))
+        return miss();
+
+    EntryHeader h;
+    const qint64 size = file->size();
+    if (size < qint64(sizeof(h)) || file->read(reinterpret_cast<char*>(&h), sizeof(h)) != qint64(sizeof(h)))
+        return miss();
+
+    if (h.magic != Magic || h.version != Version || h.frameCount == 0 || h.frameCount > MaxFrames
+        || qint64(sizeof(h)) + h.pathBytes > size)
+        return miss();
+
+    // Gleicher Dateiname, anderer Pfad (Hash-Kollision) → kein Treffer
+    const QByteArray absPath = source.absoluteFilePath().toUtf8();
+    if (h.pathBytes != quint32(absPath.size()) || file->read(h.pathBytes) != absPath)
+        return miss();
+
+    if (h.sourceSize != quint64(source.size()))
+        return miss();
+
+    // Nur mtime anders → Inhalt entscheidet, Kopf auffrischen
+    if (h.sourceMtime != mtimeOf(source)) {
+        quint64 hash = 0;
+        if (!hashFile(sourcePath, hash) || hash != h.contentHash)
+            return miss();
+
+        h.sourceMtime = mtimeOf(source);
+        QFile update(path);
+        if (update.open(QIODevice::ReadWrite))
+            update.write(reinterpret_cast<const char*>(&h), sizeof(h));
+    }
+
+    for (quint32 i = 0; i < h.frameCount; ++i) {
+        const FrameInfo& f = h.frames[i];
+        if (f.width == 0 || f.height == 0 || f.bytesPerLine < f.width * 4 || f.offset % 4 != 0
+            || f.offset + quint64(f.bytesPerLine) * f.height > quint64(size))
+            return miss();
+    }
+
+    const uchar* base = file->map(0, size);
+    if (!base)
+        return miss();
+
+    QVector<QImage> frames;
+    frames.reserve(int(h.frameCount));
+    for (quint32 i = 0; i < h.frameCount; ++i) {
+        const FrameInfo& f = h.frames[i];
+        frames.append(QImage(base + f.offset, int(f.width), int(f.height), qsizetype(f.bytesPerLine),
+                             QImage::Format_ARGB32_Premultiplied,
+                             releaseMapping, new std::shared_ptr<QFile>(file)));
+    }
+
+    ++m_hits;
+    return frames;
+}
+
+// ------------------------------------------------------------
+// Schreiben (atomar über QSaveFile)
+// ------------------------------------------------------------
+bool TextureDiskCache::store(const QString& sourcePath, const QVector<QImage>& frames) const
+{
+    if (!isEnabled() || frames.isEmpty() || frames.size() > MaxFrames)
+        return false;
+
+    const QFileInfo source(sourcePath);
+
+    EntryHeader h;
+    h.sourceSize  = quint64(source.size());
+    h.sourceMtime = mtimeOf(source);
+    if (!hashFile(sourcePath, h.contentHash))
+        return false;
+
+    const QByteArray absPath = source.absoluteFilePath().toUtf8();
+    h.pathBytes  = quint32(absPath.size());
+    h.frameCount = quint32(frames.size());
+
+    QVector<QImage> images;
+    qint64 offset = alignUp(qint64(sizeof(h)) + absPath.size());
+    for (int i = 0; i < frames.size(); ++i) {
+        QImage img = frames[i].convertToFormat(QImage::Format_ARGB32_Premultiplied);
+        if (img.isNull())
+            return false;
+
+        FrameInfo& f   = h.frames[i];
+        f.width        = quint32(img.width());
+        f.height       = quint32(img.height());
+        f.bytesPerLine = f.width * 4;
+        f.offset       = quint64(offset);
+        offset = alignUp(offset + qint64(f.bytesPerLine) * f.height);
+        images.append(std::move(img));
+    }
+
+    const QString path = entryPath(sourcePath);
+    QSaveFile out(path);
+    if (!out.open(QIODevice::WriteOnly)) {
+        qWarning() << "[TextureDiskCache] Konnte nicht schreiben:" << path;
+        return false;
+    }
+
+    out.write(reinterpret_cast<const char*>(&h), sizeof(h));
+    out.write(absPath);
+
+    static const char padding[Alignment] = {};
+    for (int i = 0; i < images.size(); ++i) {
+        const FrameInfo& f = h.frames[i];
+        out.write(padding, qint64(f.offset) - out.pos());
+
+        const QImage& img = images[i];
+        for (int y = 0; y < img.height(); ++y)
+            out.write(reinterpret_cast<const char*>(img.constScanLine(y)), f.bytesPerLine);
+    }
+
+    if (!out.commit()) {
+        qWarning() << "[TextureDiskCache] Schreiben fehlgeschlagen:" << path << out.errorString();
+        return false;
+    }
+    return true;
+}
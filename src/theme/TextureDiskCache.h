@@ -0,0 +1,50 @@
+#pragma once
+#include <QImage>
+#include <QString>
+#include <QVector>
+#include <atomic>
+
+// ------------------------------------------------------------
+// TextureDiskCache – fertig aufbereitete Theme-Texturen auf Platte
+// ------------------------------------------------------------
+// Je Quelldatei ein Eintrag <FNV(Pfad)>.ftc mit Kopf (Quellpfad,
+// Größe, mtime, Inhalts-Hash) und den bereits nach Zuständen
+// geteilten Frames als ARGB32_Premultiplied. Frames liegen
+// 64-Byte-ausgerichtet, Zeilen ohne Padding – beim Laden wird die
+// Datei gemappt und jeder Frame ist ein QImage direkt auf dem
+// Mapping (kein Kopieren, kein Dekodieren).
+//
+// Gültigkeit: Größe + mtime gleich → Treffer ohne die Quelle zu
+// lesen. Weicht nur die mtime ab (z. B. nach Checkout), entscheidet
+// der Inhalts-Hash. Stimmt er, bleiben die Frames unverändert und
+// load() frischt nur die mtime im Kopf des Eintrags an Ort und
+// Stelle auf (kein Neu-Kodieren).
+//
+// load()/store() ändern keinen Zustand (außer Treffer-Zählern und
+// dieser Kopf-Auffrischung) und laufen in Worker-Threads.
+// ------------------------------------------------------------
+class TextureDiskCache
+{
+public:
+    // Leer = Cache aus
+    void setDirectory(const QString& dir);
+    QString directory() const { return m_dir; }
+    bool isEnabled() const { return !m_dir.isEmpty(); }
+
+    // Frames einer Quelldatei; leer bei fehlendem/veraltetem Eintrag
+    QVector<QImage> load(const QString& sourcePath) const;
+    bool store(const QString& sourcePath, const QVector<QImage>& frames) const;
+
+    // Alle Einträge löschen
+    void clear();
+
+    int hits() const { return m_hits.load(); }
+    int misses() const { return m_misses.load(); }
+
+private:
+    QString entryPath(const QString& sourcePath) const;
+
+    QString m_dir;
+    mutable std::atomic<int> m_hits{0};
+    mutable std::atomic<int> m_misses{0};
+};
@@ -1,12 +1,29 @@
 #include "ThemeManager.h"
 #include "ResourceUtils.h"
+#include "TgaDecoder.h"
+#include <QtConcurrent/QtConcurrent>
 #include <QDir>
+#include <QElapsedTimer>
 #include <QDebug>
 #include <QFileInfo>
 
+namespace {
+// Standardbudget des Textur-Caches (alle Themes zusammen)
+constexpr qint64 DefaultCacheBudget = 256ll * 1024 * 1024;
+}
+
 ThemeManager::ThemeManager(FileManager* fileMgr, QObject* parent)
     : QObject(parent), m_fileMgr(fileMgr)
 {
+    m_cache.setMaxCost(DefaultCacheBudget);
+}
+
+ThemeManager::~ThemeManager()
+{
+    for (auto* watcher : std::as_const(m_prefetches)) {
+        watcher->cancel();
+        watcher->waitForFinished();
+    }
 }
 
 void ThemeManager::refreshFromTokens(const QList<Token>& tokens)
@@ -18,13 +35,26 @@ void ThemeManager::refreshFromTokens(const QList<Token>& tokens)
 void ThemeManager::clear()
 {
     m_themes.clear();
+    m_cache.clear();
+    m_failed.clear();
+    m_oversized.clear();
     m_currentTheme.clear();
 }
 
-QMap<QString, QPixmap> ThemeManager::loadPixmaps(const QString& dirPath,
-                                                 const QString& themeName)
+void ThemeManager::setCacheBudget(qint64 bytes)
 {
-    QMap<QString, QPixmap> result;
+    m_cache.setMaxCost(qMax<qint64>(1, bytes));
+    m_oversized.clear();    // passen evtl. ins neue Budget
+    qInfo().noquote() << QString("[ThemeManager] Textur-Cache: %1 MB").arg(bytes / (1024 * 1024));
+}
+
+// ------------------------------------------------------------
+// Theme-Ordner indizieren (nur Dateinamen, nichts dekodieren)
+// ------------------------------------------------------------
+QHash<QString, QString> ThemeManager::indexTextures(const QString& dirPath,
+                                                    const QString& themeName) const
+{
+    QHash<QString, QString> result;
 
     if (dirPath.isEmpty() || !QDir(dirPath).exists()) {
         qWarning() << "[ThemeManager] Ungültiger Theme-Pfad:" << dirPath;
@@ -34,62 +64,16 @@ QMap<QString, QPixmap> ThemeManager::loadPixmaps(const QString& dirPath,
     const QStringList filters = { "*.tga", "*.png", "*.jpg", "*.bmp" };
     QDirIterator it(dirPath, filters, QDir::Files, QDirIterator::Subdirectories);
 
-    QString logName = themeName.isEmpty()
-                          ? "theme_debug_log.txt"
-                          : QString("theme_debug_%1_log.txt").arg(themeName);
-
-    QFile logFile(QDir(dirPath).filePath(logName));
-    logFile.open(QIODevice::WriteOnly | QIODevice::Text);
-    QTextStream log(&logFile);
-
-    int loaded = 0;
-    int failed = 0;
-
     while (it.hasNext()) {
-        QString filePath = it.next();
-        QFileInfo fi(filePath);
+        const QString filePath = it.next();
 
         // 🔹 Der Key ist der Basisname in lowercase
-        QString key = fi.baseName().toLower();
-
-        QPixmap pix;
-
-        // TGA mit Flyff-spezialbehandlung
-        if (fi.suffix().compare("tga", Qt::CaseInsensitive) == 0) {
-            QImage tga = ResourceUtils::loadFlyffTga(filePath);
-            if (!tga.isNull())
-                pix = QPixmap::fromImage(tga);
-        }
-        else {
-            QImageReader reader(filePath);
-            reader.setAutoTransform(true);
-            pix = QPixmap::fromImageReader(&reader);
-        }
-
-        if (pix.isNull()) {
-            log << "❌ Fehler: " << filePath << "\n";
-            failed++;
-            continue;
-        }
-
-        // 🔹 Flyff-typische Korrekturen
-        pix = ResourceUtils::clampTransparentEdges(pix);
-        pix = ResourceUtils::applyMagentaMask(pix);
-
-        log << "✓ Geladen: " << key << " (" << pix.width() << "x" << pix.height() << ")\n";
-        result.insert(key, pix);
-        loaded++;
+        result.insert(QFileInfo(filePath).baseName().toLower(), filePath);
     }
 
-    log << "\nGesamt geladen: " << loaded
-        << " | Fehler: " << failed
-        << " | Dateien: " << (loaded + failed) << "\n";
-
-    logFile.close();
-
-    qInfo().noquote() << QString("[ThemeManager] Log-Datei: %1")
-                             .arg(logFile.fileName());
-
+    qInfo().noquote() << QString("[ThemeManager] %1: %2 Texturen indiziert")
+                             .arg(themeName)
+                             .arg(result.size());
     return result;
 }
 
@@ -110,60 +94,222 @@ bool ThemeManager::loadTheme(const QString& themeName)
 
     qInfo().noquote() << "[ThemeManager] Lade Theme:" << themeName;
 
-    // 1️⃣ Default-Theme laden
-    QMap<QString, QPixmap> defaultPixmaps =
-        loadPixmaps(defaultPath, "Default");
-
-    // 2️⃣ Optionales Theme (z. B. English) laden
-    QMap<QString, QPixmap> themePixmaps;
-    if (!themePath.isEmpty() && QDir(themePath).exists())
-        themePixmaps = loadPixmaps(themePath, themeName);
-
-    // 3️⃣ Theme-Mapping vorbereiten
-    QMap<QString, QMap<ControlState, QPixmap>> themeMap;
+    QElapsedTimer timer;
+    timer.start();
 
-    auto processPixmaps = [&](const QMap<QString, QPixmap>& pixmaps) {
-        for (auto it = pixmaps.begin(); it != pixmaps.end(); ++it) {
-            const QString key = it.key().toLower();
-            const QPixmap& pix = it.value();
+    // 1️⃣ Default-Theme indizieren
+    QHash<QString, QString> themeMap = indexTextures(defaultPath, "Default");
 
-            if (pix.isNull())
-                continue;
-
-            QMap<ControlState, QPixmap> states;
-
-            // 🔍 4-State SpriteStrip?
-            if (pix.width() >= pix.height() * 4)
-                states = splitTextureStates(pix);
-            else
-                states[ControlState::Normal] = pix;
-
-            themeMap[key] = states;
-        }
-    };
-
-    // 4️⃣ Default zuerst, dann Custom drüber
-    processPixmaps(defaultPixmaps);
-    processPixmaps(themePixmaps);
+    // 2️⃣ Optionales Theme (z. B. English) drüber
+    if (!themePath.isEmpty() && QDir(themePath).exists()) {
+        const QHash<QString, QString> custom = indexTextures(themePath, themeName);
+        for (auto it = custom.constBegin(); it != custom.constEnd(); ++it)
+            themeMap.insert(it.key(), it.value());
+    }
 
-    // 5️⃣ In globale Map eintragen
+    // 3️⃣ In globale Map eintragen
     m_themes.insert(themeName.toLower(), themeMap);
 
     qDebug() << "[ThemeManager] Stored theme:" << themeName.toLower()
              << "with" << themeMap.size() << "entries";
 
-
-    // 6️⃣ Falls noch kein aktives Theme → setzen
+    // 4️⃣ Falls noch kein aktives Theme → setzen
     if (m_currentTheme.isEmpty())
         m_currentTheme = themeName.toLower();
 
     qInfo().noquote() << "[ThemeManager] Theme '" << themeName
-                      << "' geladen (" << themeMap.size() << " Texturen)";
+                      << "' indiziert (" << themeMap.size() << " Texturen," << timer.elapsed() << "ms)";
 
     emit texturesUpdated();
     return true;
 }
 
+// ------------------------------------------------------------
+// Lazy-Dekodierung + LRU
+// ------------------------------------------------------------
+QString ThemeManager::filePathFor(const QString& key) const
+{
+    auto theme = m_themes.constFind(m_currentTheme);
+    if (theme != m_themes.constEnd()) {
+        const QString path = theme->value(key);
+        if (!path.isEmpty())
+            return path;
+    }
+
+    // Fallback: Default Theme
+    auto def = m_themes.constFind("default");
+    if (def != m_themes.constEnd())
+        return def->value(key);
+    return QString();
+}
+
+QVector<QImage> ThemeManager::decodeFrames(const QString& filePath, const TextureDiskCache* disk)
+{
+    if (disk && disk->isEnabled()) {
+        QVector<QImage> cached = disk->load(filePath);
+        if (!cached.isEmpty())
+            return cached;
+    }
+
+    const QImage image = ResourceUtils::loadThemeImage(filePath);
+    if (image.isNull())
+        return {};
+
+    QVector<QImage> frames = splitTextureStates(image);
+    if (disk && disk->isEnabled())
+        disk->store(filePath, frames);
+    return frames;
+}
+
+void ThemeManager::insertDecoded(const QString& filePath, const QVector<QImage>& frames) const
+{
+    if (frames.isEmpty()) {
+        qWarning() << "[ThemeManager] Textur konnte nicht dekodiert werden:" << filePath;
+        m_failed.insert(filePath);
+        return;
+    }
+
+    static constexpr ControlState order[] = {
+        ControlState::Normal, ControlState::Hover, ControlState::Pressed, ControlState::Disabled
+    };
+
+    QMap<ControlState, QPixmap> states;
+    qint64 cost = 0;
+    for (int i = 0; i < frames.size() && i < 4; ++i) {
+        const QPixmap pix = QPixmap::fromImage(frames[i]);
+        cost += qint64(pix.width()) * pix.height() * qMax(1, pix.depth() / 8);
+        states[order[i]] = pix;
+    }
+
+    // insert() würde den Eintrag verwerfen → außerhalb des Caches halten
+    if (qMax<qint64>(1, cost) > m_cache.maxCost()) {
+        qWarning() << "[ThemeManager] Textur größer als Cache-Budget, ungecacht:" << filePath;
+        m_oversized.insert(filePath, std::move(states));
+        return;
+    }
+
+    m_cache.insert(filePath, new CachedTexture{ std::move(states) }, qMax<qint64>(1, cost));
+}
+
+const QMap<ControlState, QPixmap>* ThemeManager::statesFor(const QString& key) const
+{
+    const QString path = filePathFor(key);
+    if (path.isEmpty())
+        return nullptr;
+
+    // object() zählt als Zugriff → zuletzt gezeichnete bleiben im Cache
+    if (CachedTexture* hit = m_cache.object(path))
+        return &hit->states;
+
+    auto oversized = m_oversized.constFind(path);
+    if (oversized != m_oversized.constEnd())
+        return &oversized.value();
+
+    // Läuft im Prefetch → nicht doppelt im GUI-Thread dekodieren;
+    // nach dem Batch kommt texturesUpdated() und es wird neu gezeichnet
+    if (m_failed.contains(path) || m_inFlight.contains(path))
+        return nullptr;
+
+    insertDecoded(path, decodeFrames(path, &m_diskCache));
+
+    if (CachedTexture* entry = m_cache.object(path))
+        return &entry->states;
+    oversized = m_oversized.constFind(path);
+    return oversized != m_oversized.constEnd() ? &oversized.value() : nullptr;
+}
+
+void ThemeManager::prefetch(const QStringList& names)
+{
+    // Fehlende Dateien einsammeln (inkl. Tileset-Teile name00..name11)
+    QStringList files;
+    QSet<QString> seen;
+    auto want = [&](const QString& key) {
+        const QString path = filePathFor(key);
+        if (path.isEmpty() || seen.contains(path) || m_inFlight.contains(path) || m_cache.contains(path)
+            || m_oversized.contains(path) || m_failed.contains(path))
+            return;
+        seen.insert(path);
+        files << path;
+    };
+
+    for (const QString& name : names) {
+        if (name.isEmpty())
+            continue;
+        const QString key = QFileInfo(name).completeBaseName().toLower();
+        want(key);
+        for (int i = 0; i < 12; ++i)
+            want(QString("%1%2").arg(key).arg(i, 2, 10, QChar('0')));
+    }
+
+    if (files.isEmpty())
+        return;
+
+    for (const QString& filePath : files)
+        m_inFlight.insert(filePath);
+
+    auto timer = std::make_shared<QElapsedTimer>();
+    timer->start();
+    const int hitsBefore = m_diskCache.hits();
+    const TgaDecoder::Stats tgaBefore = TgaDecoder::stats();
+    const int total = int(files.size());
+    const QString theme = m_currentTheme;
+
+    // Disk-Cache bzw. Dekodieren + Pixel-Korrekturen parallel; QPixmap
+    // entsteht im GUI-Thread, sobald ein Ergebnis fertig ist – der
+    // Aufrufer (Fensterwechsel) wartet nicht
+    auto* watcher = new QFutureWatcher<QVector<QImage>>(this);
+    m_prefetches.insert(watcher);
+
+    auto done = std::make_shared<int>(0);
+    connect(watcher, &QFutureWatcherBase::resultReadyAt, this, [this, watcher, files, total, theme, done](int i) {
+        const QString& filePath = files[i];
+        m_inFlight.remove(filePath);
+
+        insertDecoded(filePath, watcher->resultAt(i));
+
+        ++*done;
+        if (*done % 32 == 0 || *done == total)
+            emit loadProgress(theme, *done, total);
+    });
+
+    connect(watcher, &QFutureWatcherBase::finished, this,
+            [this, watcher, files, total, timer, hitsBefore, tgaBefore]() {
+        m_prefetches.remove(watcher);
+        for (const QString& filePath : files)
+            m_inFlight.remove(filePath);          // auch bei Abbruch
+        watcher->deleteLater();
+
+        if (watcher->isCanceled())
+            return;
+
+        qInfo().noquote() << QString("[ThemeManager] %1 Texturen vorgeladen (%2 aus Disk-Cache, %3 ms)")
+                                 .arg(total)
+                                 .arg(m_diskCache.hits() - hitsBefore)
+                                 .arg(timer->elapsed());
+
+        // Decoder-Durchsatz je Worker (Summe der Dekodierzeiten)
+        const TgaDecoder::Stats now = TgaDecoder::stats();
+        TgaDecoder::Stats delta;
+        delta.files       = now.files - tgaBefore.files;
+        delta.bytes       = now.bytes - tgaBefore.bytes;
+        delta.pixels      = now.pixels - tgaBefore.pixels;
+        delta.nanoseconds = now.nanoseconds - tgaBefore.nanoseconds;
+        if (delta.files > 0)
+            qInfo().noquote() << QString("[ThemeManager] TGA: %1 Dateien, %2 KB, %3 MPixel in %4 ms → %5 MB/s")
+                                     .arg(delta.files)
+                                     .arg(delta.bytes / 1024)
+                                     .arg(double(delta.pixels) / 1e6, 0, 'f', 2)
+                                     .arg(double(delta.nanoseconds) / 1e6, 0, 'f', 1)
+                                     .arg(delta.megabytesPerSecond(), 0, 'f', 1);
+
+        emit texturesUpdated();
+    });
+
+    const TextureDiskCache* disk = &m_diskCache;
+    watcher->setFuture(QtConcurrent::mapped(files, [disk](const QString& filePath) {
+        return decodeFrames(filePath, disk);
+    }));
+}
 
 bool ThemeManager::setCurrentTheme(const QString& themeName)
 {
@@ -183,21 +329,23 @@ bool ThemeManager::setCurrentTheme(const QString& themeName)
     return true;
 }
 
-QMap<ControlState, QPixmap> ThemeManager::splitTextureStates(const QPixmap& src) const
+QVector<QImage> ThemeManager::splitTextureStates(const QImage& src)
 {
-    QMap<ControlState, QPixmap> map;
-    if (src.isNull()) return map;
+    if (src.isNull())
+        return {};
+
+    // 🔍 4-State SpriteStrip? (normal / hover / pressed / disabled)
+    if (src.width() < src.height() * 4)
+        return { src };
 
-    int stateCount = 4; // normal / hover / pressed / disabled
+    int stateCount = 4;
     int w = src.width() / stateCount;
     int h = src.height();
 
-    map[ControlState::Normal]   = src.copy(0 * w, 0, w, h);
-    map[ControlState::Hover]    = src.copy(1 * w, 0, w, h);
-    map[ControlState::Pressed]  = src.copy(2 * w, 0, w, h);
-    map[ControlState::Disabled] = src.copy(3 * w, 0, w, h);
-
-    return map;
+    QVector<QImage> frames;
+    for (int i = 0; i < stateCount; ++i)
+        frames.append(src.copy(i * w, 0, w, h));
+    return frames;
 }
 
 QPixmap ThemeManager::texture(const QString& name, ControlState state) const
@@ -210,41 +358,17 @@ QPixmap ThemeManager::texture(const QString& name, ControlState state) const
     QFileInfo fi(name);
     QString key = fi.completeBaseName().toLower();
 
-    const auto& themeMap = m_themes.value(m_currentTheme);
-
-    auto fetchPixmap = [&](const QMap<QString, QMap<ControlState, QPixmap>>& map,
-                           const QString& debugName)
-    {
-        if (!map.contains(key))
-            return QPixmap();
-
-        const auto& states = map.value(key);
-
-        if (states.contains(state))
-            return states.value(state);
+    // Aktives Theme, Fallback Default (filePathFor)
+    if (const auto* states = statesFor(key)) {
+        if (states->contains(state))
+            return states->value(state);
 
-        if (states.contains(ControlState::Normal))
-            return states.value(ControlState::Normal);
-
-        return QPixmap();
-    };
-
-    // 1) Aktives Theme
-    QPixmap pm = fetchPixmap(themeMap, "Active");
-    if (!pm.isNull())
-        return pm;
-
-    // 2) Fallback: Default Theme
-    if (m_themes.contains("default")) {
-        const auto& defMap = m_themes.value("default");
-        pm = fetchPixmap(defMap, "Default");
-
-        if (!pm.isNull())
-            return pm;
+        if (states->contains(ControlState::Normal))
+            return states->value(ControlState::Normal);
     }
 
     static QSet<QString> warned;
-    if (!warned.contains(key)) {
+    if (!warned.contains(key) && !m_inFlight.contains(filePathFor(key))) {
         warned.insert(key);
         qWarning() << "[ThemeManager] Textur nicht gefunden:" << name;
     }
@@ -262,11 +386,12 @@ bool ThemeManager::matchesFullTexture(const QPixmap& pm, int wndW, int wndH) con
 
 bool ThemeManager::hasTileSet(const QString& baseName) const
 {
+    // Nur im Index nachsehen – dekodiert wird erst in buildTileSet()
     for (int i = 0; i < 12; i++)
     {
         QString key = QString("%1%2").arg(baseName).arg(i, 2, 10, QChar('0'));
 
-        if (textureFor(key).isNull())
+        if (filePathFor(key).isEmpty())
             return false;
     }
     return true;
@@ -293,22 +418,16 @@ ThemeManager::WindowSkin ThemeManager::buildTileSet(const QString& baseName) con
 
 QPixmap ThemeManager::textureFor(const QString& name, ControlState state) const
 {
-    if (!m_themes.contains(m_currentTheme))
+    const auto* states = statesFor(name);
+    if (!states)
         return QPixmap();
 
-    const auto& theme = m_themes[m_currentTheme];
-
-    if (!theme.contains(name))
-        return QPixmap();
-
-    const auto& states = theme[name];
-
-    if (states.contains(state))
-        return states[state];
+    if (states->contains(state))
+        return states->value(state);
 
     // Fallback auf Normal
-    if (states.contains(ControlState::Normal))
-        return states[ControlState::Normal];
+    if (states->contains(ControlState::Normal))
+        return states->value(ControlState::Normal);
 
     return QPixmap();
 }
@@ -1,16 +1,23 @@
 #pragma once
 #include <QObject>
+#include <QCache>
+#include <QFutureWatcher>
+#include <QHash>
 #include <QMap>
+#include <QImage>
 #include <QPixmap>
+#include <QSet>
 #include "ControlState.h"
 #include "FileManager.h"
 #include "TokenData.h"
+#include "TextureDiskCache.h"
 
 class ThemeManager : public QObject
 {
     Q_OBJECT
 public:
     explicit ThemeManager(FileManager* fileMgr, QObject* parent = nullptr);
+    ~ThemeManager() override;
 
 struct WindowSkin {
         QPixmap tiles[12];      // 00 .. 11
@@ -19,21 +26,40 @@ struct WindowSkin {
 };
     void refreshFromTokens(const QList<Token>& tokens);
 
-    bool loadTheme(const QString& themeName);         // lädt (und cached) ein Theme
+    bool loadTheme(const QString& themeName);         // indiziert ein Theme (Dekodieren erst bei Bedarf)
     bool setCurrentTheme(const QString& themeName);   // wechselt aktiv verwendetes Theme
     QString currentTheme() const { return m_currentTheme; }
 
     QPixmap texture(const QString& key, ControlState state) const;
 
+    // Noch nicht dekodierte Texturen parallel vorladen (z. B. beim Fensterwechsel).
+    // Kehrt sofort zurück; Ergebnisse kommen über einen QFutureWatcher in den
+    // Cache, danach texturesUpdated()
+    void prefetch(const QStringList& names);
+
+    // Speicherbudget des Textur-Caches (alle Themes zusammen)
+    void setCacheBudget(qint64 bytes);
+    qint64 cacheBudget() const { return m_cache.maxCost(); }
+    qint64 cacheUsage() const { return m_cache.totalCost(); }
+
+    // Aufbereitete Texturen auf Platte (leer = aus)
+    void setDiskCacheDirectory(const QString& dir) { m_diskCache.setDirectory(dir); }
+    void clearDiskCache() { m_diskCache.clear(); }
+
     WindowSkin resolveWindowSkin(const QString& texName, int wndW, int wndH) const;
 
 signals:
     void texturesUpdated();
     void themeChanged(const QString& name);
+    void loadProgress(const QString& themeName, int done, int total);   // beim Laden der Texturen
 
 private:
     void clear();
-    QMap<ControlState, QPixmap> splitTextureStates(const QPixmap& src) const;
+    // 4-State-Strip → Frames in ControlState-Reihenfolge, sonst nur das Bild
+    static QVector<QImage> splitTextureStates(const QImage& src);
+
+    // Worker: Disk-Cache, sonst dekodieren + teilen + zurückschreiben
+    static QVector<QImage> decodeFrames(const QString& filePath, const TextureDiskCache* disk);
 
     bool hasTileSet(const QString& baseName) const;
     WindowSkin buildTileSet(const QString& baseName) const;
@@ -41,12 +67,34 @@ private:
 
     QPixmap textureFor(const QString& name, ControlState state = ControlState::Normal) const;
 
-    QMap<QString, QPixmap> loadPixmaps(const QString& path,
-                                       const QString& themeName);
+    // Key (Basisname lowercase) → Datei
+    QHash<QString, QString> indexTextures(const QString& path, const QString& themeName) const;
+
+    QString filePathFor(const QString& key) const;
+    const QMap<ControlState, QPixmap>* statesFor(const QString& key) const;
+    void insertDecoded(const QString& filePath, const QVector<QImage>& frames) const;
 
     FileManager* m_fileMgr = nullptr;
     QString m_currentTheme;
 
-    // 🌍 Alle geladenen Themes: m_themes["default"]["buttwndexit"][Normal]
-    QMap<QString, QMap<QString, QMap<ControlState, QPixmap>>> m_themes;
+    // 🌍 Alle Themes: m_themes["english"]["buttwndexit"] → Datei
+    //    (Default-Dateien zuerst, Theme-Dateien überschreiben)
+    QMap<QString, QHash<QString, QString>> m_themes;
+
+    // Dekodierte Texturen je Datei, LRU nach Zugriff, Kosten = Bytes
+    struct CachedTexture {
+        QMap<ControlState, QPixmap> states;
+    };
+    mutable QCache<QString, CachedTexture> m_cache;
+    mutable QSet<QString> m_failed;     // nicht dekodierbar → nicht erneut versuchen
+
+    // Größer als das ganze Budget → QCache lehnt ab; ungecacht behalten,
+    // sonst würde jeder texture()-Aufruf neu dekodieren
+    mutable QHash<QString, QMap<ControlState, QPixmap>> m_oversized;
+
+    // Laufende Prefetch-Batches (Worker lesen m_diskCache → im Destruktor abwarten)
+    QSet<QFutureWatcher<QVector<QImage>>*> m_prefetches;
+    QSet<QString> m_inFlight;
+
+    TextureDiskCache m_diskCache;
 };
@@ -4,7 +4,18 @@
 #include "WindowPanel.h"
 #include "PropertyPanel.h"
 #include "ProjectController.h"
+#include "text/TextManager.h"
+#include <QComboBox>
+#include <QDialog>
+#include <QHeaderView>
+#include <QLabel>
+#include <QLineEdit>
+#include <QMessageBox>
+#include <QTreeWidget>
+#include <QVBoxLayout>
+#include <QToolBar>
 #include <QSplitter>
+#include <QStatusBar>
 #include <QSettings>
 #include <QDebug>
 
@@ -33,6 +44,19 @@ MainWindow::MainWindow(ProjectController* controller, QWidget* parent)
     splitter->setSizes({300, 900, 400});
 
     setCentralWidget(splitter);
+    createToolBar();
+
+    // Fortschritt beim Laden der Theme-Texturen (Prefetch im Hintergrund)
+    if (auto* themes = controller ? controller->themeManager() : nullptr) {
+        connect(themes, &ThemeManager::loadProgress, this, [this](const QString& theme, int done, int total) {
+            statusBar()->showMessage(QString("Lade Theme %1: %2 / %3 Texturen").arg(theme).arg(done).arg(total),
+                                     done == total ? 2000 : 0);
+            statusBar()->repaint();
+        });
+
+        // Prefetch läuft im Hintergrund → fertige Texturen nachzeichnen
+        connect(themes, &ThemeManager::texturesUpdated, m_canvas, qOverload<>(&QWidget::update));
+    }
     setMinimumSize(1200, 800);
     resize(1600, 900);
 
@@ -63,6 +87,8 @@ void MainWindow::initializeAfterLoad()
     // Canvas-Logik mit Controller verbinden
     m_controller->bindCanvas(m_handler);
 
+    updateLanguageBox();
+
     // Falls bereits Layouts geladen sind, aktives Fenster auswählen
     auto lm = m_controller->layoutManager();
     if (!lm) return;
@@ -72,3 +98,158 @@ void MainWindow::initializeAfterLoad()
         emit m_controller->activeWindowChanged(windows.front());
     }
 }
+
+// ------------------------------------------------------------
+// Toolbar: Textsprache (Spaltenwechsel im TextStore, kein Reload)
+// ------------------------------------------------------------
+void MainWindow::createToolBar()
+{
+    QToolBar* bar = addToolBar("Texte");
+    bar->setObjectName("TextToolBar");
+    bar->setMovable(false);
+
+    bar->addWidget(new QLabel(" Sprache: ", bar));
+    m_languageBox = new QComboBox(bar);
+    m_languageBox->setEnabled(false);
+    bar->addWidget(m_languageBox);
+
+    connect(m_languageBox, &QComboBox::currentIndexChanged, this, [this](int index) {
+        if (index < 0 || !m_controller)
+            return;
+        m_controller->setTextLanguage(index);   // speichert die Wahl in der config.ini
+    });
+
+    bar->addSeparator();
+    bar->addAction("Textüberlauf prüfen", this, &MainWindow::showTextOverflow);
+
+    // Volltextsuche über alle Sprachen (Trigramm-Index im TextManager)
+    bar->addSeparator();
+    bar->addWidget(new QLabel(" Suche: ", bar));
+    m_searchEdit = new QLineEdit(bar);
+    m_searchEdit->setPlaceholderText("Text in allen Sprachen…");
+    m_searchEdit->setClearButtonEnabled(true);
+    m_searchEdit->setMaximumWidth(260);
+    bar->addWidget(m_searchEdit);
+    connect(m_searchEdit, &QLineEdit::returnPressed, this, &MainWindow::showTextSearch);
+}
+
+// ------------------------------------------------------------
+// Textsuche: Treffer mit Verwendung im Layout, Doppelklick springt
+// zum Fenster/Control und schaltet auf die Sprache des Treffers
+// ------------------------------------------------------------
+void MainWindow::showTextSearch()
+{
+    const TextManager* tm = m_controller ? m_controller->textManager() : nullptr;
+    const QString query = m_searchEdit->text().trimmed();
+    if (!tm || query.isEmpty())
+        return;
+
+    if (!tm->isSearchReady()) {
+        statusBar()->showMessage("Suchindex wird noch aufgebaut – bitte gleich erneut versuchen.", 3000);
+        return;
+    }
+
+    constexpr int limit = 200;
+    const QVector<TextSearchResult> results = tm->search(query, limit);
+    if (results.isEmpty()) {
+        statusBar()->showMessage(QString("Keine Treffer für \"%1\".").arg(query), 3000);
+        return;
+    }
+
+    auto* dialog = new QDialog(this);
+    dialog->setAttribute(Qt::WA_DeleteOnClose);
+    dialog->setWindowTitle(QString("Suche: %1 (%2%3 Treffer)")
+                               .arg(query)
+                               .arg(results.size())
+                               .arg(results.size() >= limit ? "+" : ""));
+    dialog->resize(900, 500);
+
+    auto* tree = new QTreeWidget(dialog);
+    tree->setHeaderLabels({ "IDS", "TID", "Sprache", "Text", "Verwendet in" });
+    tree->setRootIsDecorated(false);
+    tree->setUniformRowHeights(true);
+
+    for (const TextSearchResult& r : results) {
+        QStringList where;
+        for (const TextUsage& u : r.usages)
+            where << (u.control.isEmpty() ? u.window : u.window + " / " + u.control);
+
+        auto* item = new QTreeWidgetItem(tree, { r.id, r.tid, r.language, r.text, where.join(", ") });
+        item->setToolTip(3, r.text);
+        if (!r.usages.isEmpty()) {
+            item->setData(0, Qt::UserRole, r.usages.first().window);
+            item->setData(1, Qt::UserRole, r.usages.first().control);
+        }
+    }
+    tree->header()->setSectionResizeMode(3, QHeaderView::Stretch);
+    tree->resizeColumnToContents(0);
+    tree->resizeColumnToContents(1);
+
+    connect(tree, &QTreeWidget::itemDoubleClicked, this, [this](QTreeWidgetItem* item) {
+        const int language = m_languageBox->findText(item->text(2));
+        if (language >= 0)
+            m_languageBox->setCurrentIndex(language);
+
+        const QString window  = item->data(0, Qt::UserRole).toString();
+        const QString control = item->data(1, Qt::UserRole).toString();
+        if (window.isEmpty())
+            return;
+        m_controller->selectWindow(window);
+        if (!control.isEmpty())
+            m_controller->selectControl(window, control);
+    });
+
+    auto* layout = new QVBoxLayout(dialog);
+    layout->addWidget(tree);
+    dialog->show();
+}
+
+// ------------------------------------------------------------
+// Textüberlauf: Zusammenfassung, vollständige Liste im Log
+// ------------------------------------------------------------
+void MainWindow::showTextOverflow()
+{
+    if (!m_controller)
+        return;
+
+    const auto issues = m_controller->checkTextOverflow();
+    if (issues.isEmpty()) {
+        QMessageBox::information(this, "Textüberlauf", "Keine Überläufe gefunden.");
+        return;
+    }
+
+    constexpr int shown = 20;
+    QString details;
+    for (int i = 0; i < issues.size() && i < shown; ++i) {
+        const auto& issue = issues[i];
+        details += QString("%1 / %2 (%3): +%4 px\n")
+                       .arg(issue.window, issue.control, issue.language)
+                       .arg(issue.overflow());
+    }
+
+    QMessageBox box(QMessageBox::Warning, "Textüberlauf",
+                    QString("%1 Überläufe gefunden (größte zuerst, vollständige Liste im Log).")
+                        .arg(issues.size()),
+                    QMessageBox::Ok, this);
+    box.setDetailedText(details);
+    box.exec();
+}
+
+void MainWindow::updateLanguageBox()
+{
+    if (!m_languageBox || !m_controller || !m_controller->textManager())
+        return;
+
+    const TextManager* tm = m_controller->textManager();
+    const QStringList languages = tm->languages();
+
+    {
+        QSignalBlocker blocker(m_languageBox);
+        m_languageBox->clear();
+        m_languageBox->addItems(languages);
+        m_languageBox->setCurrentIndex(tm->currentLanguage());
+    }
+    // Zuletzt gewählte Sprache kommt aus der config.ini ("Texts/Language"),
+    // der Controller hat sie beim Laden bereits gesetzt
+    m_languageBox->setEnabled(languages.size() > 1);
+}
@@ -13,6 +13,8 @@ class CanvasHandler;
 
 class PropertyPanel;
 class WindowPanel;
+class QComboBox;
+class QLineEdit;
 
 struct WindowData;
 
@@ -32,6 +34,9 @@ public:
 
 private:
     void createToolBar();
+    void updateLanguageBox();
+    void showTextOverflow();
+    void showTextSearch();
     void createDocks();
     void createStatusBar();
 
@@ -41,5 +46,7 @@ private:
     PropertyPanel* m_propertyPanel = nullptr;
     CanvasHandler* m_handler;
     Canvas* m_canvas;
+    QComboBox* m_languageBox = nullptr;
+    QLineEdit* m_searchEdit = nullptr;
 
 };
@@ -1,7 +1,9 @@
 #include "WindowPanel.h"
 #include "core/ProjectController.h"
 #include "layout/LayoutManager.h"
+#include "behavior/BehaviorManager.h"
 #include <QTreeWidgetItem>
+#include <QSet>
 #include <QDebug>
 
 WindowPanel::WindowPanel(ProjectController* controller, QWidget* parent)
@@ -17,6 +19,18 @@ WindowPanel::WindowPanel(ProjectController* controller, QWidget* parent)
     m_searchBox->setPlaceholderText("Suche Fenster oder Control...");
     layout->addWidget(m_searchBox);
 
+    // 🧮 Flag-Abfrage über den invertierten Index
+    m_flagQueryBox = new QLineEdit(this);
+    m_flagQueryBox->setPlaceholderText("Flag-Abfrage, z. B. BS_CHECKBOX & WBS_NODRAWFRAME");
+    m_flagQueryBox->setToolTip("Operatoren: & | ! ( )  –  Sonderterme: ALL, UNKNOWN, UNKNOWN_LOW, UNKNOWN_HIGH\n"
+                               "Enter = ausführen, leeres Feld = Filter aufheben");
+    m_flagQueryBox->setClearButtonEnabled(true);
+    layout->addWidget(m_flagQueryBox);
+
+    m_flagQueryStatus = new QLabel(this);
+    m_flagQueryStatus->setVisible(false);
+    layout->addWidget(m_flagQueryStatus);
+
     // 🌲 Tree-Widget
     m_tree = new QTreeWidget(this);
     m_tree->setHeaderHidden(true);
@@ -29,6 +43,12 @@ WindowPanel::WindowPanel(ProjectController* controller, QWidget* parent)
             this, &WindowPanel::onItemClicked);
     connect(m_searchBox, &QLineEdit::textChanged,
             this, &WindowPanel::onSearchTextChanged);
+    connect(m_flagQueryBox, &QLineEdit::returnPressed,
+            this, &WindowPanel::onFlagQuerySubmitted);
+    connect(m_flagQueryBox, &QLineEdit::textChanged, this, [this](const QString& text) {
+        if (text.isEmpty())
+            onFlagQuerySubmitted();
+    });
 }
 
 void WindowPanel::updateWindowList()
@@ -96,6 +116,54 @@ void WindowPanel::onSearchTextChanged(const QString& text)
     }
 }
 
+void WindowPanel::onFlagQuerySubmitted()
+{
+    const QString query = m_flagQueryBox->text().trimmed();
+
+    // Leere Abfrage → normaler Textfilter
+    if (query.isEmpty()) {
+        m_flagQueryStatus->setVisible(false);
+        onSearchTextChanged(m_searchBox->text());
+        return;
+    }
+
+    auto* bm = m_controller ? m_controller->behaviorManager() : nullptr;
+    if (!bm)
+        return;
+
+    QString error;
+    const auto hits = bm->queryFlagUsage(query, &error);
+
+    m_flagQueryStatus->setVisible(true);
+    if (!error.isEmpty()) {
+        m_flagQueryStatus->setText(QString("<span style='color:red;'>%1</span>").arg(error.toHtmlEscaped()));
+        return;
+    }
+
+    QSet<QString> matched;
+    for (const auto& hit : hits)
+        matched.insert(hit.windowName + "::" + hit.controlId);
+
+    int windowCount = 0;
+    for (int i = 0; i < m_tree->topLevelItemCount(); ++i) {
+        auto* wndItem = m_tree->topLevelItem(i);
+        bool wndVisible = false;
+
+        for (int j = 0; j < wndItem->childCount(); ++j) {
+            auto* ctrl = wndItem->child(j);
+            const bool hit = matched.contains(ctrl->data(0, Qt::UserRole).toString());
+            ctrl->setHidden(!hit);
+            wndVisible |= hit;
+        }
+
+        wndItem->setHidden(!wndVisible);
+        if (wndVisible)
+            ++windowCount;
+    }
+
+    m_flagQueryStatus->setText(QString("%1 Controls in %2 Fenstern").arg(hits.size()).arg(windowCount));
+}
+
 void WindowPanel::onItemClicked(QTreeWidgetItem* item, int)
 {
     if (!item) return;
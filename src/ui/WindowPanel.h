@@ -2,6 +2,7 @@
 #include <QWidget>
 #include <QTreeWidget>
 #include <QLineEdit>
+#include <QLabel>
 #include <QVBoxLayout>
 #include <memory>
 #include "layout/model/WindowData.h"
@@ -32,11 +33,14 @@ signals:
 
 private slots:
     void onSearchTextChanged(const QString& text);
+    void onFlagQuerySubmitted();
     void onItemClicked(QTreeWidgetItem* item, int column);
 
 private:
     ProjectController* m_controller = nullptr;
     QLineEdit* m_searchBox = nullptr;
+    QLineEdit* m_flagQueryBox = nullptr;
+    QLabel* m_flagQueryStatus = nullptr;
     QTreeWidget* m_tree = nullptr;
 
     bool m_isRefreshing = false;
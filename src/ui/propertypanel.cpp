@@ -1,6 +1,7 @@
 #include "PropertyPanel.h"
 #include "core/ProjectController.h"
 #include "behavior/BehaviorManager.h"
+#include "text/TextManager.h"
 #include "layout/model/WindowData.h"
 #include "layout/model/ControlData.h"
 
@@ -13,6 +14,7 @@
 #include <QJsonArray>
 #include <QJsonObject>
 #include <QPointer>
+#include <QSet>
 #include <qtimer.h>
 
 PropertyPanel::PropertyPanel(ProjectController* controller, QWidget* parent)
@@ -53,6 +55,7 @@ void PropertyPanel::showWindowProps(const std::shared_ptr<WindowData>& wnd)
     auto* bm = m_controller->behaviorManager();
     if (!bm)
         return;
+    const TextManager* tm = m_controller->textManager();
 
     // ==========================================================
     // HEADER-INFOS
@@ -82,6 +85,9 @@ void PropertyPanel::showWindowProps(const std::shared_ptr<WindowData>& wnd)
         addCenteredLabel(QString("<b>Title Text:</b> %1").arg(wnd->titletext));
     if (!wnd->titleId.isEmpty())
         addCenteredLabel(QString("<b>Title ID:</b> %1").arg(wnd->titleId));
+    if (wnd->titleTextRow >= 0 && tm)
+        addCenteredLabel(QString("<b>Titel (%1):</b> %2")
+                             .arg(tm->currentLanguageName(), tm->titleText(*wnd).toHtmlEscaped()));
     if (!wnd->helpId.isEmpty())
         addCenteredLabel(QString("<b>Help ID:</b> %1").arg(wnd->helpId));
     if (!wnd->flagsHex.isEmpty())
@@ -100,16 +106,8 @@ void PropertyPanel::showWindowProps(const std::shared_ptr<WindowData>& wnd)
     // 🔹 Aktive Flags bestimmen
     QStringList activeFlags = wnd->resolvedMask;
 
-    // 🔹 Regelobjekt laden
-    QJsonObject rules;
-    const QJsonObject windowRules = bm->windowFlagRules();
-
-    if (!windowRules.isEmpty()) {
-        if (windowRules.contains(wnd->name))
-            rules = windowRules[wnd->name].toObject();
-        else if (windowRules.contains("Default"))
-            rules = windowRules["Default"].toObject();
-    }
+    // 🔹 Vorkompilierte Regeln (Fenstername → Default)
+    const CompiledFlagRules& rules = bm->flagRules().rulesForWindow(wnd->name);
 
     // ==========================================================
     // FLAG-CHECKBOXEN ERZEUGEN (mit gesetztem Zustand)
@@ -130,6 +128,12 @@ void PropertyPanel::showWindowProps(const std::shared_ptr<WindowData>& wnd)
 
         cb->setChecked(isChecked);
 
+        // 🟪 Für dieses Fenster nicht erlaubte Flags ausgrauen (gesetzte bleiben bedienbar)
+        if ((flagValue & ~rules.allowedMask) != 0 && !isChecked) {
+            cb->setEnabled(false);
+            cb->setToolTip("Dieses Flag ist für dieses Fenster nicht gültig.");
+        }
+
         connect(cb, &QCheckBox::checkStateChanged, this,
                 [this, flagValue, wnd](Qt::CheckState state) {
                     quint32 newMask = wnd->flagsMask;
@@ -168,6 +172,7 @@ void PropertyPanel::showControlProps(const std::shared_ptr<WindowData>& wnd,
     auto* bm = m_controller->behaviorManager();
     if (!bm)
         return;
+    const TextManager* tm = m_controller->textManager();
 
     // ==========================================================
     // HEADER-INFOS
@@ -197,6 +202,12 @@ void PropertyPanel::showControlProps(const std::shared_ptr<WindowData>& wnd,
         addCenteredLabel(QString("<b>Title ID:</b> %1").arg(ctrl->titleId));
     if (!ctrl->tooltipId.isEmpty())
         addCenteredLabel(QString("<b>Tooltip ID:</b> %1").arg(ctrl->tooltipId));
+    if (ctrl->titleTextRow >= 0 && tm)
+        addCenteredLabel(QString("<b>Titel (%1):</b> %2")
+                             .arg(tm->currentLanguageName(), tm->titleText(*ctrl).toHtmlEscaped()));
+    if (ctrl->tooltipTextRow >= 0 && tm)
+        addCenteredLabel(QString("<b>Tooltip (%1):</b> %2")
+                             .arg(tm->currentLanguageName(), tm->tooltipText(*ctrl).toHtmlEscaped()));
 
     if (ctrl->color.isValid()) {
         QString colorText = QString("<b>Color:</b> RGB(%1, %2, %3)")
@@ -223,16 +234,8 @@ void PropertyPanel::showControlProps(const std::shared_ptr<WindowData>& wnd,
             activeFlags.append(flagName);
     }
 
-    // 🔹 Regelobjekt für diesen Control-Typ laden
-    QJsonObject rules;
-    const QJsonObject controlRules = bm->controlFlagRules();
-
-    if (!controlRules.isEmpty()) {
-        if (controlRules.contains(ctrl->type))
-            rules = controlRules[ctrl->type].toObject();
-        else if (controlRules.contains("Default"))
-            rules = controlRules["Default"].toObject();
-    }
+    // 🔹 Vorkompilierte Regeln für diesen Control-Typ
+    const CompiledFlagRules& rules = bm->flagRules().rulesForControl(ctrl->type);
 
     // 🔹 Flag-Gruppe über createFlagGroup() erstellen (nutzt valid/exclusive)
     QWidget* flagGroup = createFlagGroup(
@@ -255,7 +258,7 @@ void PropertyPanel::showControlProps(const std::shared_ptr<WindowData>& wnd,
 QWidget* PropertyPanel::createFlagGroup(const QString& title,
                                         const QMap<QString, quint32>& allFlags,
                                         const QStringList& activeFlags,
-                                        const QJsonObject& rules,
+                                        const CompiledFlagRules& rules,
                                         bool isWindowGroup)
 {
     auto* container = new QWidget(this);
@@ -264,28 +267,6 @@ QWidget* PropertyPanel::createFlagGroup(const QString& title,
     auto* groupBox = new QGroupBox(title, container);
     auto* layout = new QGridLayout(groupBox);
 
-    // ==========================================================
-    // 🔹 Regeln einlesen
-    // ==========================================================
-    QMap<QString, QStringList> exclusiveRules;
-    QStringList validFlags;
-
-    if (rules.contains("exclusive")) {
-        QJsonObject excl = rules["exclusive"].toObject();
-        for (auto it = excl.begin(); it != excl.end(); ++it) {
-            QString key = it.key();
-            QStringList list;
-            for (const auto& v : it.value().toArray())
-                list << v.toString();
-            exclusiveRules[key] = list;
-        }
-    }
-
-    if (rules.contains("valid")) {
-        for (const auto& v : rules["valid"].toArray())
-            validFlags << v.toString();
-    }
-
     // Farbpalette für exklusive Gruppen (max. 6, wiederholt sich danach)
     QList<QString> colors = {
         "rgba(255, 0, 0, 0.08)",     // rot
@@ -296,16 +277,24 @@ QWidget* PropertyPanel::createFlagGroup(const QString& title,
         "rgba(0, 255, 255, 0.08)"    // cyan
     };
 
-    QMap<QString, QString> exclGroupColor;  // FlagName → Farbe
-    int colorIndex = 0;
-
-    for (auto it = exclusiveRules.begin(); it != exclusiveRules.end(); ++it) {
-        QString color = colors[colorIndex++ % colors.size()];
-        for (const auto& f : it.value())
-            exclGroupColor[f] = color;
-        exclGroupColor[it.key()] = color;
+    // 🔹 Flagwert → Exklusiv-Gruppen (Werte 0 nie exklusiv). Ein Flag kann
+    //    in mehreren Gruppen stehen (FLAG-Regeln sind Paare FLAG↔X);
+    //    die Farbe kommt von der ersten.
+    QHash<quint32, QVector<int>> exclGroupsOf;
+    QSet<int> coloredGroups;
+    for (int g = 0; g < rules.exclusive.size(); ++g) {
+        for (quint32 v : rules.exclusive[g]) {
+            if (v == 0)
+                continue;
+            if (!exclGroupsOf.contains(v))
+                coloredGroups.insert(g);
+            exclGroupsOf[v].append(g);
+        }
     }
 
+    // Checkboxen pro Gruppe – für direktes Abwählen ohne findChildren()-Scan
+    QVector<QVector<QPair<quint32, QCheckBox*>>> groupBoxes(rules.exclusive.size());
+
     // ==========================================================
     // 🔹 Checkboxen erzeugen
     // ==========================================================
@@ -322,11 +311,16 @@ QWidget* PropertyPanel::createFlagGroup(const QString& title,
         cb->setChecked(activeFlags.contains(flagName));
 
         // 🟥 Exklusive Gruppen farblich markieren
-        if (exclGroupColor.contains(flagName))
-            cb->setStyleSheet(QString("background-color: %1;").arg(exclGroupColor.value(flagName)));
+        const QVector<int> exclGroups = exclGroupsOf.value(flagMask);
+        if (!exclGroups.isEmpty()) {
+            cb->setStyleSheet(QString("background-color: %1;")
+                                  .arg(colors[exclGroups.first() % colors.size()]));
+            for (int g : exclGroups)
+                groupBoxes[g].append({ flagMask, cb });
+        }
 
         // 🟪 Ungültige Flags ausgrauen
-        if (!validFlags.isEmpty() && !validFlags.contains(flagName)) {
+        if ((flagMask & ~rules.allowedMask) != 0) {
             cb->setEnabled(false);
             cb->setToolTip("Dieses Flag ist für diesen Control-Typ nicht gültig.");
             cb->setStyleSheet("color: gray;");
@@ -335,20 +329,6 @@ QWidget* PropertyPanel::createFlagGroup(const QString& title,
         layout->addWidget(cb, row, col);
         if (++col >= maxCols) { col = 0; ++row; }
 
-        // Exklusivverhalten selbst beibehalten
-        if (exclusiveRules.contains(flagName)) {
-            connect(cb, &QCheckBox::toggled, this,
-                    [this, layout, flagName, exclusiveRules](bool checked) {
-                        QStringList excl = exclusiveRules.value(flagName);
-                        if (checked) {
-                            for (auto* other : layout->findChildren<QCheckBox*>()) {
-                                if (excl.contains(other->text()))
-                                    other->setChecked(false);
-                            }
-                        }
-                    });
-        }
-
         connect(cb, &::QCheckBox::checkStateChanged, this,
                 [this, flagMask, flagName, isWindowGroup](int state) {
                     if (m_isRefreshing)
@@ -361,13 +341,37 @@ QWidget* PropertyPanel::createFlagGroup(const QString& title,
                 });
     }
 
+    // ==========================================================
+    // 🔹 Exklusivverhalten: andere Mitglieder der Gruppe abwählen
+    // ==========================================================
+    //   Teilmengen bleiben stehen (BS_CHECKBOX ⊂ BS_AUTOCHECKBOX),
+    //   sonst würde das Abwählen gemeinsame Bits löschen.
+    for (const auto& members : groupBoxes) {
+        if (members.size() < 2)
+            continue;
+
+        for (const auto& member : members) {
+            const quint32 value = member.first;
+            connect(member.second, &QCheckBox::toggled, this,
+                    [value, members](bool checked) {
+                        if (!checked)
+                            return;
+                        for (const auto& [otherValue, other] : members) {
+                            if (other->isChecked() && otherValue != value &&
+                                (otherValue & value) != otherValue)
+                                other->setChecked(false);
+                        }
+                    });
+        }
+    }
+
     groupBox->setLayout(layout);
     mainLayout->addWidget(groupBox);
 
     // ==========================================================
     // 🔹 Farblegende unten hinzufügen
     // ==========================================================
-    if (!exclusiveRules.isEmpty()) {
+    if (!rules.exclusive.isEmpty()) {
         auto* legend = new QWidget(container);
         auto* grid = new QGridLayout(legend);
         grid->setHorizontalSpacing(6);
@@ -376,11 +380,13 @@ QWidget* PropertyPanel::createFlagGroup(const QString& title,
 
         const int maxCols = 3; // 🔹 Max. 3 Elemente pro Zeile
         int row = 0, col = 0;
-        int groupIndex = 1;
 
-        for (auto it = exclusiveRules.begin(); it != exclusiveRules.end(); ++it) {
-            QString color = exclGroupColor[it.key()];
-            auto* lbl = new QLabel(QString("Exklusiv-Gruppe %1").arg(groupIndex++), legend);
+        for (int g = 0; g < groupBoxes.size(); ++g) {
+            if (groupBoxes[g].isEmpty() || !coloredGroups.contains(g))
+                continue;
+
+            QString color = colors[g % colors.size()];
+            auto* lbl = new QLabel(QString("Exklusiv-Gruppe %1").arg(g + 1), legend);
             lbl->setAlignment(Qt::AlignCenter);
             lbl->setFixedHeight(22);
             lbl->setStyleSheet(QString(
@@ -9,6 +9,7 @@
 #include <memory>
 
 struct WindowData;
+struct CompiledFlagRules;
 struct ControlData;
 class ProjectController;
 
@@ -33,7 +34,7 @@ private:
     QWidget* createFlagGroup(const QString& title,
                              const QMap<QString, quint32>& allFlags,
                              const QStringList& activeFlags,
-                             const QJsonObject& rules,
+                             const CompiledFlagRules& rules,
                              bool isWindow);
 
 private:
@@ -0,0 +1,249 @@
+#include "PixelFixup.h"
+#include "SimdSupport.h"
+
+#include <QRgb>
+
+namespace {
+
+using SimdSupport::cpu;
+
+constexpr quint32 ColorMask = 0x00FFFFFFu;
+constexpr quint32 Magenta   = 0x00FF00FFu;
+constexpr quint32 AlphaMask = 0xFF000000u;
+
+// ------------------------------------------------------------
+// Skalare Kernels
+// ------------------------------------------------------------
+void premultiplyScalar(quint32* d, int n)
+{
+    for (int x = 0; x < n; ++x)
+        d[x] = qPremultiply(d[x]);
+}
+
+void keyAndPremultiplyScalar(quint32* d, int n)
+{
+    for (int x = 0; x < n; ++x) {
+        const quint32 px = d[x];
+        d[x] = (px & ColorMask) == Magenta ? 0u : qPremultiply(px);
+    }
+}
+
+// ------------------------------------------------------------
+// SIMD-Kernels (x86). Premultiply rechnet je Pixel vier 16-Bit-
+// Kanäle (B,G,R,A) mal Alpha, gerundet wie qPremultiply:
+// (t + (t >> 8) + 0x80) >> 8. Blöcke ohne Transparenz werden
+// nur auf Magenta geprüft.
+// ------------------------------------------------------------
+#if defined(SIMD_SSE2)
+
+// Zwei Pixel (16-Bit-Kanäle) mit ihrem Alpha multiplizieren
+SIMD_TARGET("sse2")
+inline __m128i premultiply2Sse2(__m128i c)
+{
+    const __m128i alphaLanes = _mm_setr_epi16(0, 0, 0, -1, 0, 0, 0, -1);
+    const __m128i keepAlpha  = _mm_setr_epi16(0, 0, 0, 255, 0, 0, 0, 255);
+
+    __m128i a = _mm_shufflehi_epi16(_mm_shufflelo_epi16(c, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+    a = _mm_or_si128(_mm_andnot_si128(alphaLanes, a), keepAlpha);
+    const __m128i t = _mm_mullo_epi16(c, a);
+    return _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(t, _mm_srli_epi16(t, 8)), _mm_set1_epi16(0x80)), 8);
+}
+
+SIMD_TARGET("sse2")
+inline __m128i premultiply4Sse2(__m128i px)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i lo = premultiply2Sse2(_mm_unpacklo_epi8(px, zero));
+    const __m128i hi = premultiply2Sse2(_mm_unpackhi_epi8(px, zero));
+    return _mm_packus_epi16(lo, hi);
+}
+
+SIMD_TARGET("sse2")
+inline bool opaqueSse2(__m128i px)
+{
+    const __m128i alpha = _mm_set1_epi32(int(AlphaMask));
+    return _mm_movemask_epi8(_mm_cmpeq_epi32(_mm_and_si128(px, alpha), alpha)) == 0xFFFF;
+}
+
+SIMD_TARGET("sse2")
+int premultiplySse2(quint32* d, int n)
+{
+    int x = 0;
+    for (; x + 4 <= n; x += 4) {
+        __m128i* p = reinterpret_cast<__m128i*>(d + x);
+        const __m128i px = _mm_loadu_si128(p);
+        if (!opaqueSse2(px))
+            _mm_storeu_si128(p, premultiply4Sse2(px));
+    }
+    return x;
+}
+
+SIMD_TARGET("sse2")
+int keyAndPremultiplySse2(quint32* d, int n)
+{
+    const __m128i colorMask = _mm_set1_epi32(int(ColorMask));
+    const __m128i magenta   = _mm_set1_epi32(int(Magenta));
+
+    int x = 0;
+    for (; x + 4 <= n; x += 4) {
+        __m128i* p = reinterpret_cast<__m128i*>(d + x);
+        __m128i px = _mm_loadu_si128(p);
+
+        const __m128i keyed = _mm_cmpeq_epi32(_mm_and_si128(px, colorMask), magenta);
+        px = _mm_andnot_si128(keyed, px);
+
+        if (!opaqueSse2(px))
+            px = premultiply4Sse2(px);
+        _mm_storeu_si128(p, px);
+    }
+    return x;
+}
+#endif // SIMD_SSE2
+
+#if defined(SIMD_X86)
+
+// unpack/shuffle/pack arbeiten je 128-Bit-Lane – die Pixel-
+// reihenfolge bleibt damit erhalten
+SIMD_TARGET("avx2")
+inline __m256i premultiply8Avx2(__m256i px)
+{
+    const __m256i zero       = _mm256_setzero_si256();
+    const __m256i alphaLanes = _mm256_setr_epi16(0, 0, 0, -1, 0, 0, 0, -1, 0, 0, 0, -1, 0, 0, 0, -1);
+    const __m256i keepAlpha  = _mm256_setr_epi16(0, 0, 0, 255, 0, 0, 0, 255, 0, 0, 0, 255, 0, 0, 0, 255);
+    const __m256i round      = _mm256_set1_epi16(0x80);
+
+    __m256i halves[2] = { _mm256_unpacklo_epi8(px, zero), _mm256_unpackhi_epi8(px, zero) };
+    for (__m256i& c : halves) {
+        __m256i a = _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(c, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+        a = _mm256_or_si256(_mm256_andnot_si256(alphaLanes, a), keepAlpha);
+        const __m256i t = _mm256_mullo_epi16(c, a);
+        c = _mm256_srli_epi16(_mm256_add_epi16(_mm256_add_epi16(t, _mm256_srli_epi16(t, 8)), round), 8);
+    }
+    return _mm256_packus_epi16(halves[0], halves[1]);
+}
+
+SIMD_TARGET("avx2")
+inline bool opaqueAvx2(__m256i px)
+{
+    const __m256i alpha = _mm256_set1_epi32(int(AlphaMask));
+    return _mm256_movemask_epi8(_mm256_cmpeq_epi32(_mm256_and_si256(px, alpha), alpha)) == -1;
+}
+
+SIMD_TARGET("avx2")
+int premultiplyAvx2(quint32* d, int n)
+{
+    int x = 0;
+    for (; x + 8 <= n; x += 8) {
+        __m256i* p = reinterpret_cast<__m256i*>(d + x);
+        const __m256i px = _mm256_loadu_si256(p);
+        if (!opaqueAvx2(px))
+            _mm256_storeu_si256(p, premultiply8Avx2(px));
+    }
+    return x;
+}
+
+SIMD_TARGET("avx2")
+int keyAndPremultiplyAvx2(quint32* d, int n)
+{
+    const __m256i colorMask = _mm256_set1_epi32(int(ColorMask));
+    const __m256i magenta   = _mm256_set1_epi32(int(Magenta));
+
+    int x = 0;
+    for (; x + 8 <= n; x += 8) {
+        __m256i* p = reinterpret_cast<__m256i*>(d + x);
+        __m256i px = _mm256_loadu_si256(p);
+
+        const __m256i keyed = _mm256_cmpeq_epi32(_mm256_and_si256(px, colorMask), magenta);
+        px = _mm256_andnot_si256(keyed, px);
+
+        if (!opaqueAvx2(px))
+            px = premultiply8Avx2(px);
+        _mm256_storeu_si256(p, px);
+    }
+    return x;
+}
+
+#endif // SIMD_X86
+
+// ------------------------------------------------------------
+// Rand-Clamp auf premultiplizierten Zeilen (Alpha bleibt beim
+// Premultiply unverändert, die Prüfung ist also dieselbe)
+// ------------------------------------------------------------
+inline void clampRowEnds(quint32* row, int w)
+{
+    if (w < 2)
+        return;
+    if (qAlpha(row[0]) < 255)
+        row[0] = row[1];
+    if (qAlpha(row[w - 1]) < 255)
+        row[w - 1] = row[w - 2];
+}
+
+inline void clampRowFrom(quint32* row, const quint32* neighbour, int w)
+{
+    for (int x = 0; x < w; ++x) {
+        if (qAlpha(row[x]) < 255)
+            row[x] = neighbour[x];
+    }
+}
+
+} // namespace
+
+namespace PixelFixup
+{
+
+void premultiplyRow(quint32* d, int n)
+{
+    int x = 0;
+#if defined(SIMD_X86)
+    if (cpu().avx2)
+        x = premultiplyAvx2(d, n);
+#  if defined(SIMD_SSE2)
+    x += premultiplySse2(d + x, n - x);
+#  endif
+#endif
+    premultiplyScalar(d + x, n - x);
+}
+
+void keyAndPremultiplyRow(quint32* d, int n)
+{
+    int x = 0;
+#if defined(SIMD_X86)
+    if (cpu().avx2)
+        x = keyAndPremultiplyAvx2(d, n);
+#  if defined(SIMD_SSE2)
+    x += keyAndPremultiplySse2(d + x, n - x);
+#  endif
+#endif
+    keyAndPremultiplyScalar(d + x, n - x);
+}
+
+void prepareThemeImage(QImage& img)
+{
+    if (img.isNull())
+        return;
+
+    if (img.format() != QImage::Format_ARGB32)
+        img = img.convertToFormat(QImage::Format_ARGB32);
+
+    const int w = img.width();
+    const int h = img.height();
+    auto line = [&](int y) { return reinterpret_cast<quint32*>(img.scanLine(y)); };
+
+    for (int y = 0; y < h; ++y) {
+        quint32* row = line(y);
+        keyAndPremultiplyRow(row, w);
+        clampRowEnds(row, w);
+
+        if (h < 2)
+            continue;
+        if (y == 1)
+            clampRowFrom(line(0), row, w);
+        if (y == h - 1)
+            clampRowFrom(row, line(h - 2), w);
+    }
+
+    img.reinterpretAsFormat(QImage::Format_ARGB32_Premultiplied);
+}
+
+} // namespace PixelFixup
@@ -0,0 +1,28 @@
+#pragma once
+#include <QImage>
+
+// ------------------------------------------------------------
+// PixelFixup – Nachbearbeitung dekodierter Theme-Texturen
+// ------------------------------------------------------------
+// prepareThemeImage erledigt in einem Durchlauf über das Bild:
+//   1. Magenta (255, 0, 255) → transparent
+//   2. Premultiply
+//   3. nicht deckende Randpixel vom inneren Nachbarn übernehmen
+// Der Rand-Clamp läuft damit nach dem Keying (ausgestanzte
+// Randpixel bekommen die Farbe des Nachbarn) und kopiert bereits
+// premultiplizierte Werte – Premultiply ist pro Pixel, die
+// Reihenfolge ändert am Ergebnis nichts. Die obere Zeile wird
+// geklemmt, sobald Zeile 1 fertig ist, die untere am Ende; beide
+// liegen dann noch im Cache.
+// ------------------------------------------------------------
+namespace PixelFixup
+{
+
+// Zeilen-Kernels auf ARGB32 (SSE2/AVX2 mit skalarem Rest)
+void premultiplyRow(quint32* d, int n);
+void keyAndPremultiplyRow(quint32* d, int n);
+
+// Ergebnis: Format_ARGB32_Premultiplied, fertig für QPixmap::fromImage
+void prepareThemeImage(QImage& img);
+
+} // namespace PixelFixup
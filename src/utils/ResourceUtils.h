@@ -10,67 +10,34 @@
 #include <QDir>
 #include <QIcon>
 
+#include "PixelFixup.h"
+#include "TgaDecoder.h"
+
 namespace ResourceUtils
 {
 
 // ------------------------------------------------------------
-// 🔹 FlyFF-kompatibler TGA-Loader (unkomprimiert, 24/32-Bit)
+// 🔹 FlyFF-kompatibler TGA-Loader (Typ 2/10, 15/16/24/32-Bit)
 // ------------------------------------------------------------
+// Liefert ARGB32 (nicht premultiplied), damit Magenta-Maske und
+// Kanten-Clamp danach noch auf den Originalfarben arbeiten.
 inline QImage loadFlyffTga(const QString& path)
 {
-    QFile file(path);
-    if (!file.open(QIODevice::ReadOnly)) {
-        qWarning() << "[ResourceUtils] Konnte TGA-Datei nicht öffnen:" << path;
-        return QImage();
-    }
-
-    QByteArray data = file.readAll();
-    if (data.size() < 18)
-        return QImage();
-
-    const unsigned char* d = reinterpret_cast<const unsigned char*>(data.constData());
-    int width  = d[12] + (d[13] << 8);
-    int height = d[14] + (d[15] << 8);
-    int bpp    = d[16];
-
-    if (width <= 0 || height <= 0 || (bpp != 24 && bpp != 32))
-        return QImage();
-
-    int bytesPerPixel = bpp / 8;
-    int imageSize = width * height * bytesPerPixel;
-
-    if (data.size() < 18 + imageSize) {
-        qWarning() << "[ResourceUtils] TGA-Datei unvollständig:" << path;
-        return QImage();
-    }
-
-    QImage img(width, height, QImage::Format_ARGB32);
-    const unsigned char* src = d + 18;
-
-    // Vertikal flippen, Farbreihenfolge korrigieren (BGR → RGB)
-    for (int y = 0; y < height; ++y) {
-        QRgb* dest = reinterpret_cast<QRgb*>(img.scanLine(height - 1 - y));
-        for (int x = 0; x < width; ++x) {
-            uchar b = *src++;
-            uchar g = *src++;
-            uchar r = *src++;
-            uchar a = (bytesPerPixel == 4) ? *src++ : 255;
-            dest[x] = qRgba(r, g, b, a);
-        }
-    }
-
-    return img;
+    return TgaDecoder::load(path);
 }
 
 // ------------------------------------------------------------
 // 🔹 Entfernt FlyFF-typische Magenta-Maskenfarbe (255, 0, 255)
 // ------------------------------------------------------------
-inline QPixmap applyMagentaMask(const QPixmap& src)
+// QImage-Variante arbeitet in-place auf ARGB32 und ist damit auch
+// in Worker-Threads nutzbar (QPixmap nur im GUI-Thread).
+inline void applyMagentaMask(QImage& img)
 {
-    if (src.isNull())
-        return src;
+    if (img.isNull())
+        return;
 
-    QImage img = src.toImage().convertToFormat(QImage::Format_ARGB32);
+    if (img.format() != QImage::Format_ARGB32)
+        img = img.convertToFormat(QImage::Format_ARGB32);
 
     const int w = img.width();
     const int h = img.height();
@@ -84,46 +51,90 @@ inline QPixmap applyMagentaMask(const QPixmap& src)
             }
         }
     }
+}
+
+inline QPixmap applyMagentaMask(const QPixmap& src)
+{
+    if (src.isNull())
+        return src;
 
-    return QPixmap::fromImage(img);
+    QImage img = src.toImage();
+    applyMagentaMask(img);
+    return QPixmap::fromImage(std::move(img));
 }
 
 // ------------------------------------------------------------
 // 🔹 Entfernt transparente Ränder / clamped sie an benachbarte Pixel
 // ------------------------------------------------------------
-inline QPixmap clampTransparentEdges(const QPixmap& src)
+inline void clampTransparentEdges(QImage& img)
 {
-    if (src.isNull() || !src.hasAlphaChannel())
-        return src;
+    if (img.isNull() || !img.hasAlphaChannel())
+        return;
+
+    if (img.format() != QImage::Format_ARGB32)
+        img = img.convertToFormat(QImage::Format_ARGB32);
 
-    QImage img = src.toImage().convertToFormat(QImage::Format_ARGB32);
     const int w = img.width();
     const int h = img.height();
 
-    auto getSafe = [&](int x, int y) -> QRgb {
-        x = std::clamp(x, 0, w - 1);
-        y = std::clamp(y, 0, h - 1);
-        return img.pixel(x, y);
-    };
-
     // Linker / rechter Rand
-    for (int y = 0; y < h; ++y) {
+    for (int y = 0; y < h && w > 1; ++y) {
         QRgb* line = reinterpret_cast<QRgb*>(img.scanLine(y));
-        if (qAlpha(line[0]) < 255 && w > 1)
-            line[0] = getSafe(1, y);
-        if (qAlpha(line[w - 1]) < 255 && w > 1)
-            line[w - 1] = getSafe(w - 2, y);
+        if (qAlpha(line[0]) < 255)
+            line[0] = line[1];
+        if (qAlpha(line[w - 1]) < 255)
+            line[w - 1] = line[w - 2];
     }
 
     // Oberer / unterer Rand
+    if (h < 2)
+        return;
+
+    QRgb* top    = reinterpret_cast<QRgb*>(img.scanLine(0));
+    QRgb* bottom = reinterpret_cast<QRgb*>(img.scanLine(h - 1));
+    const QRgb* belowTop    = reinterpret_cast<const QRgb*>(img.constScanLine(1));
+    const QRgb* aboveBottom = reinterpret_cast<const QRgb*>(img.constScanLine(h - 2));
     for (int x = 0; x < w; ++x) {
-        if (qAlpha(img.pixel(x, 0)) < 255 && h > 1)
-            img.setPixel(x, 0, getSafe(x, 1));
-        if (qAlpha(img.pixel(x, h - 1)) < 255 && h > 1)
-            img.setPixel(x, h - 1, getSafe(x, h - 2));
+        if (qAlpha(top[x]) < 255)
+            top[x] = belowTop[x];
+        if (qAlpha(bottom[x]) < 255)
+            bottom[x] = aboveBottom[x];
+    }
+}
+
+inline QPixmap clampTransparentEdges(const QPixmap& src)
+{
+    if (src.isNull() || !src.hasAlphaChannel())
+        return src;
+
+    QImage img = src.toImage();
+    clampTransparentEdges(img);
+    return QPixmap::fromImage(std::move(img));
+}
+
+// ------------------------------------------------------------
+// 🔹 Textur komplett im Worker vorbereiten: dekodieren, dann
+//    Magenta-Maske, Premultiply und Ränder in einem Durchlauf
+//    (PixelFixup) – Zielformat für QPixmap::fromImage ohne
+//    weitere Konvertierung im GUI-Thread
+// ------------------------------------------------------------
+inline QImage loadThemeImage(const QString& filePath)
+{
+    QImage img;
+
+    if (QFileInfo(filePath).suffix().compare("tga", Qt::CaseInsensitive) == 0) {
+        img = loadFlyffTga(filePath);
+    } else {
+        QImageReader reader(filePath);
+        reader.setAutoTransform(true);
+        img = reader.read();
     }
 
-    return QPixmap::fromImage(img);
+    if (img.isNull())
+        return img;
+
+    PixelFixup::prepareThemeImage(img);
+    return img;
 }
 
 // ------------------------------------------------------------
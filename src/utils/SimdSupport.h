@@ -0,0 +1,69 @@
+#pragma once
+#include <QtGlobal>
+
+// ------------------------------------------------------------
+// SimdSupport – gemeinsame Basis der Pixel-Kernels
+// ------------------------------------------------------------
+// SIMD_X86     : x86/x64, Intrinsics verfügbar
+// SIMD_SSE2    : SSE2 ist Basis der Zielarchitektur (immer auf x64)
+// SIMD_TARGET  : Kernel für eine höhere Stufe übersetzen; aufrufen
+//                nur nach Prüfung von SimdSupport::cpu()
+//
+// Lambdas erben SIMD_TARGET nicht – Hilfsfunktionen in Kernels
+// daher als eigene SIMD_TARGET-Funktionen schreiben.
+// ------------------------------------------------------------
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#  define SIMD_X86 1
+#  include <immintrin.h>
+#  if defined(_MSC_VER)
+#    include <intrin.h>
+#    define SIMD_TARGET(features)
+#  else
+#    define SIMD_TARGET(features) __attribute__((target(features)))
+#  endif
+#  if defined(__x86_64__) || defined(_M_X64) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#    define SIMD_SSE2 1
+#  endif
+#endif
+
+namespace SimdSupport
+{
+
+struct CpuFeatures {
+    bool ssse3 = false;
+    bool avx2 = false;
+};
+
+inline CpuFeatures detectCpu()
+{
+    CpuFeatures f;
+#if defined(SIMD_X86)
+#  if defined(_MSC_VER)
+    int r[4];
+    __cpuid(r, 0);
+    const int maxLeaf = r[0];
+    __cpuid(r, 1);
+    f.ssse3 = (r[2] & (1 << 9)) != 0;
+    const bool osxsave = (r[2] & (1 << 27)) != 0;
+    const bool avx     = (r[2] & (1 << 28)) != 0;
+    if (maxLeaf >= 7 && osxsave && avx && (_xgetbv(0) & 6) == 6) {
+        __cpuidex(r, 7, 0);
+        f.avx2 = (r[1] & (1 << 5)) != 0;
+    }
+#  else
+    __builtin_cpu_init();
+    f.ssse3 = __builtin_cpu_supports("ssse3");
+    f.avx2  = __builtin_cpu_supports("avx2");
+#  endif
+#endif
+    return f;
+}
+
+// Einmalig erkannt, danach nur noch gelesen
+inline const CpuFeatures& cpu()
+{
+    static const CpuFeatures features = detectCpu();
+    return features;
+}
+
+} // namespace SimdSupport
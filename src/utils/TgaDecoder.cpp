@@ -0,0 +1,395 @@
+#include "TgaDecoder.h"
+#include "PixelFixup.h"
+#include "SimdSupport.h"
+
+#include <QElapsedTimer>
+#include <QFile>
+#include <QRgb>
+#include <QDebug>
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+
+namespace {
+
+// ------------------------------------------------------------
+// Header (18 Byte, little endian)
+// ------------------------------------------------------------
+struct Header {
+    int idLength = 0;
+    int colorMapType = 0;
+    int imageType = 0;
+    int colorMapLength = 0;
+    int colorMapEntryBits = 0;
+    int width = 0;
+    int height = 0;
+    int bpp = 0;
+    int descriptor = 0;
+
+    int alphaBits() const { return descriptor & 0x0F; }
+    bool rightToLeft() const { return (descriptor & 0x10) != 0; }
+    bool topToBottom() const { return (descriptor & 0x20) != 0; }
+};
+
+constexpr int HeaderSize = 18;
+
+inline int le16(const uchar* p)
+{
+    return p[0] | (p[1] << 8);
+}
+
+using SimdSupport::cpu;
+
+// ------------------------------------------------------------
+// Skalare Kernels: eine Zeile → ARGB32 (0xAARRGGBB)
+// ------------------------------------------------------------
+void row32Scalar(const uchar* s, quint32* d, int n)
+{
+    for (int x = 0; x < n; ++x, s += 4)
+        d[x] = quint32(s[3]) << 24 | quint32(s[2]) << 16 | quint32(s[1]) << 8 | s[0];
+}
+
+void row24Scalar(const uchar* s, quint32* d, int n)
+{
+    for (int x = 0; x < n; ++x, s += 3)
+        d[x] = 0xFF000000u | quint32(s[2]) << 16 | quint32(s[1]) << 8 | s[0];
+}
+
+inline quint32 expand5(quint32 v)
+{
+    return (v << 3) | (v >> 2);
+}
+
+void row16Scalar(const uchar* s, quint32* d, int n, bool alpha)
+{
+    for (int x = 0; x < n; ++x, s += 2) {
+        const quint32 p = quint32(le16(s));
+        const quint32 a = !alpha || (p & 0x8000) ? 0xFF : 0x00;
+        d[x] = a << 24 | expand5((p >> 10) & 0x1F) << 16 | expand5((p >> 5) & 0x1F) << 8 | expand5(p & 0x1F);
+    }
+}
+
+// ------------------------------------------------------------
+// SIMD-Kernels (x86). ARGB32 liegt little endian als B,G,R,A im
+// Speicher – genau die Byte-Reihenfolge von TGA. 32 bpp ist damit
+// ein memcpy, 24 bpp ein Byte-Shuffle, 16 bpp Bit-Arithmetik.
+// Alle Kernels lesen nur innerhalb der Quellzeile.
+// ------------------------------------------------------------
+#if defined(SIMD_X86)
+
+SIMD_TARGET("ssse3")
+int row24Ssse3(const uchar* s, quint32* d, int n)
+{
+    const __m128i shuffle = _mm_setr_epi8(0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1);
+    const __m128i alpha   = _mm_set1_epi32(int(0xFF000000u));
+
+    int x = 0;
+    for (; x + 6 <= n; x += 4) {           // liest 16 Byte ab 3x → 3x + 16 <= 3n
+        const __m128i px = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + 3 * x));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(d + x), _mm_or_si128(_mm_shuffle_epi8(px, shuffle), alpha));
+    }
+    return x;
+}
+
+SIMD_TARGET("avx2")
+int row24Avx2(const uchar* s, quint32* d, int n)
+{
+    // Byte 0..11 in die untere, 12..23 in die obere Lane, dann wie SSSE3
+    const __m256i spread  = _mm256_setr_epi32(0, 1, 2, 0, 3, 4, 5, 0);
+    const __m256i shuffle = _mm256_setr_epi8(0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1,
+                                             0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1);
+    const __m256i alpha   = _mm256_set1_epi32(int(0xFF000000u));
+
+    int x = 0;
+    for (; x + 11 <= n; x += 8) {          // liest 32 Byte ab 3x → 3x + 32 <= 3n
+        __m256i px = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + 3 * x));
+        px = _mm256_permutevar8x32_epi32(px, spread);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(d + x), _mm256_or_si256(_mm256_shuffle_epi8(px, shuffle), alpha));
+    }
+    return x;
+}
+
+#if defined(SIMD_SSE2)
+// 5 → 8 Bit: (v << 3) | (v >> 2)
+SIMD_TARGET("sse2")
+inline __m128i expand5Sse2(__m128i v)
+{
+    return _mm_or_si128(_mm_slli_epi16(v, 3), _mm_srli_epi16(v, 2));
+}
+
+SIMD_TARGET("sse2")
+int row16Sse2(const uchar* s, quint32* d, int n, bool alpha)
+{
+    const __m128i m5     = _mm_set1_epi16(0x1F);
+    const __m128i mLow8  = _mm_set1_epi16(0xFF);
+    const __m128i opaque = _mm_set1_epi16(-1);
+
+    int x = 0;
+    for (; x + 8 <= n; x += 8) {
+        const __m128i p = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + 2 * x));
+        const __m128i b = expand5Sse2(_mm_and_si128(p, m5));
+        const __m128i g = expand5Sse2(_mm_and_si128(_mm_srli_epi16(p, 5), m5));
+        const __m128i r = expand5Sse2(_mm_and_si128(_mm_srli_epi16(p, 10), m5));
+        const __m128i a = _mm_and_si128(alpha ? _mm_srai_epi16(p, 15) : opaque, mLow8);
+
+        const __m128i bg = _mm_or_si128(b, _mm_slli_epi16(g, 8));
+        const __m128i ra = _mm_or_si128(r, _mm_slli_epi16(a, 8));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(d + x),     _mm_unpacklo_epi16(bg, ra));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(d + x + 4), _mm_unpackhi_epi16(bg, ra));
+    }
+    return x;
+}
+#endif // SIMD_SSE2
+
+SIMD_TARGET("avx2")
+inline __m256i expand5Avx2(__m256i v)
+{
+    return _mm256_or_si256(_mm256_slli_epi16(v, 3), _mm256_srli_epi16(v, 2));
+}
+
+SIMD_TARGET("avx2")
+int row16Avx2(const uchar* s, quint32* d, int n, bool alpha)
+{
+    const __m256i m5     = _mm256_set1_epi16(0x1F);
+    const __m256i mLow8  = _mm256_set1_epi16(0xFF);
+    const __m256i opaque = _mm256_set1_epi16(-1);
+
+    int x = 0;
+    for (; x + 16 <= n; x += 16) {
+        const __m256i p = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + 2 * x));
+        const __m256i b = expand5Avx2(_mm256_and_si256(p, m5));
+        const __m256i g = expand5Avx2(_mm256_and_si256(_mm256_srli_epi16(p, 5), m5));
+        const __m256i r = expand5Avx2(_mm256_and_si256(_mm256_srli_epi16(p, 10), m5));
+        const __m256i a = _mm256_and_si256(alpha ? _mm256_srai_epi16(p, 15) : opaque, mLow8);
+
+        const __m256i bg = _mm256_or_si256(b, _mm256_slli_epi16(g, 8));
+        const __m256i ra = _mm256_or_si256(r, _mm256_slli_epi16(a, 8));
+
+        // unpack arbeitet je 128-Bit-Lane → Pixel 0-3/8-11 und 4-7/12-15
+        const __m256i u0 = _mm256_unpacklo_epi16(bg, ra);
+        const __m256i u1 = _mm256_unpackhi_epi16(bg, ra);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(d + x),     _mm256_permute2x128_si256(u0, u1, 0x20));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(d + x + 8), _mm256_permute2x128_si256(u0, u1, 0x31));
+    }
+    return x;
+}
+
+#endif // SIMD_X86
+
+// ------------------------------------------------------------
+// Dispatch je Zeile: SIMD für den Hauptteil, skalar für den Rest
+// ------------------------------------------------------------
+void convertRow(const uchar* s, quint32* d, int n, int bytesPerPixel, bool alpha16)
+{
+    int x = 0;
+
+    switch (bytesPerPixel) {
+    case 4:
+#if Q_BYTE_ORDER == Q_LITTLE_ENDIAN
+        std::memcpy(d, s, size_t(n) * 4);
+        x = n;
+#endif
+        row32Scalar(s + 4 * x, d + x, n - x);
+        return;
+
+    case 3:
+#if defined(SIMD_X86)
+        if (cpu().avx2)
+            x = row24Avx2(s, d, n);
+        if (cpu().ssse3)
+            x += row24Ssse3(s + 3 * x, d + x, n - x);
+#endif
+        row24Scalar(s + 3 * x, d + x, n - x);
+        return;
+
+    case 2:
+#if defined(SIMD_X86)
+        if (cpu().avx2)
+            x = row16Avx2(s, d, n, alpha16);
+#  if defined(SIMD_SSE2)
+        x += row16Sse2(s + 2 * x, d + x, n - x, alpha16);
+#  endif
+#endif
+        row16Scalar(s + 2 * x, d + x, n - x, alpha16);
+        return;
+    }
+}
+
+// ------------------------------------------------------------
+// RLE (Typ 10) in einen zusammenhängenden Puffer entpacken.
+// Pakete dürfen laut Spezifikation über Zeilenenden laufen.
+// ------------------------------------------------------------
+bool unpackRle(const uchar* src, const uchar* end, uchar* out, qsizetype total, int bpp)
+{
+    qsizetype pos = 0;
+    while (pos < total) {
+        if (src >= end)
+            return false;
+
+        const uchar head = *src++;
+        const qsizetype count = (head & 0x7F) + 1;
+        const qsizetype bytes = qMin(count * bpp, total - pos);
+
+        if (head & 0x80) {
+            // Wiederholung: ein Pixel, count-mal
+            if (end - src < bpp)
+                return false;
+            for (qsizetype i = 0; i < bytes; i += bpp)
+                std::memcpy(out + pos + i, src, size_t(qMin<qsizetype>(bpp, bytes - i)));
+            src += bpp;
+        } else {
+            // Rohdaten: count Pixel
+            if (end - src < count * bpp)
+                return false;
+            std::memcpy(out + pos, src, size_t(bytes));
+            src += count * bpp;
+        }
+        pos += bytes;
+    }
+    return true;
+}
+
+// Laufende Summen für stats() – load() läuft in Worker-Threads
+std::atomic<quint64> g_files{0};
+std::atomic<quint64> g_bytes{0};
+std::atomic<quint64> g_pixels{0};
+std::atomic<quint64> g_nanoseconds{0};
+
+inline QImage fail(QString* error, const QString& message)
+{
+    if (error)
+        *error = message;
+    return QImage();
+}
+
+} // namespace
+
+namespace TgaDecoder
+{
+
+QImage decode(QByteArrayView data, bool premultiplied, QString* error)
+{
+    if (data.size() < HeaderSize)
+        return fail(error, "Datei kleiner als TGA-Header");
+
+    const uchar* d = reinterpret_cast<const uchar*>(data.data());
+    const uchar* end = d + data.size();
+
+    Header h;
+    h.idLength          = d[0];
+    h.colorMapType      = d[1];
+    h.imageType         = d[2];
+    h.colorMapLength    = le16(d + 5);
+    h.colorMapEntryBits = d[7];
+    h.width             = le16(d + 12);
+    h.height            = le16(d + 14);
+    h.bpp               = d[16];
+    h.descriptor        = d[17];
+
+    if (h.imageType != 2 && h.imageType != 10)
+        return fail(error, QString("TGA-Typ %1 nicht unterstützt (nur 2 und 10)").arg(h.imageType));
+    if (h.bpp != 15 && h.bpp != 16 && h.bpp != 24 && h.bpp != 32)
+        return fail(error, QString("%1 bpp nicht unterstützt").arg(h.bpp));
+    if (h.width <= 0 || h.height <= 0)
+        return fail(error, "Ungültige Bildgröße");
+
+    // ID-Feld und (bei Truecolor ungenutzte) Farbtabelle überspringen
+    qsizetype offset = HeaderSize + h.idLength;
+    if (h.colorMapType == 1)
+        offset += qsizetype(h.colorMapLength) * ((h.colorMapEntryBits + 7) / 8);
+    if (offset > data.size())
+        return fail(error, "TGA-Datei unvollständig (Header)");
+
+    const int bytesPerPixel = (h.bpp + 7) / 8;
+    const qsizetype rowBytes = qsizetype(h.width) * bytesPerPixel;
+    const qsizetype total = rowBytes * h.height;
+
+    const uchar* pixels = d + offset;
+    QByteArray unpacked;
+
+    if (h.imageType == 10) {
+        unpacked.resize(total);
+        if (!unpackRle(pixels, end, reinterpret_cast<uchar*>(unpacked.data()), total, bytesPerPixel))
+            return fail(error, "TGA-RLE-Daten unvollständig");
+        pixels = reinterpret_cast<const uchar*>(unpacked.constData());
+    } else if (end - pixels < total) {
+        return fail(error, "TGA-Datei unvollständig");
+    }
+
+    QImage img(h.width, h.height, premultiplied ? QImage::Format_ARGB32_Premultiplied : QImage::Format_ARGB32);
+    if (img.isNull())
+        return fail(error, "Kein Speicher für das Bild");
+
+    // 16 bpp: Alpha-Bit nur, wenn der Descriptor eins ankündigt
+    const bool alpha16 = h.bpp == 16 && h.alphaBits() == 1;
+    const bool hasAlpha = bytesPerPixel == 4 || alpha16;
+
+    for (int row = 0; row < h.height; ++row) {
+        const int y = h.topToBottom() ? row : h.height - 1 - row;
+        quint32* dest = reinterpret_cast<quint32*>(img.scanLine(y));
+
+        convertRow(pixels + row * rowBytes, dest, h.width, bytesPerPixel, alpha16);
+
+        if (h.rightToLeft())
+            std::reverse(dest, dest + h.width);
+        if (premultiplied && hasAlpha)
+            PixelFixup::premultiplyRow(dest, h.width);
+    }
+
+    return img;
+}
+
+QImage load(const QString& path, bool premultiplied)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        qWarning() << "[TgaDecoder] Konnte TGA-Datei nicht öffnen:" << path;
+        return QImage();
+    }
+
+    // Mappen statt lesen; readAll() als Fallback
+    QByteArray buffer;
+    QByteArrayView data;
+    if (uchar* mapped = file.map(0, file.size())) {
+        data = QByteArrayView(mapped, file.size());
+    } else {
+        buffer = file.readAll();
+        data = buffer;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+
+    QString error;
+    QImage img = decode(data, premultiplied, &error);
+    if (img.isNull()) {
+        qWarning().noquote() << "[TgaDecoder]" << error << ":" << path;
+        return img;
+    }
+
+    g_nanoseconds.fetch_add(quint64(timer.nsecsElapsed()), std::memory_order_relaxed);
+    g_files.fetch_add(1, std::memory_order_relaxed);
+    g_bytes.fetch_add(quint64(data.size()), std::memory_order_relaxed);
+    g_pixels.fetch_add(quint64(img.width()) * quint64(img.height()), std::memory_order_relaxed);
+    return img;
+}
+
+Stats stats()
+{
+    Stats s;
+    s.files       = g_files.load(std::memory_order_relaxed);
+    s.bytes       = g_bytes.load(std::memory_order_relaxed);
+    s.pixels      = g_pixels.load(std::memory_order_relaxed);
+    s.nanoseconds = g_nanoseconds.load(std::memory_order_relaxed);
+    return s;
+}
+
+void resetStats()
+{
+    g_files = 0;
+    g_bytes = 0;
+    g_pixels = 0;
+    g_nanoseconds = 0;
+}
+
+} // namespace TgaDecoder
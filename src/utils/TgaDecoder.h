@@ -0,0 +1,41 @@
+#pragma once
+#include <QByteArrayView>
+#include <QImage>
+#include <QString>
+
+// ------------------------------------------------------------
+// TgaDecoder – TGA-Decoder für Theme-Texturen
+// ------------------------------------------------------------
+// Unterstützt Typ 2 (unkomprimiert) und Typ 10 (RLE) mit 15/16,
+// 24 und 32 bpp. ID-Feld und Farbtabelle werden übersprungen, der
+// Ursprung (unten/oben, links/rechts) kommt aus dem Image-Descriptor.
+//
+// Die Zeilen werden direkt in das Ziel-QImage geschrieben; die
+// Pixel-Kernels nutzen SSE2/SSSE3/AVX2, wenn die CPU es kann
+// (Laufzeit-Erkennung), sonst die skalaren Varianten.
+// ------------------------------------------------------------
+namespace TgaDecoder
+{
+
+// Ergebnis: Format_ARGB32 bzw. Format_ARGB32_Premultiplied
+QImage decode(QByteArrayView data, bool premultiplied = false, QString* error = nullptr);
+
+QImage load(const QString& path, bool premultiplied = false);
+
+// Durchsatz von load() seit Start bzw. resetStats() (alle Threads
+// zusammen; Zeit = Summe der Dekodierzeiten, nicht Wanduhr)
+struct Stats {
+    quint64 files = 0;
+    quint64 bytes = 0;          // gelesene TGA-Bytes
+    quint64 pixels = 0;
+    quint64 nanoseconds = 0;
+
+    double megabytesPerSecond() const
+    {
+        return nanoseconds ? double(bytes) / (1024.0 * 1024.0) / (double(nanoseconds) / 1e9) : 0.0;
+    }
+};
+Stats stats();
+void resetStats();
+
+} // namespace TgaDecoder
@@ -0,0 +1,85 @@
+#include "define/DefineEvaluator.h"
+
+#include <QtTest>
+
+// ------------------------------------------------------------
+// DefineEvaluator – Ausdrücke und 64-Bit-Überläufe
+// ------------------------------------------------------------
+class DefineEvaluatorTest : public QObject
+{
+    Q_OBJECT
+
+private:
+    static DefineEvaluator evaluator()
+    {
+        return DefineEvaluator({
+            { "WBS_CHILD",   "0x00000001" },
+            { "WBS_VISIBLE", "(0x2UL)" },
+            { "INT64_MAX_",  "0x7FFFFFFFFFFFFFFF" },
+            { "INT64_MIN_",  "(-INT64_MAX_ - 1)" },
+        });
+    }
+
+    // Fehler als nicht erreichbarer Wert, damit QCOMPARE ihn zeigt
+    static qint64 valueOf(const std::optional<quint32>& v)
+    {
+        return v ? qint64(*v) : -1;
+    }
+
+    static bool fails(const QString& expression)
+    {
+        DefineEvaluator e = evaluator();
+        QString error;
+        const bool failed = !e.evaluate(expression, &error).has_value();
+        return failed && !error.isEmpty();
+    }
+
+private slots:
+    void evaluatesExpressions()
+    {
+        DefineEvaluator e = evaluator();
+        QCOMPARE(valueOf(e.evaluate("(WBS_CHILD | WBS_VISIBLE) * 3")), qint64(9));
+        QCOMPARE(valueOf(e.evaluate("-7 / 2")), qint64(quint32(-3)));
+        QCOMPARE(valueOf(e.evaluate("-7 % 2")), qint64(quint32(-1)));
+        QCOMPARE(valueOf(e.evaluate("INT64_MIN_ / 1 == INT64_MIN_")), qint64(1));
+        QCOMPARE(valueOf(e.evaluate("INT64_MIN_ * 1 == INT64_MIN_")), qint64(1));
+        QCOMPARE(valueOf(e.value("WBS_VISIBLE")), qint64(2));
+    }
+
+    void multiplicationOverflowIsError()
+    {
+        QVERIFY(fails("INT64_MAX_ * 2"));
+        QVERIFY(fails("INT64_MIN_ * -1"));
+        QVERIFY(fails("0x100000000 * 0x100000000"));
+    }
+
+    void negationOfMinimumIsError()
+    {
+        QVERIFY(fails("-INT64_MIN_"));
+        QVERIFY(fails("-(INT64_MIN_)"));
+    }
+
+    void divisionOverflowIsError()
+    {
+        QVERIFY(fails("INT64_MIN_ / -1"));
+        QVERIFY(fails("INT64_MIN_ % -1"));
+        QVERIFY(fails("1 / 0"));
+        QVERIFY(fails("1 % 0"));
+    }
+
+    void additionOverflowIsError()
+    {
+        QVERIFY(fails("INT64_MAX_ + 1"));
+        QVERIFY(fails("INT64_MIN_ - 1"));
+    }
+
+    void overflowInDefineFailsSymbol()
+    {
+        DefineEvaluator e({ { "BIG", "0x7FFFFFFFFFFFFFFF" }, { "BAD", "BIG * BIG" }, { "USE", "BAD | 1" } });
+        QVERIFY(!e.value("BAD").has_value());
+        QVERIFY(!e.value("USE").has_value());
+    }
+};
+
+QTEST_APPLESS_MAIN(DefineEvaluatorTest)
+#include "DefineEvaluatorTest.moc"
@@ -0,0 +1,124 @@
+#include "behavior/FlagRuleEngine.h"
+#include "behavior/RuleModel.h"
+
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QtTest>
+
+// ------------------------------------------------------------
+// FlagRuleEngine – Exklusivregeln aus *_flag_rules.json
+// ------------------------------------------------------------
+class FlagRuleEngineTest : public QObject
+{
+    Q_OBJECT
+
+private:
+    static constexpr quint32 F = 0x0001;
+    static constexpr quint32 A = 0x0002;
+    static constexpr quint32 B = 0x0004;
+    static constexpr quint32 AB = A | B;      // Mehr-Bit-Wert, A ⊂ AB
+
+    static QMap<QString, quint32> controlFlags()
+    {
+        return { { "F", F }, { "A", A }, { "B", B }, { "AB", AB } };
+    }
+
+    // WTYPE_BUTTON mit "exclusive": { <key>: <listed> }
+    static FlagRuleEngine compile(const QString& exclusiveKey,
+                                  const QJsonArray& listed = QJsonArray{ "A", "B" })
+    {
+        const QJsonObject rules{
+            { "WTYPE_BUTTON", QJsonObject{
+                  { "exclusive", QJsonObject{ { exclusiveKey, listed } } } } }
+        };
+
+        FlagRuleEngine engine;
+        engine.compile(QJsonObject(),
+                       FlagRuleSet::parse(QJsonObject(), {}),
+                       FlagRuleSet::parse(rules, controlFlags()),
+                       {}, controlFlags());
+        return engine;
+    }
+
+private slots:
+    void flagKeyExcludesListedFlags()
+    {
+        const FlagRuleEngine engine = compile("F");
+        const CompiledFlagRules& rules = engine.rulesForControl("WTYPE_BUTTON");
+
+        QVERIFY(!FlagRuleEngine::check(rules, F | A).ok());
+        QVERIFY(!FlagRuleEngine::check(rules, F | B).ok());
+
+        // Neu gesetztes Flag gewinnt
+        QCOMPARE(FlagRuleEngine::correct(rules, F | A | B, F), F);
+        QCOMPARE(FlagRuleEngine::correct(rules, F | A, A), A);
+    }
+
+    void listedFlagsStayCombinable()
+    {
+        const FlagRuleEngine engine = compile("F");
+        const CompiledFlagRules& rules = engine.rulesForControl("WTYPE_BUTTON");
+
+        QVERIFY(FlagRuleEngine::check(rules, A | B).ok());
+        QCOMPARE(FlagRuleEngine::correct(rules, A | B), A | B);
+        QCOMPARE(FlagRuleEngine::correct(rules, A | B, B), A | B);
+    }
+
+    void namedGroupIsMutuallyExclusive()
+    {
+        const FlagRuleEngine engine = compile("Ausrichtung");
+        const CompiledFlagRules& rules = engine.rulesForControl("WTYPE_BUTTON");
+
+        QVERIFY(!FlagRuleEngine::check(rules, A | B).ok());
+        QCOMPARE(FlagRuleEngine::correct(rules, A | B, B), B);
+    }
+
+    void singleBitGroupUsesMask()
+    {
+        const FlagRuleEngine engine = compile("Ausrichtung", QJsonArray{ "F", "A", "B" });
+        const CompiledFlagRules& rules = engine.rulesForControl("WTYPE_BUTTON");
+
+        QCOMPARE(rules.groupMasks.size(), rules.exclusive.size());
+        QCOMPARE(rules.groupMasks.first().bits, F | A | B);
+        QVERIFY(rules.groupMasks.first().singleBits);
+
+        QVERIFY(FlagRuleEngine::check(rules, A).ok());
+        QCOMPARE(FlagRuleEngine::check(rules, F | A | B).conflicting, F | A | B);
+        QCOMPARE(FlagRuleEngine::correct(rules, F | A | B, B), B);
+        QCOMPARE(FlagRuleEngine::correct(rules, F | B), F);   // ohne Präferenz: erstes Mitglied
+    }
+
+    void subsetMemberDoesNotConflict()
+    {
+        // AB enthält A → gesetztes AB aktiviert A nicht zusätzlich
+        const FlagRuleEngine engine = compile("Stil", QJsonArray{ "A", "AB", "F" });
+        const CompiledFlagRules& rules = engine.rulesForControl("WTYPE_BUTTON");
+
+        QVERIFY(!rules.groupMasks.first().singleBits);
+        QVERIFY(FlagRuleEngine::check(rules, AB).ok());
+
+        const FlagCheckResult r = FlagRuleEngine::check(rules, AB | F);
+        QCOMPARE(r.conflicting, AB | F);
+        QCOMPARE(FlagRuleEngine::correct(rules, AB | F, AB), AB);
+        QCOMPARE(FlagRuleEngine::correct(rules, AB | F, F), F);
+    }
+
+    void restoreRebuildsGroupMasks()
+    {
+        const FlagRuleEngine engine = compile("Ausrichtung");
+
+        QHash<QString, CompiledFlagRules> controlScopes = engine.controlScopes();
+        for (CompiledFlagRules& rules : controlScopes)
+            rules.groupMasks.clear();        // wie aus flags.db: nur Gruppen
+
+        FlagRuleEngine restored;
+        restored.restore(engine.windowBase(), engine.controlBase(), engine.windowScopes(), controlScopes);
+
+        const CompiledFlagRules& rules = restored.rulesForControl("WTYPE_BUTTON");
+        QCOMPARE(rules.groupMasks.size(), rules.exclusive.size());
+        QVERIFY(!FlagRuleEngine::check(rules, A | B).ok());
+    }
+};
+
+QTEST_APPLESS_MAIN(FlagRuleEngineTest)
+#include "FlagRuleEngineTest.moc"
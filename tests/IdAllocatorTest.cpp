@@ -0,0 +1,153 @@
+#include "define/IdAllocator.h"
+
+#include <QtTest>
+
+// ------------------------------------------------------------
+// IdAllocator – Seiten-Bitmap, Cursor, Wraparound, Blockvergabe
+// ------------------------------------------------------------
+class IdAllocatorTest : public QObject
+{
+    Q_OBJECT
+
+private:
+    static constexpr quint32 PageSize = 4096;
+
+    // Fehler als nicht erreichbarer Wert, damit QCOMPARE ihn zeigt
+    static qint64 valueOf(const std::optional<quint32>& v)
+    {
+        return v ? qint64(*v) : -1;
+    }
+
+    static void markRange(IdAllocator& a, quint32 first, quint32 last)
+    {
+        for (quint64 v = first; v <= last; ++v)
+            a.mark(quint32(v));
+    }
+
+private slots:
+    void skipsFullPage()
+    {
+        IdAllocator a;
+        markRange(a, 0, PageSize - 1);
+
+        QVERIFY(!a.allocate(IdRange{ 0, PageSize - 1 }));
+        QCOMPARE(valueOf(a.allocate(IdRange{ 0, 0xFFFFFFFFu })), qint64(PageSize));
+    }
+
+    void rangeCrossesPageBoundary()
+    {
+        IdAllocator a;
+        const IdRange range{ PageSize - 6, PageSize + 4 };
+        markRange(a, PageSize - 6, PageSize - 1);
+
+        QCOMPARE(valueOf(a.allocate(range)), qint64(PageSize));
+        QCOMPARE(a.allocate(3, range, true), (QVector<quint32>{ PageSize + 1, PageSize + 2, PageSize + 3 }));
+    }
+
+    void wrapsAroundToRangeFirst()
+    {
+        IdAllocator a;
+        const IdRange range{ 10, 12 };
+
+        QCOMPARE(valueOf(a.allocate(range)), 10);
+        QCOMPARE(valueOf(a.allocate(range)), 11);
+        QCOMPARE(valueOf(a.allocate(range)), 12);   // Cursor springt auf range.first
+        QVERIFY(!a.allocate(range));
+
+        a.release(11);
+        QCOMPARE(valueOf(a.allocate(range)), 11);
+    }
+
+    void searchWrapsBelowCursor()
+    {
+        // Freigabe in einer Seite, in der der Bereich nie vergeben hat →
+        // Cursor bleibt stehen, die Suche findet die ID nach dem Umlauf
+        IdAllocator a;
+        const IdRange range{ PageSize - 6, PageSize + 4 };
+        markRange(a, PageSize - 6, PageSize - 1);
+
+        QCOMPARE(valueOf(a.allocate(range)), qint64(PageSize));
+        markRange(a, PageSize + 1, PageSize + 4);
+        a.release(PageSize - 3);
+
+        QCOMPARE(valueOf(a.allocate(range)), qint64(PageSize - 3));
+        QVERIFY(!a.allocate(range));
+    }
+
+    void reusesReleasedIdViaCursor()
+    {
+        IdAllocator a;
+        const IdRange range{ 1, 100 };
+        for (int i = 1; i <= 5; ++i)
+            QCOMPARE(valueOf(a.allocate(range)), i);
+
+        a.release(3);
+        QCOMPARE(valueOf(a.allocate(range)), 3);
+        QCOMPARE(valueOf(a.allocate(range)), 6);
+        QCOMPARE(a.usedCount(), 6);
+    }
+
+    void releaseOnlyRewindsOwningRanges()
+    {
+        IdAllocator a;
+        const IdRange low{ 1, 999 };
+        const IdRange high{ 1000, 1999 };
+
+        QCOMPARE(valueOf(a.allocate(low)), 1);
+        QCOMPARE(valueOf(a.allocate(low)), 2);
+        QCOMPARE(valueOf(a.allocate(high)), 1000);
+
+        a.release(1);
+        QCOMPARE(valueOf(a.allocate(high)), 1001);
+        QCOMPARE(valueOf(a.allocate(low)), 1);
+    }
+
+    void bulkIsAllOrNothing()
+    {
+        IdAllocator a;
+        const IdRange range{ 1, 5 };
+        a.mark(3);
+
+        QVERIFY(a.allocate(5, range).isEmpty());
+        QCOMPARE(a.usedCount(), 1);
+        QVERIFY(!a.isUsed(1));
+
+        QCOMPARE(a.allocate(4, range), (QVector<quint32>{ 1, 2, 4, 5 }));
+        QCOMPARE(a.usedCount(), 5);
+    }
+
+    void contiguousRunSkipsUsedIds()
+    {
+        IdAllocator a;
+        const IdRange range{ 1, 10 };
+        a.mark(3);
+        a.mark(7);
+
+        QCOMPARE(a.allocate(3, range, true), (QVector<quint32>{ 4, 5, 6 }));
+        QVERIFY(a.allocate(4, range, true).isEmpty());
+        QCOMPARE(a.allocate(3, range, true), (QVector<quint32>{ 8, 9, 10 }));
+        QCOMPARE(a.allocate(2, range, true), (QVector<quint32>{ 1, 2 }));
+        QCOMPARE(a.usedCount(), 10);
+    }
+
+    void handlesTopOfValueSpace()
+    {
+        IdAllocator a;
+        const IdRange range{ 0xFFFFFFF0u, 0xFFFFFFFFu };
+        for (int i = 0; i < 16; ++i)
+            QCOMPARE(valueOf(a.allocate(range)), qint64(0xFFFFFFF0u) + i);
+        QVERIFY(!a.allocate(range));
+
+        a.release(0xFFFFFFFFu);
+        QCOMPARE(valueOf(a.allocate(range)), qint64(0xFFFFFFFFu));
+
+        IdAllocator b;
+        b.mark(0xFFFFFFFDu);
+        QCOMPARE(b.allocate(2, IdRange{ 0xFFFFFFFCu, 0xFFFFFFFFu }, true),
+                 (QVector<quint32>{ 0xFFFFFFFEu, 0xFFFFFFFFu }));
+        QVERIFY(b.allocate(2, IdRange{ 0xFFFFFFFCu, 0xFFFFFFFFu }, true).isEmpty());
+    }
+};
+
+QTEST_APPLESS_MAIN(IdAllocatorTest)
+#include "IdAllocatorTest.moc"
@@ -0,0 +1,62 @@
+#include "text/TextSearchIndex.h"
+
+#include <QtTest>
+
+// ------------------------------------------------------------
+// TextSearchIndex – Sprachen, die nach dem Aufbau hinzukommen
+// ------------------------------------------------------------
+class TextSearchIndexTest : public QObject
+{
+    Q_OBJECT
+
+private:
+    static TextSearchIndex buildOneLanguage()
+    {
+        std::vector<TextSearchIndex::Column> columns(1);
+        columns[0].edits = { { 0, "Inventar öffnen" }, { 1, "Charakter" }, { 2, "Inventory" } };
+
+        TextSearchIndex index;
+        index.build(columns, 3);
+        return index;
+    }
+
+private slots:
+    void findsBuiltColumn()
+    {
+        const TextSearchIndex index = buildOneLanguage();
+        const auto hits = index.find("INVENT");
+        QCOMPARE(hits.size(), 2);
+        QCOMPARE(hits[0].row, 0);
+        QCOMPARE(hits[1].row, 2);
+    }
+
+    void updateOfNewLanguageExtendsColumns()
+    {
+        TextSearchIndex index = buildOneLanguage();
+        index.update(1, 1, "Character");
+        index.update(2, 2, "Inventaire");
+        QCOMPARE(index.columnCount(), 3);
+
+        // Alte Dokumente bleiben nach dem Umrechnen auffindbar
+        auto hits = index.find("Charakter");
+        QCOMPARE(hits.size(), 1);
+        QCOMPARE(hits[0].row, 1);
+        QCOMPARE(hits[0].column, 0);
+
+        hits = index.find("character");
+        QCOMPARE(hits.size(), 1);
+        QCOMPARE(hits[0].row, 1);
+        QCOMPARE(hits[0].column, 1);
+
+        hits = index.find("invent");
+        QCOMPARE(hits.size(), 3);
+        QCOMPARE(hits[2].row, 2);
+        QCOMPARE(hits[2].column, 2);
+
+        // Kurze Query läuft linear über dieselben Dokumente
+        QCOMPARE(index.find("ai").size(), 1);
+    }
+};
+
+QTEST_APPLESS_MAIN(TextSearchIndexTest)
+#include "TextSearchIndexTest.moc"
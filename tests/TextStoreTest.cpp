@@ -0,0 +1,143 @@
+#include "text/TextStore.h"
+#include "TextTestData.h"
+
+#include <QtTest>
+
+// ------------------------------------------------------------
+// TextStore – Patch-Save und Kompaktierung
+// (laden → ändern → speichern → neu laden)
+// ------------------------------------------------------------
+class TextStoreTest : public QObject
+{
+    Q_OBJECT
+
+private:
+    // Wie TextBackend::saveLanguage: einsammeln, lösen, schreiben, neu mappen
+    static bool save(TextStore& store, const QByteArray& data, const QString& path)
+    {
+        store.detachColumn(0);
+
+        QFile out(path);
+        if (!out.open(QIODevice::WriteOnly) || out.write(data) != data.size())
+            return false;
+        out.close();
+
+        return store.reattachColumn(0, path, true) && store.editCount(0) == 0;
+    }
+
+    static QString valueOf(const TextStore& store, const QString& id)
+    {
+        const int row = store.row(id);
+        return row >= 0 ? store.value(row, 0) : QStringLiteral("<fehlt>");
+    }
+
+private slots:
+    void patchRoundTripKeepsMultibyteEndings()
+    {
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+        const QString path = TextTestData::writeFile(dir, TextTestData::content("\r\n"));
+        QVERIFY(!path.isEmpty());
+
+        const QString edited = QStringLiteral("neu à");
+        {
+            TextStore store;
+            QVERIFY(store.load({ TextStore::Source{ "English", path } }));
+            QVERIFY(store.canPatch(0));
+
+            const int row = store.row("IDS_TEXT_0");
+            QVERIFY(row >= 0);
+            store.setValue(row, 0, edited);
+
+            QVERIFY(save(store, store.patchedColumn(0), path));
+            QCOMPARE(store.value(row, 0), edited);
+        }
+
+        // Frisch geladen: kein verwaistes Folgebyte, Zeilenende bleibt CRLF
+        TextStore reloaded;
+        QVERIFY(reloaded.load({ TextStore::Source{ "English", path } }));
+        QVERIFY(reloaded.table(0).usesCrLf());
+
+        QStringList expected = TextTestData::values();
+        expected[0] = edited;
+        for (int i = 0; i < expected.size(); ++i)
+            QCOMPARE(valueOf(reloaded, TextTestData::idAt(i)), expected[i]);
+
+        QVERIFY(!QString::fromUtf8(TextTestData::readFile(path)).contains(QChar::ReplacementCharacter));
+    }
+
+    void patchAppendsNewRows()
+    {
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+
+        // Letzte Zeile ohne Umbruch → wird vor dem Anhängen abgeschlossen
+        QString text = TextTestData::content("\r\n");
+        text.chop(2);
+        const QString path = TextTestData::writeFile(dir, text);
+        QVERIFY(!path.isEmpty());
+
+        TextStore store;
+        QVERIFY(store.load({ TextStore::Source{ "English", path } }));
+
+        const int first = store.addRow("IDS_TEXT_NEW_B");
+        const int second = store.addRow("IDS_TEXT_NEW_A");
+        store.setValue(second, 0, QStringLiteral("zwei\nZeilen"));
+        store.setValue(first, 0, QStringLiteral("eins ภ"));
+
+        const QByteArray data = store.patchedColumn(0);
+        QVERIFY(data.startsWith(TextTestData::readFile(path)));
+        QVERIFY(data.endsWith("\r\nIDS_TEXT_NEW_B\teins \xE0\xB8\xA0\r\nIDS_TEXT_NEW_A\tzwei Zeilen\r\n"));
+
+        QVERIFY(save(store, data, path));
+        QCOMPARE(valueOf(store, "IDS_TEXT_NEW_B"), QStringLiteral("eins ภ"));
+        QCOMPARE(valueOf(store, "IDS_TEXT_NEW_A"), QStringLiteral("zwei Zeilen"));
+        QCOMPARE(valueOf(store, TextTestData::idAt(3)), TextTestData::values()[3]);
+    }
+
+    void compactionKeepsEncodingAndDropsComments()
+    {
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+        const QString path = TextTestData::writeFile(dir, TextTestData::content("\r\n"),
+                                                     TextTable::Encoding::Utf16LE, true);
+        QVERIFY(!path.isEmpty());
+
+        TextStore store;
+        QVERIFY(store.load({ TextStore::Source{ "English", path } }));
+
+        store.setValue(store.row(TextTestData::idAt(1)), 0, QStringLiteral("geändert"));
+        store.setValue(store.addRow("IDS_TEXT_NEW"), 0, QStringLiteral("neu"));
+
+        // Kompaktiert: Zeilenreihenfolge des Stores, BOM + UTF-16LE + CRLF bleiben
+        QStringList expected = TextTestData::values();
+        expected[1] = QStringLiteral("geändert");
+        QString text;
+        for (int i = 0; i < expected.size(); ++i)
+            text += TextTestData::idAt(i) + u'\t' + expected[i] + QStringLiteral("\r\n");
+        text += QStringLiteral("IDS_TEXT_NEW\tneu\r\n");
+
+        const QByteArray data = store.compactedColumn(0);
+        QCOMPARE(data, TextTestData::encoded(text, TextTable::Encoding::Utf16LE, true));
+
+        QVERIFY(save(store, data, path));
+        QCOMPARE(store.table(0).encoding(), TextTable::Encoding::Utf16LE);
+        QVERIFY(store.table(0).hasBom());
+        for (int i = 0; i < expected.size(); ++i)
+            QCOMPARE(valueOf(store, TextTestData::idAt(i)), expected[i]);
+        QCOMPARE(valueOf(store, "IDS_TEXT_NEW"), QStringLiteral("neu"));
+    }
+
+    void compactionWithoutFileWritesUtf8()
+    {
+        TextStore store;
+        const int column = store.addLanguage("Deutsch");
+        store.setValue(store.addRow("IDS_TEXT_0"), column, QStringLiteral("你"));
+
+        QVERIFY(!store.canPatch(column));
+        QCOMPARE(store.compactedColumn(column), QByteArray("IDS_TEXT_0\t\xE4\xBD\xA0\n"));
+    }
+};
+
+QTEST_GUILESS_MAIN(TextStoreTest)
+#include "TextStoreTest.moc"
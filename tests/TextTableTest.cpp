@@ -0,0 +1,98 @@
+#include "text/TextTable.h"
+#include "TextTestData.h"
+
+#include <QtTest>
+
+// ------------------------------------------------------------
+// TextTable – Kodierungen, Leerraum am Wertende, doppelte IDs
+// ------------------------------------------------------------
+class TextTableTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    // Folgebytes 0x85/0xA0 dürfen in UTF-8 nicht als Leerraum gelten
+    void valueEndsInMultibyteCharacter()
+    {
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+        const QString path = TextTestData::writeFile(dir, TextTestData::content("\n"));
+        QVERIFY(!path.isEmpty());
+
+        TextTable table;
+        QVERIFY(table.open(path));
+        QCOMPARE(table.encoding(), TextTable::Encoding::Utf8);
+
+        const QStringList texts = TextTestData::values();
+        for (int i = 0; i < texts.size(); ++i) {
+            const QString value = table.value(TextTestData::idAt(i));
+            QCOMPARE(value, texts[i]);
+            QVERIFY(!value.contains(QChar::ReplacementCharacter));
+        }
+    }
+
+    void opensUtf16WithBom_data()
+    {
+        QTest::addColumn<bool>("bigEndian");
+        QTest::newRow("LE") << false;
+        QTest::newRow("BE") << true;
+    }
+
+    void opensUtf16WithBom()
+    {
+        QFETCH(bool, bigEndian);
+        const TextTable::Encoding encoding = bigEndian ? TextTable::Encoding::Utf16BE
+                                                       : TextTable::Encoding::Utf16LE;
+
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+
+        // In UTF-16 ist U+3000 (ideografisches Leerzeichen) echter Leerraum
+        const QString text = TextTestData::content("\r\n")
+                           + QStringLiteral("IDS_TEXT_WIDE\t你好\u3000\r\n");
+        const QString path = TextTestData::writeFile(dir, text, encoding, true);
+        QVERIFY(!path.isEmpty());
+
+        TextTable table;
+        QVERIFY(table.open(path));
+        QCOMPARE(table.encoding(), encoding);
+        QVERIFY(table.hasBom());
+        QVERIFY(table.usesCrLf());
+        QCOMPARE(table.size(), TextTestData::values().size() + 1);
+
+        const QStringList texts = TextTestData::values();
+        for (int i = 0; i < texts.size(); ++i)
+            QCOMPARE(table.value(TextTestData::idAt(i)), texts[i]);
+        QCOMPARE(table.value(u"IDS_TEXT_WIDE"), QStringLiteral("你好"));
+
+        // Zeilen zählen ab der Datei, Kommentar = Zeile 0
+        QCOMPARE(table.line(table.atom(u"IDS_TEXT_0")), 1);
+
+        // encode() schreibt in der Kodierung der Datei, ohne BOM
+        QCOMPARE(table.encode(u"ภ"), TextTestData::encoded(QStringLiteral("ภ"), encoding, false));
+    }
+
+    void duplicateIdLastWins()
+    {
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+        const QString path = TextTestData::writeFile(dir, QStringLiteral(
+            "IDS_TEXT_A\terster\n"
+            "IDS_TEXT_B\tanderer\n"
+            "IDS_TEXT_A\tzweiter\n"));
+        QVERIFY(!path.isEmpty());
+
+        TextTable table;
+        QVERIFY(table.open(path));
+        QCOMPARE(table.size(), 2);
+
+        const int atom = table.atom(u"IDS_TEXT_A");
+        QVERIFY(atom >= 0);
+        QCOMPARE(table.value(atom), QStringLiteral("zweiter"));
+        QCOMPARE(table.line(atom), 2);
+        QCOMPARE(table.value(u"IDS_TEXT_B"), QStringLiteral("anderer"));
+    }
+};
+
+QTEST_APPLESS_MAIN(TextTableTest)
+#include "TextTableTest.moc"
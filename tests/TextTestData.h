@@ -0,0 +1,72 @@
+#pragma once
+
+#include "text/TextTable.h"
+
+#include <QFile>
+#include <QStringEncoder>
+#include <QStringList>
+#include <QTemporaryDir>
+
+// ------------------------------------------------------------
+// Gemeinsame Testdaten für TextTable-/TextStore-Tests
+// ------------------------------------------------------------
+namespace TextTestData
+{
+
+// à = C3 A0, Å = C3 85, ภ = E0 B8 A0, 你 = E4 BD A0 – in UTF-8
+// enden alle Werte auf Folgebytes, die als Latin-1 Leerraum wären
+inline QStringList values()
+{
+    return { QStringLiteral("voilà"), QStringLiteral("Å"),
+             QStringLiteral("ภ"), QStringLiteral("你") };
+}
+
+inline QString idAt(int i)
+{
+    return QString("IDS_TEXT_%1").arg(i);
+}
+
+// Kommentarzeile, danach "IDS_TEXT_<i>\t<values()[i]>" je Zeile
+inline QString content(const QString& eol)
+{
+    const QStringList texts = values();
+    QString text = QStringLiteral("// Kommentar") + eol;
+    for (int i = 0; i < texts.size(); ++i)
+        text += idAt(i) + u'\t' + texts[i] + eol;
+    return text;
+}
+
+inline QByteArray encoded(const QString& text, TextTable::Encoding encoding, bool bom)
+{
+    QStringConverter::Encoding enc = QStringConverter::Utf8;
+    if (encoding == TextTable::Encoding::Utf16LE)
+        enc = QStringConverter::Utf16LE;
+    else if (encoding == TextTable::Encoding::Utf16BE)
+        enc = QStringConverter::Utf16BE;
+
+    QStringEncoder encoder(enc, bom ? QStringConverter::Flag::WriteBom : QStringConverter::Flag::Default);
+    return encoder(text);
+}
+
+// Schreibt text nach dir/textClient.txt; leer bei Fehler
+inline QString writeFile(const QTemporaryDir& dir, const QString& text,
+                         TextTable::Encoding encoding = TextTable::Encoding::Utf8, bool bom = false)
+{
+    const QString path = dir.filePath("textClient.txt");
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly))
+        return {};
+
+    const QByteArray data = encoded(text, encoding, bom);
+    if (file.write(data) != data.size())
+        return {};
+    return path;
+}
+
+inline QByteArray readFile(const QString& path)
+{
+    QFile file(path);
+    return file.open(QIODevice::ReadOnly) ? file.readAll() : QByteArray();
+}
+
+} // namespace TextTestData
@@ -0,0 +1,651 @@
+#include "utils/PixelFixup.h"
+#include "utils/TgaDecoder.h"
+
+#include <QDirIterator>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QTemporaryDir>
+#include <QtTest>
+
+#include <algorithm>
+
+// ------------------------------------------------------------
+// TgaDecoder/PixelFixup – Korrektheit und Durchsatz (QBENCHMARK)
+// ------------------------------------------------------------
+// Die Benchmarks dekodieren synthetische 512×512-Texturen aus dem
+// Speicher (ohne Datei-I/O); ausführen z. B. mit
+//   TgaDecoderTest -iterations 50 benchmark24 benchmark32 benchmarkRle
+// Für MB/s: Dateigröße (ausgegeben per qInfo) / Zeit je Iteration.
+//
+// benchmarkThemeFolder vergleicht mit dem alten Pixel-für-Pixel-
+// Loader auf echten Theme-Dateien (nur mit Umgebungsvariable):
+//   FLYFF_THEME_DIR=/pfad/zu/Theme TgaDecoderTest benchmarkThemeFolder
+// ------------------------------------------------------------
+class TgaDecoderTest : public QObject
+{
+    Q_OBJECT
+
+private:
+    // Breiten für alle Kernel-Pfade: AVX2-Blöcke (16 Pixel bei 16 bpp,
+    // 8 bei 24 bpp), SSE2/SSSE3-Blöcke und skalarer Rest
+    static QVector<int> widths()
+    {
+        return { 1, 7, 8, 13, 15, 16, 17, 31, 33, 37 };
+    }
+
+    // 16 bpp: A1R5G5B5, Alpha-Bit im Schachbrettmuster
+    static quint16 value16(int x, int y)
+    {
+        const int rgb = (x * 1031 + y * 4099 + x * y * 13) & 0x7FFF;
+        return quint16(rgb | ((x + y) & 1 ? 0x8000 : 0));
+    }
+
+    static int expand5(int v)
+    {
+        return (v << 3) | (v >> 2);
+    }
+
+    // Testmuster: BGRA je Pixel, Alpha nur bei 32 bpp variabel
+    static QByteArray pixel(int x, int y, int bytesPerPixel)
+    {
+        QByteArray p;
+        if (bytesPerPixel == 2) {
+            const quint16 v = value16(x, y);
+            p.append(char(v & 0xFF));
+            p.append(char(v >> 8));
+            return p;
+        }
+        p.append(char(x * 7 + y));
+        p.append(char(x + y * 3));
+        p.append(char(x * y));
+        if (bytesPerPixel == 4)
+            p.append(char((x + y) & 1 ? 0xFF : 0x80));
+        return p;
+    }
+
+    // alpha16: Descriptor kündigt bei 16 bpp ein Alpha-Bit an
+    static QRgb expected(int x, int y, int bytesPerPixel, bool alpha16 = false)
+    {
+        if (bytesPerPixel == 2) {
+            const int v = value16(x, y);
+            const int a = !alpha16 || (v & 0x8000) ? 0xFF : 0x00;
+            return qRgba(expand5((v >> 10) & 0x1F), expand5((v >> 5) & 0x1F), expand5(v & 0x1F), a);
+        }
+        const QByteArray p = pixel(x, y, bytesPerPixel);
+        const int a = bytesPerPixel == 4 ? uchar(p[3]) : 0xFF;
+        return qRgba(uchar(p[2]), uchar(p[1]), uchar(p[0]), a);
+    }
+
+    static QByteArray header(int type, int w, int h, int bpp, int descriptor)
+    {
+        QByteArray d(18, '\0');
+        d[2]  = char(type);
+        d[12] = char(w & 0xFF);
+        d[13] = char(w >> 8);
+        d[14] = char(h & 0xFF);
+        d[15] = char(h >> 8);
+        d[16] = char(bpp);
+        d[17] = char(descriptor);
+        return d;
+    }
+
+    // Pixeldaten in Dateireihenfolge laut Descriptor
+    // (Bit 4 = rechts nach links, Bit 5 = oben nach unten)
+    static QByteArray pixelData(int w, int h, int bytesPerPixel, int descriptor)
+    {
+        QByteArray d;
+        for (int row = 0; row < h; ++row) {
+            const int y = descriptor & 0x20 ? row : h - 1 - row;
+            for (int col = 0; col < w; ++col)
+                d.append(pixel(descriptor & 0x10 ? w - 1 - col : col, y, bytesPerPixel));
+        }
+        return d;
+    }
+
+    // Typ 2, Ursprung unten links (Zeilen von unten nach oben)
+    static QByteArray uncompressed(int w, int h, int bytesPerPixel)
+    {
+        const int descriptor = bytesPerPixel == 4 ? 8 : 0;
+        return header(2, w, h, bytesPerPixel * 8, descriptor) + pixelData(w, h, bytesPerPixel, descriptor);
+    }
+
+    // Typ 10, Ursprung oben links; je Zeile ein Wiederholungs- und
+    // ein Rohpaket, das letzte Rohpaket läuft über das Zeilenende
+    static QByteArray rle(int w, int h)
+    {
+        QByteArray d = header(10, w, h, 32, 8 | 0x20);
+        QByteArray raw;
+        for (int y = 0; y < h; ++y)
+            for (int x = 0; x < w; ++x)
+                raw.append(pixel(x, y, 4));
+
+        const qsizetype total = qsizetype(w) * h;
+        qsizetype pos = 0;
+        bool repeat = true;
+        while (pos < total) {
+            const qsizetype count = qMin<qsizetype>(repeat ? 16 : 100, total - pos);
+            if (repeat) {
+                d.append(char(0x80 | (count - 1)));
+                d.append(raw.mid(pos * 4, 4));
+            } else {
+                d.append(char(count - 1));
+                d.append(raw.mid(pos * 4, count * 4));
+            }
+            pos += count;
+            repeat = !repeat;
+        }
+        return d;
+    }
+
+    // Erwartetes Bild für rle(): Wiederholungspakete kopieren ihr erstes Pixel
+    static QRgb expectedRle(int x, int y, int w)
+    {
+        qsizetype pos = 0;
+        const qsizetype i = qsizetype(y) * w + x;
+        bool repeat = true;
+        for (;;) {
+            const qsizetype count = repeat ? 16 : 100;
+            if (i < pos + count) {
+                const qsizetype src = repeat ? pos : i;
+                return expected(int(src % w), int(src / w), 4);
+            }
+            pos += count;
+            repeat = !repeat;
+        }
+    }
+
+    static void verifyImage(const QImage& img, int w, int h, int bytesPerPixel, bool alpha16 = false)
+    {
+        QCOMPARE(img.size(), QSize(w, h));
+        QCOMPARE(img.format(), QImage::Format_ARGB32);
+        for (int y = 0; y < h; ++y)
+            for (int x = 0; x < w; ++x)
+                QCOMPARE(img.pixel(x, y), expected(x, y, bytesPerPixel, alpha16));
+    }
+
+    // Alter Loader (ResourceUtils::loadFlyffTga vor dem TgaDecoder):
+    // nur Typ 2 mit 24/32 bpp, Ursprung unten links, Pixel für Pixel
+    static QImage legacyDecode(QByteArrayView data)
+    {
+        if (data.size() < 18)
+            return QImage();
+
+        const unsigned char* d = reinterpret_cast<const unsigned char*>(data.data());
+        int width  = d[12] + (d[13] << 8);
+        int height = d[14] + (d[15] << 8);
+        int bpp    = d[16];
+
+        if (width <= 0 || height <= 0 || (bpp != 24 && bpp != 32))
+            return QImage();
+
+        int bytesPerPixel = bpp / 8;
+        int imageSize = width * height * bytesPerPixel;
+        if (data.size() < 18 + imageSize)
+            return QImage();
+
+        QImage img(width, height, QImage::Format_ARGB32);
+        const unsigned char* src = d + 18;
+        for (int y = 0; y < height; ++y) {
+            QRgb* dest = reinterpret_cast<QRgb*>(img.scanLine(height - 1 - y));
+            for (int x = 0; x < width; ++x) {
+                uchar b = *src++;
+                uchar g = *src++;
+                uchar r = *src++;
+                uchar a = (bytesPerPixel == 4) ? *src++ : 255;
+                dest[x] = qRgba(r, g, b, a);
+            }
+        }
+        return img;
+    }
+
+    // Dateien, die der alte Loader korrekt las: ohne ID-Feld und
+    // Farbtabelle, unkomprimiert, Ursprung unten links
+    static bool legacyCompatible(const QByteArray& data)
+    {
+        return data.size() >= 18 && data[0] == 0 && data[1] == 0 && data[2] == 2
+            && (uchar(data[16]) == 24 || uchar(data[16]) == 32) && (data[17] & 0x30) == 0;
+    }
+
+    // Rohwert (premultipliziert) – QImage::pixel() würde zurückrechnen
+    static quint32 raw(const QImage& img, int x, int y)
+    {
+        return reinterpret_cast<const quint32*>(img.constScanLine(y))[x];
+    }
+
+    static QImage argb(int w, int h, const QVector<QRgb>& pixels)
+    {
+        QImage img(w, h, QImage::Format_ARGB32);
+        for (int y = 0; y < h; ++y)
+            std::copy_n(pixels.constData() + y * w, w, reinterpret_cast<QRgb*>(img.scanLine(y)));
+        return img;
+    }
+
+    static bool isMagenta(quint32 px)
+    {
+        return (px & 0x00FFFFFFu) == 0x00FF00FFu;
+    }
+
+    // Zeile mit Alpha a, dazwischen deckende und Magenta-Pixel, damit
+    // SIMD-Blöcke gemischt sind und der Deckend-Schnellpfad greift
+    static QVector<quint32> fixupRow(int w, int a)
+    {
+        QVector<quint32> row(w);
+        for (int x = 0; x < w; ++x) {
+            const int r = (x * 53 + a) & 0xFF;
+            const int g = (x * 91 + 2 * a) & 0xFF;
+            const int b = 0xFF - ((x * 17 + a) & 0xFF);
+            if (x % 5 == 2)
+                row[x] = qRgba(0xFF, 0x00, 0xFF, a);
+            else
+                row[x] = qRgba(r, g, b, x % 3 == 1 ? 0xFF : a);
+        }
+        return row;
+    }
+
+    static void report(const char* name, const QByteArray& data)
+    {
+        qInfo().noquote() << QString("[TgaDecoderTest] %1: %2 KB je Durchlauf").arg(name).arg(data.size() / 1024);
+    }
+
+private slots:
+    // Ungerade Breiten decken SIMD-Hauptteil und skalaren Rest ab
+    void decodes24Bit()
+    {
+        for (int w : widths()) {
+            const QImage img = TgaDecoder::decode(uncompressed(w, 3, 3));
+            verifyImage(img, w, 3, 3);
+        }
+    }
+
+    void decodes32Bit()
+    {
+        for (int w : widths()) {
+            const QImage img = TgaDecoder::decode(uncompressed(w, 3, 4));
+            verifyImage(img, w, 3, 4);
+        }
+    }
+
+    void decodes16Bit_data()
+    {
+        QTest::addColumn<int>("bpp");
+        QTest::addColumn<int>("descriptor");
+        QTest::addColumn<bool>("alpha");
+
+        QTest::newRow("16 bpp, Alpha-Bit") << 16 << 1 << true;
+        QTest::newRow("16 bpp, deckend") << 16 << 0 << false;
+        QTest::newRow("15 bpp") << 15 << 0 << false;
+        QTest::newRow("15 bpp, Alpha-Nibble ignoriert") << 15 << 1 << false;
+    }
+
+    void decodes16Bit()
+    {
+        QFETCH(int, bpp);
+        QFETCH(int, descriptor);
+        QFETCH(bool, alpha);
+
+        for (int w : widths()) {
+            const QImage img = TgaDecoder::decode(header(2, w, 3, bpp, descriptor) + pixelData(w, 3, 2, descriptor));
+            verifyImage(img, w, 3, 2, alpha);
+        }
+    }
+
+    void decodesRightToLeft_data()
+    {
+        QTest::addColumn<int>("bytesPerPixel");
+        QTest::addColumn<int>("descriptor");
+
+        QTest::newRow("16 bpp") << 2 << (0x10 | 1);
+        QTest::newRow("24 bpp") << 3 << 0x10;
+        QTest::newRow("24 bpp, oben nach unten") << 3 << 0x30;
+        QTest::newRow("32 bpp") << 4 << (0x10 | 8);
+    }
+
+    void decodesRightToLeft()
+    {
+        QFETCH(int, bytesPerPixel);
+        QFETCH(int, descriptor);
+        const bool alpha16 = bytesPerPixel == 2 && (descriptor & 0x0F) == 1;
+
+        for (int w : widths()) {
+            const QByteArray data = header(2, w, 4, bytesPerPixel * 8, descriptor)
+                                  + pixelData(w, 4, bytesPerPixel, descriptor);
+            verifyImage(TgaDecoder::decode(data), w, 4, bytesPerPixel, alpha16);
+        }
+    }
+
+    void skipsIdField()
+    {
+        const int w = 17, h = 3;
+        for (int idLength : { 1, 7, 255 }) {
+            QByteArray data = header(2, w, h, 32, 8 | 0x20);
+            data[0] = char(idLength);
+            data += QByteArray(idLength, char(0xEE));
+            data += pixelData(w, h, 4, 8 | 0x20);
+            verifyImage(TgaDecoder::decode(data), w, h, 4);
+        }
+
+        // ID-Feld länger als die Datei
+        QByteArray cut = header(2, 1, 1, 32, 8);
+        cut[0] = char(40);
+        cut += QByteArray(20, '\0');
+        QString error;
+        QVERIFY(TgaDecoder::decode(cut, false, &error).isNull());
+        QVERIFY(!error.isEmpty());
+    }
+
+    // Truecolor-Bilder dürfen eine (ungenutzte) Farbtabelle tragen;
+    // bei Typ 0 gelten Länge/Eintragsgröße nicht
+    void skipsColorMap_data()
+    {
+        QTest::addColumn<int>("mapType");
+        QTest::addColumn<int>("entryBits");
+        QTest::addColumn<int>("skipped");
+
+        QTest::newRow("15 Bit") << 1 << 15 << 2 * 256;
+        QTest::newRow("24 Bit") << 1 << 24 << 3 * 256;
+        QTest::newRow("32 Bit") << 1 << 32 << 4 * 256;
+        QTest::newRow("Typ 0") << 0 << 24 << 0;
+    }
+
+    void skipsColorMap()
+    {
+        QFETCH(int, mapType);
+        QFETCH(int, entryBits);
+        QFETCH(int, skipped);
+
+        const int h = 3;
+        for (int w : { 17, 33 }) {
+            QByteArray data = header(2, w, h, 24, 0x20);
+            data[0] = char(3);
+            data[1] = char(mapType);
+            data[5] = char(256 & 0xFF);
+            data[6] = char(256 >> 8);
+            data[7] = char(entryBits);
+            data += QByteArray(3, char(0xEE));
+            data += QByteArray(skipped, char(0xCD));
+            data += pixelData(w, h, 3, 0x20);
+            verifyImage(TgaDecoder::decode(data), w, h, 3);
+        }
+    }
+
+    void decodesRleAcrossRows()
+    {
+        const int w = 23, h = 9;
+        const QImage img = TgaDecoder::decode(rle(w, h));
+        QCOMPARE(img.size(), QSize(w, h));
+        for (int y = 0; y < h; ++y)
+            for (int x = 0; x < w; ++x)
+                QCOMPARE(img.pixel(x, y), expectedRle(x, y, w));
+    }
+
+    void rejectsTruncatedData()
+    {
+        QString error;
+        const QByteArray data = uncompressed(8, 8, 4);
+        QVERIFY(TgaDecoder::decode(QByteArrayView(data).first(data.size() - 1), false, &error).isNull());
+        QVERIFY(!error.isEmpty());
+
+        const QByteArray packed = rle(8, 8);
+        QVERIFY(TgaDecoder::decode(QByteArrayView(packed).first(packed.size() - 1)).isNull());
+    }
+
+    void loadCountsStats()
+    {
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+
+        const QByteArray data = uncompressed(16, 4, 4);
+        const QString path = dir.filePath("test.tga");
+        QFile file(path);
+        QVERIFY(file.open(QIODevice::WriteOnly));
+        file.write(data);
+        file.close();
+
+        TgaDecoder::resetStats();
+        QVERIFY(!TgaDecoder::load(path).isNull());
+        QVERIFY(TgaDecoder::load(dir.filePath("fehlt.tga")).isNull());
+
+        const TgaDecoder::Stats stats = TgaDecoder::stats();
+        QCOMPARE(stats.files, quint64(1));
+        QCOMPARE(stats.bytes, quint64(data.size()));
+        QCOMPARE(stats.pixels, quint64(16 * 4));
+    }
+
+    // ---- PixelFixup ----
+    // Breiten 1..3 laufen komplett skalar; ab 4 SSE2-, ab 8 AVX2-
+    // Blöcke, jeweils mit skalarem Rest. qPremultiply ist der
+    // skalare Pfad, also die Referenz für alle Kernels.
+    void premultiplyRowMatchesScalar()
+    {
+        for (int w : { 1, 2, 3, 4, 5, 7, 8, 9, 12, 15, 16, 17, 33 }) {
+            for (int a = 0; a <= 255; ++a) {
+                QVector<quint32> row = fixupRow(w, a);
+                const QVector<quint32> source = row;
+                PixelFixup::premultiplyRow(row.data(), w);
+
+                for (int x = 0; x < w; ++x) {
+                    if (row[x] != qPremultiply(source[x]))
+                        QFAIL(qPrintable(QString("Breite %1, Alpha %2, x %3: %4 statt %5")
+                                             .arg(w).arg(a).arg(x)
+                                             .arg(row[x], 8, 16, QChar('0'))
+                                             .arg(qPremultiply(source[x]), 8, 16, QChar('0'))));
+                }
+            }
+        }
+    }
+
+    void keyAndPremultiplyRowMatchesScalar()
+    {
+        for (int w : { 1, 2, 3, 4, 5, 7, 8, 9, 12, 15, 16, 17, 33 }) {
+            for (int a = 0; a <= 255; ++a) {
+                QVector<quint32> row = fixupRow(w, a);
+                const QVector<quint32> source = row;
+                PixelFixup::keyAndPremultiplyRow(row.data(), w);
+
+                for (int x = 0; x < w; ++x) {
+                    const quint32 want = isMagenta(source[x]) ? 0u : qPremultiply(source[x]);
+                    if (row[x] != want)
+                        QFAIL(qPrintable(QString("Breite %1, Alpha %2, x %3: %4 statt %5")
+                                             .arg(w).arg(a).arg(x)
+                                             .arg(row[x], 8, 16, QChar('0'))
+                                             .arg(want, 8, 16, QChar('0'))));
+                }
+            }
+        }
+    }
+
+    void keyedMagentaBecomesZero()
+    {
+        // Jede Lage im Block: ganze Zeile Magenta, Alpha egal
+        for (int w : { 1, 4, 8, 17 }) {
+            for (quint32 px : { 0xFFFF00FFu, 0x80FF00FFu, 0x00FF00FFu }) {
+                QVector<quint32> row(w, px);
+                PixelFixup::keyAndPremultiplyRow(row.data(), w);
+                QCOMPARE(row, QVector<quint32>(w, 0u));
+            }
+        }
+
+        // Fast-Magenta bleibt stehen
+        QVector<quint32> near{ 0xFFFE00FFu, 0xFFFF01FFu, 0xFFFF00FEu, 0xFFFF00FFu,
+                               0xFFFF00FFu, 0xFFFE00FFu, 0xFFFF01FFu, 0xFFFF00FEu, 0xFFFF00FFu };
+        const QVector<quint32> source = near;
+        PixelFixup::keyAndPremultiplyRow(near.data(), int(near.size()));
+        for (int x = 0; x < near.size(); ++x)
+            QCOMPARE(near[x], isMagenta(source[x]) ? 0u : source[x]);
+    }
+
+    // 1×N: nur oben/unten klemmen (kein linker/rechter Nachbar)
+    void prepareClampsSingleColumn()
+    {
+        const QRgb red  = qRgb(0xC0, 0x10, 0x20);
+        const QRgb half = qRgba(0x40, 0x80, 0xC0, 0x80);
+        const QRgb blue = qRgb(0x10, 0x20, 0xC0);
+
+        QImage img = argb(1, 5, { 0xFFFF00FFu, red, half, blue, qRgba(0x11, 0x22, 0x33, 0x00) });
+        PixelFixup::prepareThemeImage(img);
+
+        QCOMPARE(img.format(), QImage::Format_ARGB32_Premultiplied);
+        QCOMPARE(raw(img, 0, 0), quint32(red));     // Magenta ausgestanzt → Nachbar
+        QCOMPARE(raw(img, 0, 1), quint32(red));
+        QCOMPARE(raw(img, 0, 2), qPremultiply(half)); // innen: nur premultipliziert
+        QCOMPARE(raw(img, 0, 3), quint32(blue));
+        QCOMPARE(raw(img, 0, 4), quint32(blue));
+    }
+
+    // N×1: nur links/rechts klemmen
+    void prepareClampsSingleRow()
+    {
+        const QRgb red  = qRgb(0xC0, 0x10, 0x20);
+        const QRgb half = qRgba(0x40, 0x80, 0xC0, 0x80);
+        const QRgb blue = qRgb(0x10, 0x20, 0xC0);
+
+        QImage img = argb(5, 1, { 0x80FF00FFu, red, half, qRgba(0x10, 0x20, 0xC0, 0x40), blue });
+        PixelFixup::prepareThemeImage(img);
+
+        QCOMPARE(img.format(), QImage::Format_ARGB32_Premultiplied);
+        QCOMPARE(raw(img, 0, 0), quint32(red));
+        QCOMPARE(raw(img, 1, 0), quint32(red));
+        QCOMPARE(raw(img, 2, 0), qPremultiply(half));
+        QCOMPARE(raw(img, 3, 0), qPremultiply(qRgba(0x10, 0x20, 0xC0, 0x40)));
+        QCOMPARE(raw(img, 4, 0), quint32(blue));
+
+        // Rechter Rand durchsichtig → vom premultiplizierten Nachbarn
+        QImage right = argb(3, 1, { red, half, 0xFFFF00FFu });
+        PixelFixup::prepareThemeImage(right);
+        QCOMPARE(raw(right, 2, 0), qPremultiply(half));
+    }
+
+    // 2×2: Zeilenenden zuerst, dann obere aus Zeile 1 bzw. untere aus Zeile 0
+    void prepareClampsTwoByTwo()
+    {
+        const QRgb red  = qRgb(0xC0, 0x10, 0x20);
+        const QRgb blue = qRgb(0x10, 0x20, 0xC0);
+
+        // Obere Zeile komplett ausgestanzt → kommt aus Zeile 1
+        QImage top = argb(2, 2, { 0xFFFF00FFu, 0xFFFF00FFu, red, blue });
+        PixelFixup::prepareThemeImage(top);
+        QCOMPARE(raw(top, 0, 0), quint32(red));
+        QCOMPARE(raw(top, 1, 0), quint32(blue));
+        QCOMPARE(raw(top, 0, 1), quint32(red));
+        QCOMPARE(raw(top, 1, 1), quint32(blue));
+
+        // Untere Zeile durchsichtig → kommt aus Zeile 0
+        QImage bottom = argb(2, 2, { red, blue, qRgba(1, 2, 3, 0), 0x00FF00FFu });
+        PixelFixup::prepareThemeImage(bottom);
+        QCOMPARE(raw(bottom, 0, 1), quint32(red));
+        QCOMPARE(raw(bottom, 1, 1), quint32(blue));
+
+        // Halbtransparente Ecke: erst vom Zeilennachbarn, der deckt
+        QImage corner = argb(2, 2, { red, blue, qRgba(0x40, 0x80, 0xC0, 0x80), red });
+        PixelFixup::prepareThemeImage(corner);
+        QCOMPARE(raw(corner, 0, 1), quint32(red));
+        QCOMPARE(raw(corner, 0, 0), quint32(red));
+        QCOMPARE(raw(corner, 1, 0), quint32(blue));
+    }
+
+    // ---- Durchsatz ----
+    void benchmark24()
+    {
+        const QByteArray data = uncompressed(512, 512, 3);
+        report("24 bpp", data);
+        QBENCHMARK {
+            const QImage img = TgaDecoder::decode(data);
+            QVERIFY(!img.isNull());
+        }
+    }
+
+    void benchmark32()
+    {
+        const QByteArray data = uncompressed(512, 512, 4);
+        report("32 bpp", data);
+        QBENCHMARK {
+            const QImage img = TgaDecoder::decode(data);
+            QVERIFY(!img.isNull());
+        }
+    }
+
+    void benchmark32Premultiplied()
+    {
+        const QByteArray data = uncompressed(512, 512, 4);
+        report("32 bpp premultipliziert", data);
+        QBENCHMARK {
+            const QImage img = TgaDecoder::decode(data, true);
+            QVERIFY(!img.isNull());
+        }
+    }
+
+    void benchmarkRle()
+    {
+        const QByteArray data = rle(512, 512);
+        report("32 bpp RLE", data);
+        QBENCHMARK {
+            const QImage img = TgaDecoder::decode(data);
+            QVERIFY(!img.isNull());
+        }
+    }
+
+    // Echte Theme-Dateien: alter Loader gegen TgaDecoder auf denselben
+    // Dateien (nur solche, die der alte Loader lesen konnte)
+    void benchmarkThemeFolder_data()
+    {
+        QTest::addColumn<bool>("legacy");
+        QTest::newRow("alt, Pixel für Pixel") << true;
+        QTest::newRow("TgaDecoder") << false;
+    }
+
+    void benchmarkThemeFolder()
+    {
+        QFETCH(bool, legacy);
+
+        const QString folder = qEnvironmentVariable("FLYFF_THEME_DIR");
+        if (folder.isEmpty())
+            QSKIP("FLYFF_THEME_DIR nicht gesetzt");
+
+        QVector<QByteArray> files;
+        qint64 bytes = 0;
+        int skipped = 0;
+        QDirIterator it(folder, { "*.tga" }, QDir::Files, QDirIterator::Subdirectories);
+        while (it.hasNext()) {
+            QFile file(it.next());
+            if (!file.open(QIODevice::ReadOnly))
+                continue;
+            QByteArray data = file.readAll();
+            if (!legacyCompatible(data)) {
+                ++skipped;
+                continue;
+            }
+            bytes += data.size();
+            files << std::move(data);
+        }
+        if (files.isEmpty())
+            QSKIP("Keine vom alten Loader lesbaren TGA-Dateien gefunden");
+
+        // Beide Wege müssen dasselbe Bild liefern
+        for (const QByteArray& data : files)
+            QCOMPARE(TgaDecoder::decode(data), legacyDecode(data));
+
+        auto decodeAll = [&] {
+            for (const QByteArray& data : files) {
+                const QImage img = legacy ? legacyDecode(data) : TgaDecoder::decode(data);
+                QVERIFY(!img.isNull());
+            }
+        };
+
+        QElapsedTimer timer;
+        timer.start();
+        decodeAll();
+        const double seconds = qMax<double>(timer.nsecsElapsed(), 1) / 1e9;
+        qInfo().noquote() << QString("[TgaDecoderTest] %1 Dateien, %2 MB (%3 übersprungen): %4 MB/s")
+                                 .arg(files.size())
+                                 .arg(bytes / (1024.0 * 1024.0), 0, 'f', 1)
+                                 .arg(skipped)
+                                 .arg(bytes / (1024.0 * 1024.0) / seconds, 0, 'f', 0);
+
+        QBENCHMARK {
+            decodeAll();
+        }
+    }
+};
+
+QTEST_APPLESS_MAIN(TgaDecoderTest)
+#include "TgaDecoderTest.moc"